@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Word sum of the Internet checksum
+ *
+ * The carry flag chains the additions of the words, each load costing a
+ * single add with carry where the portable code needs 64-bit adds. The
+ * SIMD instructions of the DSP extension only add bytes and halfwords, which
+ * would take more instructions for the same sum.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/cpu.h>
+
+/* Words added per loop iteration */
+#define CHKSUM_UNROLL 4U
+
+uint32_t arch_net_chksum32(const uint32_t *data, size_t words)
+{
+	uint32_t sum = 0U;
+	size_t blocks = words / CHKSUM_UNROLL;
+	uint32_t a, b, c, d;
+	uint64_t total;
+
+	if (blocks > 0) {
+		__asm__ volatile(
+			"1:\n\t"
+			"ldr %[a], [%[p]], #4\n\t"
+			"ldr %[b], [%[p]], #4\n\t"
+			"ldr %[c], [%[p]], #4\n\t"
+			"ldr %[d], [%[p]], #4\n\t"
+			"adds %[sum], %[sum], %[a]\n\t"
+			"adcs %[sum], %[sum], %[b]\n\t"
+			"adcs %[sum], %[sum], %[c]\n\t"
+			"adcs %[sum], %[sum], %[d]\n\t"
+			"adc %[sum], %[sum], #0\n\t"
+			"subs %[n], %[n], #1\n\t"
+			"bne 1b\n\t"
+			: [sum] "+r" (sum), [p] "+r" (data), [n] "+r" (blocks),
+			  [a] "=&r" (a), [b] "=&r" (b), [c] "=&r" (c), [d] "=&r" (d)
+			:
+			: "cc", "memory");
+	}
+
+	total = sum;
+	for (size_t i = 0; i < words % CHKSUM_UNROLL; i++) {
+		total += data[i];
+	}
+
+	total = (total & UINT32_MAX) + (total >> 32);
+	total = (total & UINT32_MAX) + (total >> 32);
+
+	return (uint32_t)total;
+}
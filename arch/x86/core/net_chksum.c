@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Word sum of the Internet checksum
+ *
+ * The carry flag chains the additions of native words, each load costing a
+ * single add with carry where the portable code widens every 32-bit word.
+ * SSE/AVX are not used as the kernel does not save their registers for the
+ * threads running the network stack.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/cpu.h>
+
+#ifdef CONFIG_X86_64
+typedef uint64_t chksum_word_t;
+#else
+typedef uint32_t chksum_word_t;
+#endif
+
+/* Native words added per loop iteration */
+#define CHKSUM_UNROLL 4U
+#define CHKSUM_BLOCK_WORDS (CHKSUM_UNROLL * sizeof(chksum_word_t) / sizeof(uint32_t))
+
+uint32_t arch_net_chksum32(const uint32_t *data, size_t words)
+{
+	chksum_word_t sum = 0U;
+	size_t blocks = words / CHKSUM_BLOCK_WORDS;
+	uint64_t total = 0U;
+
+	if (blocks > 0) {
+		__asm__ volatile(
+#ifdef CONFIG_X86_64
+			"clc\n\t"
+			"1:\n\t"
+			"adcq 0(%[p]), %[sum]\n\t"
+			"adcq 8(%[p]), %[sum]\n\t"
+			"adcq 16(%[p]), %[sum]\n\t"
+			"adcq 24(%[p]), %[sum]\n\t"
+			"leaq 32(%[p]), %[p]\n\t"
+			"decq %[n]\n\t"
+			"jnz 1b\n\t"
+			"adcq $0, %[sum]\n\t"
+#else
+			"clc\n\t"
+			"1:\n\t"
+			"adcl 0(%[p]), %[sum]\n\t"
+			"adcl 4(%[p]), %[sum]\n\t"
+			"adcl 8(%[p]), %[sum]\n\t"
+			"adcl 12(%[p]), %[sum]\n\t"
+			"leal 16(%[p]), %[p]\n\t"
+			"decl %[n]\n\t"
+			"jnz 1b\n\t"
+			"adcl $0, %[sum]\n\t"
+#endif
+			: [sum] "+r" (sum), [p] "+r" (data), [n] "+r" (blocks)
+			:
+			: "cc", "memory");
+	}
+
+	/* Less than a block left, 64 bits hold it along with the folded sum */
+	for (size_t i = 0; i < words % CHKSUM_BLOCK_WORDS; i++) {
+		total += data[i];
+	}
+
+	total += (uint32_t)sum;
+#ifdef CONFIG_X86_64
+	total += (uint32_t)(sum >> 32);
+#endif
+
+	total = (total & UINT32_MAX) + (total >> 32);
+	total = (total & UINT32_MAX) + (total >> 32);
+
+	return (uint32_t)total;
+}
@@ -1301,6 +1301,22 @@ void arch_stack_walk(stack_trace_callback_fn callback_fn, void *cookie,
  * @}
  */
 
+#ifdef CONFIG_ARCH_HAS_NET_CHKSUM
+/**
+ * @brief Architecture-specific sum of words for the Internet checksum
+ *
+ * Sums @a words 32-bit words starting at the 4-byte aligned @a data in
+ * ones' complement arithmetic. The words are summed as loaded, in the byte
+ * order of the CPU, the caller converting the result to network byte order.
+ *
+ * @param data Pointer to the first word
+ * @param words Number of words to sum, may be 0
+ *
+ * @return Ones' complement sum of the words, folded to 32 bits
+ */
+uint32_t arch_net_chksum32(const uint32_t *data, size_t words);
+#endif /* CONFIG_ARCH_HAS_NET_CHKSUM */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -41,5 +41,30 @@ struct ext2_cfg {
 		.set_uuid = false,				\
 	}
 
+/** @brief Statistics of the ext2 block cache.
+ *
+ * The counters are reset when a file system is mounted or created.
+ *
+ * @param hits Blocks found in the cache.
+ * @param misses Blocks read from the storage on request.
+ * @param readahead Blocks read from the storage ahead of sequential file reads.
+ * @param writebacks Dirty blocks written to the storage.
+ * @param evictions Blocks dropped from the cache to make room for other blocks.
+ */
+struct ext2_block_cache_stats {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t readahead;
+	uint32_t writebacks;
+	uint32_t evictions;
+};
+
+/** @brief Get statistics of the ext2 block cache.
+ *
+ * Available with @kconfig{CONFIG_EXT2_BLOCK_CACHE}.
+ *
+ * @param stats Filled with the current counters.
+ */
+void ext2_block_cache_stats_get(struct ext2_block_cache_stats *stats);
 
 #endif /* ZEPHYR_INCLUDE_FS_EXT2_H_ */
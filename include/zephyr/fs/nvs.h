@@ -33,6 +33,16 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection statistics
+ */
+struct nvs_gc_stats {
+	/** Number of bytes, data and ATEs, copied by the garbage collection */
+	uint32_t bytes_moved;
+	/** Longest time taken by a write or a delete, in microseconds */
+	uint32_t max_stall_us;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  */
@@ -62,6 +72,18 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	/** Work item running the garbage collection in the background */
+	struct k_work gc_work;
+	/** Progress of the background garbage collection in the oldest sector */
+	uint32_t gc_bg_addr;
+	/** Bytes of the oldest sector erased by the background garbage collection */
+	uint32_t gc_bg_erased;
+#endif
+#ifdef CONFIG_NVS_GC_STATS
+	/** Garbage collection statistics */
+	struct nvs_gc_stats gc_stats;
+#endif
 };
 
 /**
@@ -188,6 +210,20 @@ size_t nvs_sector_max_data_size(struct nvs_fs *fs);
  */
 int nvs_sector_use_next(struct nvs_fs *fs);
 
+/**
+ * @brief Get the garbage collection statistics of the file system.
+ *
+ * The statistics are reset by nvs_mount().
+ *
+ * @param fs Pointer to the file system.
+ * @param stats Filled with the current statistics.
+ *
+ * @retval 0 Success
+ * @retval -EACCES If the file system is not mounted.
+ * @retval -ENOTSUP If @kconfig{CONFIG_NVS_GC_STATS} is disabled.
+ */
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats);
+
 /**
  * @}
  */
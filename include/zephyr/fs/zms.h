@@ -30,6 +30,14 @@ extern "C" {
  * @{
  */
 
+/** Garbage collection statistics of a ZMS file system */
+struct zms_gc_stats {
+	/** Number of bytes, data and ATEs, copied by the garbage collection */
+	uint32_t bytes_moved;
+	/** Longest time taken by a write or a delete, in microseconds */
+	uint32_t max_stall_us;
+};
+
 /** Zephyr Memory Storage file system structure */
 struct zms_fs {
 	/** File system offset in flash */
@@ -64,6 +72,18 @@ struct zms_fs {
 	/** Lookup table used to cache ATE addresses of written IDs */
 	uint64_t lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
 #endif
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	/** Work item running the garbage collection in the background */
+	struct k_work gc_work;
+	/** Progress of the background garbage collection in the oldest sector */
+	uint64_t gc_bg_addr;
+	/** Bytes of the oldest sector erased by the background garbage collection */
+	uint32_t gc_bg_erased;
+#endif
+#ifdef CONFIG_ZMS_GC_STATS
+	/** Garbage collection statistics */
+	struct zms_gc_stats gc_stats;
+#endif
 };
 
 /**
@@ -200,6 +220,20 @@ size_t zms_active_sector_free_space(struct zms_fs *fs);
  */
 int zms_sector_use_next(struct zms_fs *fs);
 
+/**
+ * @brief Get the garbage collection statistics of the file system.
+ *
+ * The statistics are reset by zms_mount().
+ *
+ * @param fs Pointer to the file system.
+ * @param stats Filled with the current statistics.
+ *
+ * @retval 0 Success
+ * @retval -EACCES If the file system is not mounted.
+ * @retval -ENOTSUP If @kconfig{CONFIG_ZMS_GC_STATS} is disabled.
+ */
+int zms_gc_stats_get(struct zms_fs *fs, struct zms_gc_stats *stats);
+
 /**
  * @}
  */
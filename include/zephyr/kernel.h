@@ -4525,6 +4525,15 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	/** Ticket of the next message to put (lock-free queues) */
+	atomic_t head;
+	/** Ticket of the next message to get (lock-free queues) */
+	atomic_t tail;
+	/** Number of threads blocked, or about to block (lock-free queues) */
+	atomic_t waiters;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
@@ -4549,12 +4558,49 @@ struct k_msgq {
 	Z_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
+#define Z_MSGQ_LOCKLESS_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.msg_size = q_msg_size, \
+	.max_msgs = q_max_msgs, \
+	.buffer_start = q_buffer, \
+	.buffer_end = q_buffer + \
+		K_MSGQ_LOCKLESS_BUF_SIZE(q_msg_size, q_max_msgs), \
+	.read_ptr = q_buffer, \
+	.write_ptr = q_buffer, \
+	.used_msgs = 0, \
+	Z_POLL_EVENT_OBJ_INIT(obj) \
+	.flags = K_MSGQ_FLAG_LOCKLESS, \
+	}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_LOCKLESS	BIT(1)
+
+/**
+ * @brief Size of a lock-free message queue slot.
+ *
+ * Each slot of a lock-free message queue's ring buffer holds a sequence
+ * number followed by the message itself, padded to the sequence number's
+ * alignment.
+ *
+ * @param msg_size Message size (in bytes).
+ */
+#define K_MSGQ_LOCKLESS_SLOT_SIZE(msg_size) \
+	(sizeof(atomic_t) + ROUND_UP(msg_size, sizeof(atomic_t)))
+
+/**
+ * @brief Size of a lock-free message queue's ring buffer.
+ *
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued.
+ */
+#define K_MSGQ_LOCKLESS_BUF_SIZE(msg_size, max_msgs) \
+	((max_msgs) * K_MSGQ_LOCKLESS_SLOT_SIZE(msg_size))
 
 /**
  * @brief Message Queue Attributes
@@ -4611,6 +4657,66 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+/**
+ * @brief Statically define and initialize a lock-free message queue.
+ *
+ * This is equivalent to K_MSGQ_DEFINE(), except that the message queue is
+ * lock-free, as if initialized with k_msgq_init_lockless(). The ring
+ * buffer is aligned as required, and is not placed in a __noinit section
+ * since it must start out zeroed.
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued (power
+ *                   of 2).
+ */
+#define K_MSGQ_DEFINE_LOCKLESS(q_name, q_msg_size, q_max_msgs)		\
+	static char __aligned(sizeof(atomic_t))			\
+		_k_fifo_buf_##q_name[K_MSGQ_LOCKLESS_BUF_SIZE(q_msg_size, \
+							     q_max_msgs)]; \
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_LOCKLESS_INITIALIZER(q_name, _k_fifo_buf_##q_name, \
+					   (q_msg_size), (q_max_msgs)); \
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs),			\
+		     "lock-free message queue size must be a power of 2")
+
+/**
+ * @brief Initialize a lock-free message queue.
+ *
+ * This routine initializes a message queue object, prior to its first use,
+ * like k_msgq_init() does. When the queue is neither full nor empty,
+ * k_msgq_put() and k_msgq_get() then complete with atomic operations only,
+ * without taking the message queue's lock. This makes the queue well suited
+ * to high rate producers, such as ISRs, and to multiple producers and
+ * consumers running on different CPUs. The lock and wait queue are only
+ * used when a thread has to block for the queue to become non-full or
+ * non-empty.
+ *
+ * The message queue's ring buffer must be at least
+ * K_MSGQ_LOCKLESS_BUF_SIZE(@a msg_size, @a max_msgs) bytes long and be
+ * aligned to sizeof(atomic_t).
+ *
+ * Lock-free message queues cannot be used with k_poll(). Messages are still
+ * received in "first in, first out" order, but that order is the order in
+ * which concurrent senders reserved their slots, and a message being put by
+ * a preempted sender holds back the messages following it until it is
+ * completed.
+ *
+ * @note Requires CONFIG_MSGQ_LOCKLESS.
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued (power
+ *                 of 2).
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL @a max_msgs is not a power of 2 or @a buffer is
+ *	misaligned.
+ */
+int k_msgq_init_lockless(struct k_msgq *msgq, char *buffer, size_t msg_size,
+			 uint32_t max_msgs);
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4758,9 +4864,36 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+static inline uint32_t z_msgq_used_msgs(struct k_msgq *msgq)
+{
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if ((msgq->flags & K_MSGQ_FLAG_LOCKLESS) != 0U) {
+		/* Reading the tail first guarantees it never exceeds the head,
+		 * but concurrent gets and puts may still push the difference
+		 * beyond the queue size.
+		 */
+		atomic_val_t tail = atomic_get(&msgq->tail);
+		atomic_val_t head = atomic_get(&msgq->head);
+
+		return MIN((uint32_t)((unsigned long)head - (unsigned long)tail),
+			   msgq->max_msgs);
+	}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
+	return msgq->used_msgs;
+}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_msgq_used_msgs(msgq);
 }
 
 /**
@@ -4776,7 +4909,7 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
-	return msgq->used_msgs;
+	return z_msgq_used_msgs(msgq);
 }
 
 /** @} */
@@ -4972,6 +5105,8 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIM	BIT(1)	/** Buffer space claimed for writing */
+#define K_PIPE_FLAG_GET_CLAIM	BIT(2)	/** Buffer data claimed for reading */
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -5100,6 +5235,148 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/** Pipe I/O vector element to write from */
+struct k_pipe_put_iovec {
+	const void *data;	/**< Address of the data */
+	size_t      len;	/**< Size of the data (in bytes) */
+};
+
+/** Pipe I/O vector element to read to */
+struct k_pipe_iovec {
+	void   *data;	/**< Address of the data */
+	size_t  len;	/**< Size of the data (in bytes) */
+};
+
+/**
+ * @brief Write scattered data to a pipe.
+ *
+ * This routine writes up to the total size of the @a iovcnt elements of
+ * @a iov to @a pipe, in order, as if they were a single contiguous buffer
+ * passed to k_pipe_put() with a timeout of K_NO_WAIT.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param iov I/O vector of the data to write.
+ * @param iovcnt Number of elements in @a iov.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Less than @a min_xfer bytes could be written; zero data bytes
+ *              were written.
+ */
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_put_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer);
+
+/**
+ * @brief Read data from a pipe into scattered buffers.
+ *
+ * This routine reads up to the total size of the @a iovcnt elements of
+ * @a iov from @a pipe, in order, as if they were a single contiguous buffer
+ * passed to k_pipe_get() with a timeout of K_NO_WAIT.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param iov I/O vector of the buffers to read to.
+ * @param iovcnt Number of elements in @a iov.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of bytes to read.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Less than @a min_xfer bytes could be read; zero data bytes
+ *              were read.
+ */
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer);
+
+/**
+ * @brief Claim space in a pipe's buffer for writing data in place.
+ *
+ * This routine provides direct access to free space in the pipe's ring
+ * buffer, avoiding a copy of the data into it. Once the data is written,
+ * the number of bytes written must be confirmed with k_pipe_put_finish().
+ *
+ * Only one put claim may be outstanding at any time. While it is, the pipe
+ * buffer is not written to by any other means: k_pipe_put() only writes to
+ * waiting readers, blocking if needed. The claimed data is ordered after
+ * any data written in the meantime.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param[in]  pipe Address of the pipe.
+ * @param[out] data Set to the address of the claimed space.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Size of the claimed space, which can be smaller than requested if
+ *	   there is not enough free space or the buffer wraps, or zero if
+ *	   none is free or a put claim is already outstanding.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Commit the data written to claimed pipe buffer space.
+ *
+ * This routine ends the put claim, making the first @a size bytes of the
+ * claimed space available to readers. Waiting readers are served from the
+ * pipe buffer as far as possible.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, up to the claimed size (or even 0).
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL No put claim is outstanding, or @a size exceeds it.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading it in place.
+ *
+ * This routine provides direct access to data in the pipe's ring buffer,
+ * avoiding a copy of the data out of it. Once the data is processed, the
+ * number of bytes consumed must be confirmed with k_pipe_get_finish().
+ *
+ * Only one get claim may be outstanding at any time. While it is, the pipe
+ * buffer is not read from by any other means. Data is not transferred
+ * directly from writers to readers either, as it would overtake the buffered
+ * data: k_pipe_put() writes to the pipe buffer and k_pipe_get() blocks until
+ * the claim is released.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param[in]  pipe Address of the pipe.
+ * @param[out] data Set to the address of the claimed data.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Size of the claimed data, which can be smaller than requested if
+ *	   there is not enough data or the buffer wraps, or zero if there is
+ *	   none or a get claim is already outstanding.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Release claimed pipe buffer data.
+ *
+ * This routine ends the get claim, freeing the first @a size bytes of the
+ * claimed data. Waiting writers refill the pipe buffer as far as possible.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, up to the claimed size (or even 0).
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL No get claim is outstanding, or @a size exceeds it.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -5160,6 +5437,14 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5167,6 +5452,11 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	atomic_t cache_waiters;
+	struct z_mem_slab_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5308,6 +5598,34 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Free blocks held in per-CPU caches are counted as used in the slab's
+ * info, since they are not on its free list.  The cache counts are read
+ * without their locks, so the sum is only a snapshot.
+ */
+static inline uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	uint32_t num_cached = 0;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		num_cached += *(volatile uint32_t *)&slab->cache[i].count;
+	}
+
+	return num_cached;
+#else
+	ARG_UNUSED(slab);
+	return 0;
+#endif
+}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5320,7 +5638,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_used;
+	uint32_t num_used = slab->info.num_used;
+	uint32_t num_cached = z_mem_slab_num_cached(slab);
+
+	/* Blocks may move between the slab and the caches while counting */
+	return (num_used > num_cached) ? (num_used - num_cached) : 0U;
 }
 
 /**
@@ -5355,7 +5677,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5504,7 +5826,15 @@ void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
-#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Slab enable flag and per-class list heads kept in the heap header */
+#define Z_HEAP_SLAB_SIZE \
+	ROUND_UP(4 + CONFIG_SYS_HEAP_SLAB_CLASSES * \
+		 (IS_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS) ? 16 : 8), 8)
+#else
+#define Z_HEAP_SLAB_SIZE 0
+#endif
+#define Z_HEAP_MIN_SIZE (((sizeof(void *) > 4) ? 56 : 44) + Z_HEAP_SLAB_SIZE)
 
 /**
  * @brief Define a static k_heap in the specified linker section
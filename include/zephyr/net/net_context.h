@@ -194,6 +194,32 @@ typedef struct k_mem_slab *(*net_pkt_get_slab_func_t)(void);
  */
 typedef struct net_buf_pool *(*net_pkt_get_pool_func_t)(void);
 
+struct net_context_watcher;
+
+/**
+ * @typedef net_context_watch_cb_t
+ * @brief Watcher callback, called when a watched context may have become
+ * ready or when it is released.
+ *
+ * @details The callback is called with a spinlock held, possibly from the
+ * network stack threads. It must not block and must not watch or unwatch
+ * any context.
+ *
+ * @param watcher The watcher registered with net_context_watch().
+ * @param released True if the context was released with net_context_put(),
+ * the watcher is then no longer registered.
+ */
+typedef void (*net_context_watch_cb_t)(struct net_context_watcher *watcher,
+				       bool released);
+
+/** @brief Watcher of the readiness changes of a network context. */
+struct net_context_watcher {
+	/** Node in the watchers list of the context */
+	sys_snode_t node;
+	/** Called on readiness changes */
+	net_context_watch_cb_t cb;
+};
+
 struct net_tcp;
 
 struct net_conn_handle;
@@ -365,9 +391,45 @@ __net_socket struct net_context {
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
 		/** Enable RX, TX or both timestamps of packets send through sockets. */
 		uint8_t timestamping;
+#endif
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+		/** Transmit without copy the data sent with MSG_ZEROCOPY. */
+		bool zerocopy;
 #endif
 	} options;
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	/** Completions of the zero-copy sends, read from the error queue */
+	struct {
+		/** Raised when a completion can be read */
+		struct k_poll_signal signal;
+		/** Ranges of completed sends, oldest first from head */
+		struct {
+			/** First send of the range */
+			uint32_t lo;
+			/** Last send of the range */
+			uint32_t hi;
+			/** The data of these sends was copied */
+			bool copied;
+		} done[CONFIG_NET_CONTEXT_ZEROCOPY_MAX_PENDING];
+		/** Identifier of the next zero-copy send */
+		uint32_t next_id;
+		/** Generation of the context, drops completions after a reuse */
+		uint32_t gen;
+		/** Sends whose data is still referenced by the stack */
+		uint8_t pending;
+		/** Oldest range in done */
+		uint8_t head;
+		/** Number of ranges in done */
+		uint8_t count;
+	} zerocopy;
+#endif
+
+#if defined(CONFIG_NET_CONTEXT_WATCH)
+	/** Watchers notified when the context may have become ready */
+	sys_slist_t watchers;
+#endif
+
 	/** Protocol (UDP, TCP or IEEE 802.3 protocol value) */
 	uint16_t proto;
 
@@ -1208,6 +1270,33 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a batch of messages to the peers specified in their msghdr.
+ *
+ * @details This function has similar semantics as Linux sendmmsg() call.
+ * Each message is sent as with net_context_sendmsg(), the context being
+ * locked once for the whole batch. The msg_len field of each message sent
+ * is set to the number of bytes sent.
+ *
+ * @param context The network context to use.
+ * @param msgvec The messages to send
+ * @param vlen Number of messages in msgvec
+ * @param flags Flags for the sending.
+ * @param cb Caller-supplied callback function, called for each message.
+ * @param timeout Timeout for each message.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return number of messages sent if at least one was, a negative errno
+ * otherwise
+ */
+int net_context_sendmmsg(struct net_context *context,
+			 struct mmsghdr *msgvec,
+			 unsigned int vlen,
+			 int flags,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1272,6 +1361,82 @@ int net_context_recv(struct net_context *context,
 int net_context_update_recv_wnd(struct net_context *context,
 				int32_t delta);
 
+/**
+ * @brief Get the oldest completion of the zero-copy sends of a context.
+ *
+ * @details The sends made with MSG_ZEROCOPY are numbered from 0, in the
+ * order they were made. A send completes once the network stack does not
+ * reference its data anymore. Completions of consecutive sends are merged
+ * in a single range. The completion returned is removed from the context.
+ *
+ * @param context The network context to use.
+ * @param lo First send of the completed range
+ * @param hi Last send of the completed range
+ * @param copied Set if the data of these sends was copied
+ *
+ * @return 0 if ok, -EAGAIN if no send has completed, -ENOTSUP if zero-copy
+ * is not supported.
+ */
+int net_context_get_zerocopy_completion(struct net_context *context,
+					uint32_t *lo, uint32_t *hi,
+					bool *copied);
+
+/**
+ * @brief Check if a zero-copy send completion can be read from a context.
+ *
+ * @param context The network context to use.
+ *
+ * @return True if net_context_get_zerocopy_completion() would return one.
+ */
+bool net_context_has_zerocopy_completion(struct net_context *context);
+
+#if defined(CONFIG_NET_CONTEXT_WATCH) || defined(__DOXYGEN__)
+/**
+ * @brief Watch the readiness changes of a network context.
+ *
+ * @details The callback of the watcher is called each time data or a
+ * connection is queued for the application, send space becomes available,
+ * a connection is established or closed, or an error is reported. It
+ * tells that the context may have become ready, the readiness must still
+ * be checked, typically with poll().
+ *
+ * @param context The network context to watch.
+ * @param watcher The watcher, its callback must be set.
+ *
+ * @return 0 if ok, -EBADF if the context is not in use.
+ */
+int net_context_watch(struct net_context *context,
+		      struct net_context_watcher *watcher);
+
+/**
+ * @brief Stop watching a network context.
+ *
+ * @details Once this returns, the callback of the watcher is not running
+ * and will not be called anymore. It does nothing if the watcher was
+ * already dropped when the context was released.
+ *
+ * @param context The watched network context.
+ * @param watcher The watcher to remove.
+ */
+void net_context_unwatch(struct net_context *context,
+			 struct net_context_watcher *watcher);
+
+/**
+ * @brief Notify the watchers of a network context.
+ *
+ * @details Called by the network stack and the socket layer when the
+ * context may have become ready.
+ *
+ * @param context The network context whose readiness may have changed.
+ */
+void net_context_notify(struct net_context *context);
+#else
+static inline void net_context_notify(struct net_context *context)
+{
+	ARG_UNUSED(context);
+}
+#endif
+
 /** @brief Network context options. These map to BSD socket option values. */
 enum net_context_option {
 	NET_OPT_PRIORITY          = 1,  /**< Context priority */
@@ -1292,6 +1457,7 @@ enum net_context_option {
 	NET_OPT_TTL               = 16, /**< IPv4 unicast TTL */
 	NET_OPT_ADDR_PREFERENCES  = 17, /**< IPv6 address preference */
 	NET_OPT_TIMESTAMPING      = 18, /**< Packet timestamping */
+	NET_OPT_ZEROCOPY          = 19, /**< Zero-copy transmit */
 };
 
 /**
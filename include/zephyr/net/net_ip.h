@@ -257,6 +257,12 @@ struct msghdr {
 	int           msg_flags;      /**< Flags on received message */
 };
 
+/** Message struct of a batch, see zsock_sendmmsg() and zsock_recvmmsg() */
+struct mmsghdr {
+	struct msghdr msg_hdr; /**< Message */
+	unsigned int  msg_len; /**< Number of bytes sent or received */
+};
+
 /** Control message ancillary data */
 struct cmsghdr {
 	socklen_t cmsg_len;    /**< Number of bytes, including header */
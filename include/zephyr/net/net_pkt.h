@@ -292,6 +292,14 @@ struct net_pkt {
 	/** IPv4/IPv6 Explicit Congestion Notification value. */
 	uint8_t ip_ecn : 2;
 #endif /* CONFIG_NET_IP_DSCP_ECN */
+
+#if defined(CONFIG_NET_UDP_TX_CHKSUM_COPY)
+	/* Sum of the transport data, computed while it was copied into
+	 * the packet.
+	 */
+	uint16_t data_chksum;
+	uint8_t data_chksum_valid : 1;
+#endif /* CONFIG_NET_UDP_TX_CHKSUM_COPY */
 #endif /* CONFIG_NET_IP */
 
 #if defined(CONFIG_NET_VLAN)
@@ -511,6 +519,39 @@ static inline void net_pkt_set_chksum_done(struct net_pkt *pkt,
 	pkt->chksum_done = is_chksum_done;
 }
 
+static inline bool net_pkt_has_data_chksum(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_UDP_TX_CHKSUM_COPY)
+	return !!(pkt->data_chksum_valid);
+#else
+	ARG_UNUSED(pkt);
+
+	return false;
+#endif
+}
+
+static inline uint16_t net_pkt_data_chksum(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_UDP_TX_CHKSUM_COPY)
+	return pkt->data_chksum;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0U;
+#endif
+}
+
+static inline void net_pkt_set_data_chksum(struct net_pkt *pkt, uint16_t sum)
+{
+#if defined(CONFIG_NET_UDP_TX_CHKSUM_COPY)
+	pkt->data_chksum = sum;
+	pkt->data_chksum_valid = 1U;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+#endif
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_IP)
@@ -2307,6 +2348,26 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt while summing it for the Internet
+ *        checksum
+ *
+ * @details Same as net_pkt_write() but it also adds the data to @p sum in
+ *          the same pass as the copy.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ * @param offset Offset of the data in the checksummed area, its parity
+ *               telling how the data is aligned on the 16-bit words
+ * @param sum    Ones' complement sum, in host byte order, of the 16-bit
+ *               words of the checksummed area, updated with the data
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 size_t offset, uint16_t *sum);
+
 /**
  * @brief Write a byte (uint8_t) data to a net_pkt
  *
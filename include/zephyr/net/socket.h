@@ -76,6 +76,12 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmsg: Read a queued error, such as a zero-copy send completion */
+#define ZSOCK_MSG_ERRQUEUE 0x2000
+/** zsock_recvmmsg: Turn on ZSOCK_MSG_DONTWAIT after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
+/** zsock_send: Reference the data instead of copying it, see SO_ZEROCOPY */
+#define ZSOCK_MSG_ZEROCOPY 0x4000000
 /** @} */
 
 /**
@@ -474,6 +480,28 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages in a single call
+ *
+ * @details
+ * Sends the vlen messages of msgvec as zsock_sendmsg() would, setting the
+ * msg_len of each message sent to the number of bytes sent. The socket is
+ * looked up and locked once for the whole batch, and for datagram sockets
+ * the network context is locked once as well.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in msgvec
+ * @param flags Flags for all the messages, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, which can be less than vlen, or -1 with
+ *         errno set if no message could be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -500,6 +528,32 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive multiple messages in a single call
+ *
+ * @details
+ * Receives up to vlen messages into msgvec as zsock_recvmsg() would, setting
+ * the msg_len of each message received to the number of bytes received.
+ * With ZSOCK_MSG_WAITFORONE, only the first message is waited for. The
+ * timeout, if not NULL, is checked after each message received, so a
+ * blocking call may still wait for the first message past it.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to receive into
+ * @param vlen Number of messages in msgvec
+ * @param flags Flags for all the messages, as for zsock_recvmsg(), and
+ *        ZSOCK_MSG_WAITFORONE
+ * @param timeout Time after which no more messages are received, or NULL
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     struct timespec *timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -890,6 +944,13 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -903,6 +964,13 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags, struct timespec *timeout)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags, timeout);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1009,6 +1077,12 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
+/** POSIX wrapper for @ref ZSOCK_MSG_ERRQUEUE */
+#define MSG_ERRQUEUE ZSOCK_MSG_ERRQUEUE
+/** POSIX wrapper for @ref ZSOCK_MSG_ZEROCOPY */
+#define MSG_ZEROCOPY ZSOCK_MSG_ZEROCOPY
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1131,6 +1205,34 @@ struct ifreq {
 /** Socket TX time (same as SO_TXTIME) */
 #define SCM_TXTIME SO_TXTIME
 
+/** Allow the ZSOCK_MSG_ZEROCOPY flag when sending */
+#define SO_ZEROCOPY 62
+
+/**
+ * @brief Error read from the error queue of a socket.
+ *
+ * Received as ancillary data of level IPPROTO_IP and type IP_RECVERR, or of
+ * level IPPROTO_IPV6 and type IPV6_RECVERR, when calling recvmsg() with
+ * ZSOCK_MSG_ERRQUEUE. For a zero-copy send completion, ee_origin is
+ * SO_EE_ORIGIN_ZEROCOPY and the sends from ee_info to ee_data inclusive,
+ * numbered from 0, do not reference their data anymore.
+ */
+struct sock_extended_err {
+	uint32_t ee_errno;  /**< Error number */
+	uint8_t  ee_origin; /**< Origin of the error */
+	uint8_t  ee_type;   /**< Type */
+	uint8_t  ee_code;   /**< Code */
+	uint8_t  ee_pad;    /**< Reserved */
+	uint32_t ee_info;   /**< Additional information */
+	uint32_t ee_data;   /**< Other data */
+};
+
+/** The error is a zero-copy send completion */
+#define SO_EE_ORIGIN_ZEROCOPY 5
+
+/** The data of the completed zero-copy sends was copied */
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+
 /** Timestamp generation flags */
 
 /** Request RX timestamps generated by network adapter. */
@@ -1158,6 +1260,34 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, by name ("reno", "cubic" or "bbr") */
+#define TCP_CONGESTION 5
+/** Connection information, see struct tcp_info (read only) */
+#define TCP_INFO 6
+
+/** Timestamps are in use on the connection (tcp_info::tcpi_options) */
+#define TCPI_OPT_TIMESTAMPS BIT(0)
+/** SACK is in use on the connection (tcp_info::tcpi_options) */
+#define TCPI_OPT_SACK BIT(1)
+
+/**
+ * @brief Struct returned by the TCP_INFO socket option.
+ */
+struct tcp_info {
+	uint8_t  tcpi_state;        /**< Connection state, see net_tcp_state_str() */
+	uint8_t  tcpi_retransmits;  /**< Retransmissions of the unacknowledged data */
+	uint8_t  tcpi_options;      /**< TCPI_OPT_* options in use */
+	uint8_t  tcpi_pad;          /**< Reserved */
+	uint32_t tcpi_rto;          /**< Retransmission timeout (usec) */
+	uint32_t tcpi_snd_mss;      /**< Maximum segment size sent (bytes) */
+	uint32_t tcpi_rtt;          /**< Smoothed round trip time (usec), 0 if unknown */
+	uint32_t tcpi_rttvar;       /**< Round trip time variation (usec) */
+	uint32_t tcpi_snd_ssthresh; /**< Slow start threshold (bytes) */
+	uint32_t tcpi_snd_cwnd;     /**< Congestion window (bytes) */
+	uint32_t tcpi_snd_wnd;      /**< Send window advertised by the peer (bytes) */
+	uint32_t tcpi_rcv_wnd;      /**< Receive window (bytes) */
+	uint32_t tcpi_unacked;      /**< Data sent and not acknowledged (bytes) */
+};
 
 /** @} */
 
@@ -1178,6 +1308,11 @@ struct ifreq {
  */
 #define IP_PKTINFO 8
 
+/** Ancillary message of the errors read with ZSOCK_MSG_ERRQUEUE, see
+ *  struct sock_extended_err.
+ */
+#define IP_RECVERR 11
+
 /**
  * @brief Incoming IPv4 packet information.
  *
@@ -1236,6 +1371,11 @@ struct ipv6_mreq {
 	int ipv6mr_ifindex;
 };
 
+/** Ancillary message of the errors read with ZSOCK_MSG_ERRQUEUE, see
+ *  struct sock_extended_err.
+ */
+#define IPV6_RECVERR 25
+
 /** Don't support IPv4 access */
 #define IPV6_V6ONLY 26
 
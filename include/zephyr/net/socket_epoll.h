@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file socket_epoll.h
+ *
+ * @brief epoll like readiness notification for sockets.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Data is available for reading */
+#define ZSOCK_EPOLLIN ZSOCK_POLLIN
+/** Priority data is available for reading */
+#define ZSOCK_EPOLLPRI ZSOCK_POLLPRI
+/** Data can be written without blocking */
+#define ZSOCK_EPOLLOUT ZSOCK_POLLOUT
+/** An error is pending, always reported */
+#define ZSOCK_EPOLLERR ZSOCK_POLLERR
+/** The connection was closed, always reported */
+#define ZSOCK_EPOLLHUP ZSOCK_POLLHUP
+/** Report the socket once, until it is re-armed with ZSOCK_EPOLL_CTL_MOD */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** Edge-triggered: report the socket only when its readiness changes */
+#define ZSOCK_EPOLLET BIT(31)
+
+/** Add a socket to the interest set */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a socket from the interest set */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events of a socket in the interest set */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data returned with the events of a socket */
+union zsock_epoll_data {
+	void *ptr;    /**< Pointer */
+	int fd;       /**< File descriptor */
+	uint32_t u32; /**< 32-bit value */
+	uint64_t u64; /**< 64-bit value */
+};
+
+/** Events of a socket */
+struct zsock_epoll_event {
+	uint32_t events;             /**< Requested or returned events */
+	union zsock_epoll_data data; /**< User data */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * An epoll instance holds an interest set of sockets. Unlike zsock_poll(),
+ * which checks every socket it is passed on each call, the sockets of the
+ * set report themselves to the instance when their state changes, so that
+ * waiting costs the number of ready sockets rather than the size of the
+ * set. Only native sockets can be added to the set. The returned
+ * descriptor is closed with zsock_close() and can itself be polled for
+ * ZSOCK_POLLIN.
+ * This function is also exposed as `epoll_create1()`
+ * if @kconfig{CONFIG_NET_SOCKETS_POSIX_NAMES} is defined.
+ *
+ * @param flags Must be 0.
+ *
+ * @return The epoll descriptor, or -1 with errno set.
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a socket of an epoll instance
+ *
+ * @details
+ * Follows the Linux epoll_ctl() semantics. The socket is level-triggered
+ * unless ZSOCK_EPOLLET is given: it is then only reported again once new
+ * data, connections or send space arrive. A socket is removed from the
+ * instance when it is closed.
+ * This function is also exposed as `epoll_ctl()`
+ * if @kconfig{CONFIG_NET_SOCKETS_POSIX_NAMES} is defined.
+ *
+ * @param epfd The epoll descriptor.
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL.
+ * @param fd The socket.
+ * @param event The requested events and user data, ignored for
+ * ZSOCK_EPOLL_CTL_DEL.
+ *
+ * @return 0 if ok, or -1 with errno set: EEXIST if the socket is already
+ * added, ENOENT if it was not, EPERM if it is not a native socket, ENOMEM if
+ * the instances have no room left.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for sockets of an epoll instance to become ready
+ *
+ * @details
+ * This function is also exposed as `epoll_wait()`
+ * if @kconfig{CONFIG_NET_SOCKETS_POSIX_NAMES} is defined.
+ *
+ * @param epfd The epoll descriptor.
+ * @param events Filled with the events and the user data of the ready
+ * sockets.
+ * @param maxevents Maximum number of entries of events, greater than 0.
+ * @param timeout Timeout in milliseconds, -1 to wait forever, 0 to return
+ * immediately.
+ *
+ * @return The number of ready sockets, 0 on timeout, or -1 with errno set.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLPRI ZSOCK_EPOLLPRI
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data zsock_epoll_data
+#define epoll_data_t union zsock_epoll_data
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -46,6 +46,8 @@ struct zperf_upload_params {
 		int tcp_nodelay;
 		int priority;
 		uint32_t report_interval_ms;
+		char tcp_congestion[16]; /* Empty for the default algorithm */
+		uint16_t udp_batch; /* Datagrams per zsock_sendmmsg(), 0 for zsock_send() */
 	} options;
 };
 
@@ -13,6 +13,7 @@
 #include <zephyr/sys/slist.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -259,6 +260,15 @@ int settings_register_with_cprio(struct settings_handler *cf,
  */
 int settings_register(struct settings_handler *cf);
 
+/**
+ * Deregister a handler for settings items stored in RAM.
+ *
+ * @param cf Structure containing registration info.
+ *
+ * @return true if the handler was registered, false otherwise.
+ */
+bool settings_deregister(struct settings_handler *cf);
+
 /**
  * Load serialized items from registered persistence sources. Handlers for
  * serialized item subtrees registered earlier will be called for encountered
@@ -65,6 +65,26 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint64_t alloc_cycles;
+	uint64_t free_cycles;
+	/* Sum of the bytes not in use when an allocation failed, the
+	 * higher the average, the more fragmented the heap.
+	 */
+	uint64_t accumulated_failed_free_bytes;
+};
+
+/**
+ * @brief Runtime statistics of a sys_heap slab size class
+ */
+struct sys_heap_slab_stats {
+	/** Size in bytes of the blocks of the class */
+	size_t block_size;
+	/** Number of freed blocks currently held in the class cache */
+	uint32_t cached;
+	/** Number of allocations served from the class cache */
+	uint32_t hits;
+	/** Number of allocations that had to refill the class cache */
+	uint32_t misses;
 };
 
 /**
@@ -96,6 +116,21 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/**
+ * @brief Get the runtime statistics of a sys_heap slab size class
+ *
+ * The hit rate of a class is @a hits / (@a hits + @a misses).
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param cls Size class, from 0 to CONFIG_SYS_HEAP_SLAB_CLASSES - 1
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers or invalid class, otherwise 0
+ */
+int sys_heap_slab_stats_get(struct sys_heap *heap, int cls,
+			    struct sys_heap_slab_stats *stats);
+#endif
+
 #endif
 
 /** @brief Initialize sys_heap
@@ -108,6 +143,28 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
  */
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes);
 
+/** @brief Enable the slab caches of a sys_heap
+ *
+ * Once enabled, requests of up to CONFIG_SYS_HEAP_SLAB_MIN_SIZE times
+ * 2^(CONFIG_SYS_HEAP_SLAB_CLASSES - 1) bytes are rounded up to a
+ * power-of-two size class, and freed blocks of a class are cached for
+ * reuse by the next allocation of that class instead of being merged
+ * back into the heap.  The caches are flushed back into the heap
+ * before any allocation is allowed to fail.  Must be called right
+ * after sys_heap_init(), before any allocation.  Does nothing unless
+ * CONFIG_SYS_HEAP_SLAB is enabled.
+ *
+ * @param heap Heap to enable the slab caches of
+ */
+#ifdef CONFIG_SYS_HEAP_SLAB
+void sys_heap_slab_enable(struct sys_heap *heap);
+#else
+static inline void sys_heap_slab_enable(struct sys_heap *heap)
+{
+	ARG_UNUSED(heap);
+}
+#endif
+
 /** @brief Allocate memory from a sys_heap
  *
  * Returns a pointer to a block of unused memory in the heap.  This
@@ -229,7 +286,8 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations and the cycles spent in the callbacks, are returned
+ * via the @a result struct.
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
@@ -239,11 +239,49 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
  */
 void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 
+/**
+ * Wake up a batch of threads pending on the provided wait queue
+ *
+ * Walk the wait queue in priority order and wake up every thread for which
+ * @a filter returns true, or every thread if @a filter is NULL, as
+ * z_sched_wake() would. Unlike repeated calls to z_sched_wake(), the whole
+ * batch is moved to the run queue under a single hold of _sched_spinlock,
+ * with one ready cache update and one IPI mask covering all the woken
+ * threads, but without invoking the scheduler.
+ *
+ * The filter is called with _sched_spinlock held. It may update the thread
+ * it is given, but must not modify any wait queue.
+ *
+ * @param wait_q Wait queue to wake up threads from
+ * @param swap_retval Swap return value for woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @param filter Callback selecting the threads to wake up. May be NULL.
+ * @param data Custom data passed to the filter
+ * @return Number of threads woken up
+ */
+int z_sched_wake_batch(_wait_q_t *wait_q, int swap_retval, void *swap_data,
+		       bool (*filter)(struct k_thread *thread, void *data),
+		       void *data);
+
+/**
+ * Wake up a list of pending threads
+ *
+ * Like z_sched_wake_batch(), but for threads collected by the caller, which
+ * may pend on different wait queues. The threads are linked through their
+ * base.swap_data, the last one holding NULL. Threads no longer pending,
+ * e.g. because their timeout expired meanwhile, are skipped.
+ *
+ * @param head First thread of the list
+ * @param swap_retval Swap return value for woken threads
+ * @return Number of threads woken up
+ */
+int z_sched_wake_list(struct k_thread *head, int swap_retval);
+
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience function to invoke z_sched_wake_batch() on all threads in
+ * the queue.
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -254,14 +292,9 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
 	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_batch(wait_q, swap_retval, swap_data,
+				  NULL, NULL) != 0;
 }
 
 /**
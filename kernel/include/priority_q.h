@@ -167,8 +167,26 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread)
 {
 	struct prio_info pos = get_prio_info(thread->base.prio);
+	sys_dlist_t *l = &pq->queues[pos.offset_prio];
 
-	sys_dlist_append(&pq->queues[pos.offset_prio], &thread->base.qnode_dlist);
+#ifdef CONFIG_SCHED_DEADLINE
+	/* Keep the bucket in deadline order (FIFO among equal
+	 * deadlines), so its head is still the best thread.  Only
+	 * threads of the same priority are walked.
+	 */
+	struct k_thread *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(l, t, base.qnode_dlist) {
+		if (z_sched_prio_cmp(thread, t) > 0) {
+			sys_dlist_insert(&t->base.qnode_dlist,
+					 &thread->base.qnode_dlist);
+			pq->bitmask[pos.idx] |= BIT(pos.bit);
+			return;
+		}
+	}
+#endif /* CONFIG_SCHED_DEADLINE */
+
+	sys_dlist_append(l, &thread->base.qnode_dlist);
 	pq->bitmask[pos.idx] |= BIT(pos.bit);
 }
 
@@ -32,6 +32,17 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 
 int z_abort_timeout(struct _timeout *to);
 
+/**
+ * Moves a timeout to a new expiry, adding it if it isn't pending.
+ * Equivalent to z_abort_timeout() followed by z_add_timeout(), but
+ * atomic and cheaper, as the timeout is only unlinked and relinked.
+ * With K_FOREVER, the timeout is just aborted.
+ *
+ * @return 0 if the timeout was pending, -EINVAL otherwise
+ */
+int z_update_timeout(struct _timeout *to, _timeout_func_t fn,
+		     k_timeout_t timeout);
+
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
 	return !sys_dnode_is_linked(&to->node);
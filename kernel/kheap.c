@@ -16,6 +16,7 @@ void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	sys_heap_init(&heap->heap, mem, bytes);
+	sys_heap_slab_enable(&heap->heap);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
 }
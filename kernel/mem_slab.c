@@ -33,6 +33,10 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	((struct k_mem_slab_info *)stats)->num_used =
+		k_mem_slab_num_used_get(slab);
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +52,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) *
+			       slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -72,7 +76,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = k_mem_slab_num_used_get(slab);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 	k_spin_unlock(&slab->lock, key);
@@ -179,6 +183,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	atomic_clear(&slab->cache_waiters);
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -216,13 +225,260 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 }
 #endif
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/*
+ * Each CPU keeps a small list of free blocks in front of the slab's
+ * shared free list.  Blocks in the CPU caches are accounted as used in
+ * slab->info, as they are not on the free list.  A cache is normally
+ * only touched by its own CPU, so its lock stays uncontended; other CPUs
+ * only take it to steal the cached blocks when the shared free list runs
+ * dry.  The caches are embedded in the slab, which sits in an iterable
+ * section that can't honour a cache line alignment, so they may still
+ * share cache lines with each other.  The slab lock is always taken
+ * before a cache lock, never the other way around.
+ */
+
+static void update_max_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = MAX(k_mem_slab_num_used_get(slab),
+				  slab->info.max_used);
+#else
+	ARG_UNUSED(slab);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+/* Must be called with interrupts locked, so the CPU can't change */
+static struct z_mem_slab_cache *cpu_cache_get(struct k_mem_slab *slab)
+{
+	return &slab->cache[arch_curr_cpu()->id];
+}
+
+/* Takes a block from the shared free list for the current CPU, and moves
+ * up to CONFIG_MEM_SLAB_PER_CPU_CACHE_BATCH - 1 more into its cache.
+ */
+static char *cpu_cache_refill(struct k_mem_slab *slab,
+			      struct z_mem_slab_cache *cache)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	char *block = slab->free_list;
+	char *head, *tail = NULL;
+	uint32_t n = 0;
+
+	if (block != NULL) {
+		head = *(char **)block;
+		for (char *p = head; (p != NULL) &&
+		     (n < CONFIG_MEM_SLAB_PER_CPU_CACHE_BATCH - 1);
+		     p = *(char **)p) {
+			tail = p;
+			n++;
+		}
+
+		slab->free_list = (tail != NULL) ? *(char **)tail : head;
+		slab->info.num_used += n + 1;
+
+		if (n != 0U) {
+			K_SPINLOCK(&cache->lock) {
+				*(char **)tail = cache->free_list;
+				cache->free_list = head;
+				cache->count += n;
+			}
+		}
+
+		update_max_used(slab);
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return block;
+}
+
+static bool cpu_cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct z_mem_slab_cache *cache = cpu_cache_get(slab);
+	char *block;
+
+	K_SPINLOCK(&cache->lock) {
+		block = cache->free_list;
+		if (block != NULL) {
+			cache->free_list = *(char **)block;
+			cache->count--;
+		}
+	}
+
+	if (block == NULL) {
+		block = cpu_cache_refill(slab, cache);
+	}
+
+	arch_irq_unlock(irq_key);
+
+	*mem = block;
+
+	return block != NULL;
+}
+
+/* Moves the blocks cached by all CPUs to the shared free list.  Must be
+ * called with the slab lock held.
+ */
+static void cpu_cache_steal(struct k_mem_slab *slab)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct z_mem_slab_cache *cache = &slab->cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			char *tail = cache->free_list;
+
+			if (tail == NULL) {
+				K_SPINLOCK_BREAK;
+			}
+
+			while (*(char **)tail != NULL) {
+				tail = *(char **)tail;
+			}
+
+			*(char **)tail = slab->free_list;
+			slab->free_list = cache->free_list;
+			slab->info.num_used -= cache->count;
+			cache->free_list = NULL;
+			cache->count = 0U;
+		}
+	}
+}
+
+/* Returns a NULL terminated chain of blocks to the slab, handing them to
+ * waiting threads first.
+ */
+static void free_list_return(struct k_mem_slab *slab, char *chain)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool woken = false;
+
+	while (chain != NULL) {
+		char *block = chain;
+		struct k_thread *pending_thread = NULL;
+
+		chain = *(char **)chain;
+
+		if (slab->free_list == NULL) {
+			pending_thread = z_unpend_first_thread(&slab->wait_q);
+		}
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0, block);
+			z_ready_thread(pending_thread);
+			woken = true;
+		} else {
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+			slab->info.num_used--;
+		}
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
+/* Detaches up to @a max blocks from a CPU cache */
+static char *cpu_cache_take(struct z_mem_slab_cache *cache, uint32_t max)
+{
+	char *chain = NULL;
+
+	K_SPINLOCK(&cache->lock) {
+		char *tail = cache->free_list;
+		uint32_t n = 1;
+
+		if (tail == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		while ((n < max) && (*(char **)tail != NULL)) {
+			tail = *(char **)tail;
+			n++;
+		}
+
+		chain = cache->free_list;
+		cache->free_list = *(char **)tail;
+		cache->count -= n;
+		*(char **)tail = NULL;
+	}
+
+	return chain;
+}
+
+static bool cpu_cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct z_mem_slab_cache *cache;
+	unsigned int irq_key;
+	uint32_t drain = 0;
+
+	/* A waiting thread needs the block, so skip the cache */
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		return false;
+	}
+
+	irq_key = arch_irq_lock();
+	cache = cpu_cache_get(slab);
+
+	K_SPINLOCK(&cache->lock) {
+		*(char **)mem = cache->free_list;
+		cache->free_list = mem;
+		cache->count++;
+		if (cache->count > CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE) {
+			drain = CONFIG_MEM_SLAB_PER_CPU_CACHE_BATCH;
+		}
+	}
+
+	arch_irq_unlock(irq_key);
+
+	/* A thread may have started waiting after it stole the cached
+	 * blocks but before the block above got cached, give it all back.
+	 */
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		drain = UINT32_MAX;
+	}
+
+	if (drain != 0U) {
+		free_list_return(slab, cpu_cache_take(cache, drain));
+	}
+
+	return true;
+}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cpu_cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (slab->free_list == NULL) {
+		/* Announce the waiter before stealing, see cpu_cache_free() */
+		atomic_inc(&slab->cache_waiters);
+		cpu_cache_steal(slab);
+		if ((slab->free_list != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			atomic_dec(&slab->cache_waiters);
+		}
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -234,7 +490,7 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			 "slab corruption detected");
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->info.max_used = MAX(slab->info.num_used,
+		slab->info.max_used = MAX(k_mem_slab_num_used_get(slab),
 					  slab->info.max_used);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
@@ -253,6 +509,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+		atomic_dec(&slab->cache_waiters);
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
@@ -267,11 +527,21 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cpu_cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
 	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -301,8 +571,9 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) *
+				 slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -325,7 +596,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = k_mem_slab_num_used_get(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
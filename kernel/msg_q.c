@@ -24,6 +24,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/barrier.h>
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
 static struct k_obj_type obj_type_msgq;
@@ -36,6 +37,293 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+/*
+ * Lock-free message queues are bounded multi-producer/multi-consumer rings
+ * of slots, each starting with a sequence number. A put claims the next
+ * put ticket (msgq->head) once the sequence number of the ticket's slot
+ * shows the slot is free, copies its message and then publishes it by
+ * advancing the sequence number. A get does the same with the next get
+ * ticket (msgq->tail), releasing the slot for the put one lap later.
+ *
+ * Neither ever waits for another put or get to complete: a slot which has
+ * been claimed but not published yet simply makes the queue look full or
+ * empty. Threads which then have to block do so on the wait queue, under
+ * the message queue lock, after announcing themselves in msgq->waiters.
+ * Each completed put or get checks msgq->waiters after publishing its slot
+ * and, if needed, wakes one blocked thread of the other kind so that it
+ * retries. A woken thread may find the slot it was woken for still not
+ * published by an earlier ticket, or taken by a thread which did not
+ * block. A woken thread which completes its put or get therefore also
+ * wakes one blocked thread of its own kind, the wakeups being passed on
+ * for as long as the blocked threads make progress.
+ *
+ * Sequence numbers are stored relative to their slot index, so that a
+ * zeroed ring buffer is a valid empty queue.
+ */
+
+static inline bool is_lockless(struct k_msgq *msgq)
+{
+	return (msgq->flags & K_MSGQ_FLAG_LOCKLESS) != 0U;
+}
+
+/* Tickets wrap around, compare them through their signed difference */
+static inline long ticket_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (long)((unsigned long)a - (unsigned long)b);
+}
+
+static inline atomic_val_t ticket_add(atomic_val_t ticket, unsigned long n)
+{
+	return (atomic_val_t)((unsigned long)ticket + n);
+}
+
+static inline atomic_t *slot_get(struct k_msgq *msgq, atomic_val_t ticket,
+				 unsigned long *idx)
+{
+	*idx = (unsigned long)ticket & (msgq->max_msgs - 1U);
+
+	return (atomic_t *)(msgq->buffer_start +
+			    (*idx * K_MSGQ_LOCKLESS_SLOT_SIZE(msgq->msg_size)));
+}
+
+static inline atomic_val_t slot_seq_get(atomic_t *slot, unsigned long idx)
+{
+	return ticket_add(atomic_get(slot), idx);
+}
+
+static inline void slot_seq_set(atomic_t *slot, unsigned long idx,
+				atomic_val_t seq)
+{
+	(void)atomic_set(slot, ticket_add(seq, -idx));
+}
+
+static int lockless_put(struct k_msgq *msgq, const void *data)
+{
+	atomic_val_t ticket = atomic_get(&msgq->head);
+	unsigned long idx;
+	atomic_t *slot;
+	long diff;
+
+	while (true) {
+		slot = slot_get(msgq, ticket, &idx);
+		diff = ticket_diff(slot_seq_get(slot, idx), ticket);
+
+		if (diff < 0) {
+			/* slot still holds the message from the previous lap */
+			return -ENOMSG;
+		}
+
+		if ((diff == 0) &&
+		    atomic_cas(&msgq->head, ticket, ticket_add(ticket, 1U))) {
+			break;
+		}
+
+		/* ticket claimed by another put, try the next one */
+		ticket = atomic_get(&msgq->head);
+	}
+
+	(void)memcpy(slot + 1, data, msgq->msg_size);
+	slot_seq_set(slot, idx, ticket_add(ticket, 1U));
+
+	return 0;
+}
+
+static int lockless_get(struct k_msgq *msgq, void *data)
+{
+	atomic_val_t ticket = atomic_get(&msgq->tail);
+	unsigned long idx;
+	atomic_t *slot;
+	long diff;
+
+	while (true) {
+		slot = slot_get(msgq, ticket, &idx);
+		diff = ticket_diff(slot_seq_get(slot, idx),
+				   ticket_add(ticket, 1U));
+
+		if (diff < 0) {
+			/* slot not published yet */
+			return -ENOMSG;
+		}
+
+		if ((diff == 0) &&
+		    atomic_cas(&msgq->tail, ticket, ticket_add(ticket, 1U))) {
+			break;
+		}
+
+		/* ticket claimed by another get, try the next one */
+		ticket = atomic_get(&msgq->tail);
+	}
+
+	if (data != NULL) {
+		(void)memcpy(data, slot + 1, msgq->msg_size);
+	}
+	slot_seq_set(slot, idx, ticket_add(ticket, msgq->max_msgs));
+
+	return 0;
+}
+
+static int lockless_peek(struct k_msgq *msgq, void *data, uint32_t idx)
+{
+	atomic_val_t ticket;
+	atomic_val_t seq;
+	unsigned long slot_idx;
+	atomic_t *slot;
+	long diff;
+
+	if (idx >= msgq->max_msgs) {
+		return -ENOMSG;
+	}
+
+	while (true) {
+		ticket = ticket_add(atomic_get(&msgq->tail), idx);
+		slot = slot_get(msgq, ticket, &slot_idx);
+		seq = slot_seq_get(slot, slot_idx);
+		diff = ticket_diff(seq, ticket_add(ticket, 1U));
+
+		if (diff < 0) {
+			return -ENOMSG;
+		}
+
+		if (diff == 0) {
+			(void)memcpy(data, slot + 1, msgq->msg_size);
+
+			/* only valid if the message was not got meanwhile */
+			if (slot_seq_get(slot, slot_idx) == seq) {
+				return 0;
+			}
+		}
+	}
+}
+
+/* Blocked threads hold the kind of their operation in their swap_data */
+#define LOCKLESS_WAKE_PUT BIT(0)
+#define LOCKLESS_WAKE_GET BIT(1)
+
+struct lockless_wake_req {
+	struct k_msgq *msgq;
+	uint8_t kinds;
+};
+
+static void *lockless_kind_tag(struct k_msgq *msgq, bool put)
+{
+	return put ? (void *)&msgq->head : (void *)&msgq->tail;
+}
+
+/* Selects the first blocked thread of each requested kind */
+static bool lockless_wake_filter(struct k_thread *thread, void *data)
+{
+	struct lockless_wake_req *req = data;
+	uint8_t kind = (thread->base.swap_data == lockless_kind_tag(req->msgq, true)) ?
+		       LOCKLESS_WAKE_PUT : LOCKLESS_WAKE_GET;
+
+	if ((req->kinds & kind) == 0U) {
+		return false;
+	}
+
+	req->kinds &= ~kind;
+
+	return true;
+}
+
+/* Wake up one thread blocked on a lock-free queue for the other kind of
+ * operation, if any, so that it retries it. When the caller was blocked
+ * itself, also wake up one thread of its own kind.
+ */
+static void lockless_wake(struct k_msgq *msgq, bool put, bool waited)
+{
+	struct lockless_wake_req req = {
+		.msgq = msgq,
+		.kinds = put ? LOCKLESS_WAKE_GET : LOCKLESS_WAKE_PUT,
+	};
+	k_spinlock_key_t key;
+
+	/* Order the publication of the slot before the check of the
+	 * waiters, pairs with the barrier in lockless_wait().
+	 */
+	barrier_dmem_fence_full();
+
+	if (atomic_get(&msgq->waiters) == 0) {
+		return;
+	}
+
+	if (waited) {
+		req.kinds |= put ? LOCKLESS_WAKE_PUT : LOCKLESS_WAKE_GET;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (z_sched_wake_batch(&msgq->wait_q, 0, NULL, lockless_wake_filter,
+			       &req) != 0) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+static int lockless_wait(struct k_msgq *msgq, void *data, bool put,
+			 k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	while (true) {
+		key = k_spin_lock(&msgq->lock);
+
+		/* Announce this thread before retrying: a put or get
+		 * completing concurrently either sees it and wakes it up,
+		 * or has published its slot in time for the retry. Pairs
+		 * with the barrier in lockless_wake().
+		 */
+		atomic_inc(&msgq->waiters);
+		barrier_dmem_fence_full();
+
+		result = put ? lockless_put(msgq, data) : lockless_get(msgq, data);
+		timeout = sys_timepoint_timeout(end);
+
+		if ((result == 0) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			atomic_dec(&msgq->waiters);
+			k_spin_unlock(&msgq->lock, key);
+
+			return (result == 0) ? 0 : -EAGAIN;
+		}
+
+		_current->base.swap_data = lockless_kind_tag(msgq, put);
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		atomic_dec(&msgq->waiters);
+
+		/* purging only fails blocked puts */
+		if ((result == -EAGAIN) || (put && (result == -ENOMSG))) {
+			return result;
+		}
+	}
+}
+
+int k_msgq_init_lockless(struct k_msgq *msgq, char *buffer, size_t msg_size,
+			 uint32_t max_msgs)
+{
+	size_t buf_size = K_MSGQ_LOCKLESS_BUF_SIZE(msg_size, max_msgs);
+
+	CHECKIF(!IS_POWER_OF_TWO(max_msgs) ||
+		!IS_ALIGNED(buffer, sizeof(atomic_t))) {
+		return -EINVAL;
+	}
+
+	(void)memset(buffer, 0, buf_size);
+
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+
+	msgq->buffer_end = buffer + buf_size;
+	msgq->flags = K_MSGQ_FLAG_LOCKLESS;
+	atomic_clear(&msgq->head);
+	atomic_clear(&msgq->tail);
+	atomic_clear(&msgq->waiters);
+
+	return 0;
+}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -129,6 +417,30 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (is_lockless(msgq)) {
+		bool waited = false;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+		result = lockless_put(msgq, data);
+		if ((result != 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+			result = lockless_wait(msgq, (void *)data, true, timeout);
+			waited = true;
+		}
+
+		if (result == 0) {
+			lockless_wake(msgq, true, waited);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
@@ -199,7 +511,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_msgq_used_msgs(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -221,6 +533,30 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	struct k_thread *pending_thread;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (is_lockless(msgq)) {
+		bool waited = false;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+		result = lockless_get(msgq, data);
+		if ((result != 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+			result = lockless_wait(msgq, data, false, timeout);
+			waited = true;
+		}
+
+		if (result == 0) {
+			lockless_wake(msgq, false, waited);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -298,6 +634,16 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (is_lockless(msgq)) {
+		result = lockless_peek(msgq, data, 0U);
+
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -335,6 +681,16 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	uint32_t byte_offset;
 	char *start_addr;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (is_lockless(msgq)) {
+		result = lockless_peek(msgq, data, idx);
+
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > idx) {
@@ -382,6 +738,24 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (is_lockless(msgq)) {
+		/* discard the messages, then fail the blocked puts; blocked
+		 * gets retry and block again
+		 */
+		while (lockless_get(msgq, NULL) == 0) {
+		}
+
+		if (z_sched_wake_all(&msgq->wait_q, -ENOMSG, NULL)) {
+			z_reschedule(&msgq->lock, key);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+
+		return;
+	}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 	/* wake up any threads that are waiting to write */
 	for (pending_thread = z_unpend_first_thread(&msgq->wait_q); pending_thread != NULL;
 		 pending_thread = z_unpend_first_thread(&msgq->wait_q)) {
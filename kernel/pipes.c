@@ -346,6 +346,17 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		src->buffer         += bytes_copied;
 		src->bytes_to_xfer  -= bytes_copied;
 
+		if (src->thread == NULL) {
+
+			/* Reading from the pipe buffer. Update details. */
+
+			pipe->bytes_used -= bytes_copied;
+			pipe->read_index += bytes_copied;
+			if (pipe->read_index >= pipe->size) {
+				pipe->read_index -= pipe->size;
+			}
+		}
+
 		if (dest->thread == NULL) {
 
 			/* Writing to the pipe buffer. Update details. */
@@ -374,9 +385,171 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		}
 	}
 
+	if (dest != NULL) {
+		/* Keep the partially filled destination for further writes */
+		sys_dlist_prepend(dest_list, &dest->node);
+	}
+
 	return num_bytes_written;
 }
 
+/**
+ * @brief Copy data from source(s) to a single destination
+ */
+static size_t pipe_read(struct k_pipe *pipe, sys_dlist_t *src_list,
+			struct _pipe_desc *dest, bool *reschedule)
+{
+	struct _pipe_desc *src;
+	size_t  bytes_copied;
+	size_t  num_bytes_read = 0U;
+
+	src = (struct _pipe_desc *)sys_dlist_get(src_list);
+	while (src != NULL) {
+		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
+					 src->buffer, src->bytes_to_xfer);
+
+		num_bytes_read += bytes_copied;
+
+		src->buffer += bytes_copied;
+		src->bytes_to_xfer -= bytes_copied;
+
+		if (dest->buffer != NULL) {
+			dest->buffer += bytes_copied;
+		}
+		dest->bytes_to_xfer -= bytes_copied;
+
+		if (src->thread == NULL) {
+
+			/* Reading from the pipe buffer. Update details. */
+
+			pipe->bytes_used -= bytes_copied;
+			pipe->read_index += bytes_copied;
+			if (pipe->read_index >= pipe->size) {
+				pipe->read_index -= pipe->size;
+			}
+		} else if (src->bytes_to_xfer == 0U) {
+
+			/* The thread's write request has been satisfied. */
+
+			z_unpend_thread(src->thread);
+			z_ready_thread(src->thread);
+
+			*reschedule = true;
+		}
+
+		if (src->bytes_to_xfer != 0U) {
+			/* The destination is full, keep the rest for later */
+			sys_dlist_prepend(src_list, &src->node);
+			break;
+		}
+
+		src = (struct _pipe_desc *)sys_dlist_get(src_list);
+	}
+
+	return num_bytes_read;
+}
+
+static inline bool pipe_buffer_writable(struct k_pipe *pipe)
+{
+	return (pipe->bytes_used != pipe->size) &&
+	       ((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) == 0U);
+}
+
+static inline bool pipe_buffer_readable(struct k_pipe *pipe)
+{
+	return (pipe->bytes_used != 0U) &&
+	       ((pipe->flags & K_PIPE_FLAG_GET_CLAIM) == 0U);
+}
+
+/*
+ * Data goes directly from a waiting writer to a reader only when no data of
+ * the pipe buffer is left behind: none is buffered, or all of it is read
+ * first. It would otherwise overtake the data claimed for reading.
+ */
+static inline bool pipe_waiters_xferable(struct k_pipe *pipe)
+{
+	return (pipe->bytes_used == 0U) ||
+	       ((pipe->flags & K_PIPE_FLAG_GET_CLAIM) == 0U);
+}
+
+/**
+ * @brief Refill the pipe buffer from the waiting writers
+ *
+ * @return Number of bytes written to the pipe buffer
+ */
+static size_t pipe_buffer_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc  pipe_desc[2];
+	sys_dlist_t        src_list;
+	sys_dlist_t        pipe_list;
+
+	if (!pipe_buffer_writable(pipe)) {
+		return 0U;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	if (pipe_waiter_list_populate(&src_list, &pipe->wait_q.writers,
+				      pipe->size - pipe->bytes_used) == 0U) {
+		return 0U;
+	}
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	return pipe_write(pipe, &src_list, &pipe_list, reschedule);
+}
+
+/**
+ * @brief Drain the pipe buffer into the waiting readers
+ *
+ * @return Number of bytes read from the pipe buffer
+ */
+static size_t pipe_buffer_drain(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc  pipe_desc[2];
+	sys_dlist_t        pipe_list;
+	sys_dlist_t        dest_list;
+
+	if (!pipe_buffer_readable(pipe)) {
+		return 0U;
+	}
+
+	sys_dlist_init(&pipe_list);
+	sys_dlist_init(&dest_list);
+
+	if (pipe_waiter_list_populate(&dest_list, &pipe->wait_q.readers,
+				      pipe->bytes_used) == 0U) {
+		return 0U;
+	}
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->read_index,
+					 pipe->write_index);
+
+	return pipe_write(pipe, &pipe_list, &dest_list, reschedule);
+}
+
+/**
+ * @brief Move data between the pipe buffer and the waiting threads
+ *
+ * Used once the pipe buffer was written or read to without going through
+ * the waiting threads, or when it becomes usable again after being claimed.
+ */
+static void pipe_buffer_update(struct k_pipe *pipe, bool *reschedule)
+{
+	size_t  bytes_moved;
+
+	do {
+		bytes_moved = pipe_buffer_drain(pipe, reschedule);
+		bytes_moved += pipe_buffer_refill(pipe, reschedule);
+	} while (bytes_moved != 0U);
+}
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 		      size_t bytes_to_write, size_t *bytes_written,
 		      size_t min_xfer, k_timeout_t timeout)
@@ -386,7 +559,7 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 	struct _pipe_desc *src_desc;
 	sys_dlist_t        dest_list;
 	sys_dlist_t        src_list;
-	size_t             bytes_can_write;
+	size_t             bytes_can_write = 0U;
 	bool               reschedule_needed = false;
 
 	__ASSERT(((arch_is_in_isr() == false) ||
@@ -407,15 +580,18 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	/*
-	 * First, write to any waiting readers, if any exist.
+	 * First, write to any waiting readers, if any exist and no buffered
+	 * data claimed for reading would be overtaken.
 	 * Second, write to the pipe buffer, if it exists.
 	 */
 
-	bytes_can_write = pipe_waiter_list_populate(&dest_list,
-						    &pipe->wait_q.readers,
-						    bytes_to_write);
+	if (pipe_waiters_xferable(pipe)) {
+		bytes_can_write = pipe_waiter_list_populate(&dest_list,
+							    &pipe->wait_q.readers,
+							    bytes_to_write);
+	}
 
-	if (pipe->bytes_used != pipe->size) {
+	if (pipe_buffer_writable(pipe)) {
 		bytes_can_write += pipe_buffer_list_populate(&dest_list,
 							     pipe_desc,
 							     pipe->buffer,
@@ -537,9 +713,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	struct _pipe_desc   pipe_desc[2];
 	struct _pipe_desc   isr_desc;
 	struct _pipe_desc  *dest_desc;
-	struct _pipe_desc  *src_desc;
-	size_t         num_bytes_read = 0U;
-	size_t         bytes_copied;
+	size_t         num_bytes_read;
 	size_t         bytes_can_read = 0U;
 	bool           reschedule_needed = false;
 
@@ -552,7 +726,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	sys_dlist_init(&src_list);
 
-	if (pipe->bytes_used != 0) {
+	if (pipe_buffer_readable(pipe)) {
 		bytes_can_read = pipe_buffer_list_populate(&src_list,
 							   pipe_desc,
 							   pipe->buffer,
@@ -561,9 +735,11 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 							   pipe->write_index);
 	}
 
-	bytes_can_read += pipe_waiter_list_populate(&src_list,
-						    &pipe->wait_q.writers,
-						    bytes_to_read);
+	if (pipe_waiters_xferable(pipe)) {
+		bytes_can_read += pipe_waiter_list_populate(&src_list,
+							    &pipe->wait_q.writers,
+							    bytes_to_read);
+	}
 
 	if ((bytes_can_read < min_xfer) &&
 	    (K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
@@ -587,67 +763,15 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	dest_desc->bytes_to_xfer = bytes_to_read;
 	dest_desc->thread = _current;
 
-	src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
-	while (src_desc != NULL) {
-		bytes_copied = pipe_xfer(dest_desc->buffer,
-					  dest_desc->bytes_to_xfer,
-					  src_desc->buffer,
-					  src_desc->bytes_to_xfer);
-
-		num_bytes_read += bytes_copied;
-
-		src_desc->buffer += bytes_copied;
-		src_desc->bytes_to_xfer -= bytes_copied;
+	num_bytes_read = pipe_read(pipe, &src_list, dest_desc,
+				   &reschedule_needed);
 
-		if (dest_desc->buffer != NULL) {
-			dest_desc->buffer += bytes_copied;
-		}
-		dest_desc->bytes_to_xfer -= bytes_copied;
-
-		if (src_desc->thread == NULL) {
-
-			/* Reading from the pipe buffer. Update details. */
-
-			pipe->bytes_used -= bytes_copied;
-			pipe->read_index += bytes_copied;
-			if (pipe->read_index >= pipe->size) {
-				pipe->read_index -= pipe->size;
-			}
-		} else if (src_desc->bytes_to_xfer == 0U) {
-
-			/* The thread's write request has been satisfied. */
-
-			z_unpend_thread(src_desc->thread);
-			z_ready_thread(src_desc->thread);
-
-			reschedule_needed = true;
-		}
-		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
-	}
-
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
+	/*
+	 * If the pipe is not full and there are any waiting writers,
+	 * refill the pipe.
+	 */
 
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	(void) pipe_buffer_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -736,6 +860,279 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <zephyr/syscalls/k_pipe_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_put_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer)
+{
+	struct _pipe_desc  pipe_desc[2];
+	struct _pipe_desc  src_desc;
+	sys_dlist_t        dest_list;
+	sys_dlist_t        src_list;
+	size_t             bytes_to_write = 0U;
+	size_t             bytes_can_write = 0U;
+	bool               reschedule_needed = false;
+
+	for (size_t i = 0U; i < iovcnt; i++) {
+		bytes_to_write += iov[i].len;
+	}
+
+	CHECKIF((min_xfer > bytes_to_write) || (bytes_written == NULL)) {
+		return -EINVAL;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/*
+	 * As with k_pipe_put(), write to any waiting readers first, and then
+	 * to the pipe buffer, one I/O vector element after the other.
+	 */
+
+	if (pipe_waiters_xferable(pipe)) {
+		bytes_can_write = pipe_waiter_list_populate(&dest_list,
+							    &pipe->wait_q.readers,
+							    bytes_to_write);
+	}
+
+	if (pipe_buffer_writable(pipe)) {
+		bytes_can_write += pipe_buffer_list_populate(&dest_list,
+							     pipe_desc,
+							     pipe->buffer,
+							     pipe->size,
+							     pipe->write_index,
+							     pipe->read_index);
+	}
+
+	if (bytes_can_write < min_xfer) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0U;
+
+		return -EIO;
+	}
+
+	*bytes_written = 0U;
+
+	for (size_t i = 0U; i < iovcnt; i++) {
+		src_desc.buffer        = (unsigned char *)iov[i].data;
+		src_desc.bytes_to_xfer = iov[i].len;
+		src_desc.thread        = _current;
+		sys_dlist_append(&src_list, &src_desc.node);
+
+		*bytes_written += pipe_write(pipe, &src_list, &dest_list,
+					     &reschedule_needed);
+
+		if (src_desc.bytes_to_xfer != 0U) {
+			break;
+		}
+	}
+
+	if ((pipe->bytes_used != 0U) && (*bytes_written != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer)
+{
+	struct _pipe_desc  pipe_desc[2];
+	struct _pipe_desc  dest_desc;
+	sys_dlist_t        src_list;
+	size_t             bytes_to_read = 0U;
+	size_t             bytes_can_read = 0U;
+	bool               reschedule_needed = false;
+
+	for (size_t i = 0U; i < iovcnt; i++) {
+		bytes_to_read += iov[i].len;
+	}
+
+	CHECKIF((min_xfer > bytes_to_read) || (bytes_read == NULL)) {
+		return -EINVAL;
+	}
+
+	sys_dlist_init(&src_list);
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/*
+	 * As with k_pipe_get(), read from the pipe buffer first, and then
+	 * from any waiting writers, one I/O vector element after the other.
+	 */
+
+	if (pipe_buffer_readable(pipe)) {
+		bytes_can_read = pipe_buffer_list_populate(&src_list,
+							   pipe_desc,
+							   pipe->buffer,
+							   pipe->size,
+							   pipe->read_index,
+							   pipe->write_index);
+	}
+
+	if (pipe_waiters_xferable(pipe)) {
+		bytes_can_read += pipe_waiter_list_populate(&src_list,
+							    &pipe->wait_q.writers,
+							    bytes_to_read);
+	}
+
+	if (bytes_can_read < min_xfer) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0U;
+
+		return -EIO;
+	}
+
+	*bytes_read = 0U;
+
+	for (size_t i = 0U; i < iovcnt; i++) {
+		dest_desc.buffer        = iov[i].data;
+		dest_desc.bytes_to_xfer = iov[i].len;
+		dest_desc.thread        = _current;
+
+		*bytes_read += pipe_read(pipe, &src_list, &dest_desc,
+					 &reschedule_needed);
+
+		if (dest_desc.bytes_to_xfer != 0U) {
+			break;
+		}
+	}
+
+	(void) pipe_buffer_refill(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	size_t  claimed = 0U;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (pipe_buffer_writable(pipe)) {
+		claimed = MIN(size, MIN(pipe->size - pipe->write_index,
+					pipe->size - pipe->bytes_used));
+	}
+
+	if (claimed != 0U) {
+		pipe->flags |= K_PIPE_FLAG_PUT_CLAIM;
+		*data = &pipe->buffer[pipe->write_index];
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	bool  reschedule_needed = false;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/* The contiguous free space can only have grown since the claim */
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) == 0U) ||
+		(size > MIN(pipe->size - pipe->write_index,
+			    pipe->size - pipe->bytes_used))) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIM;
+
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	pipe_buffer_update(pipe, &reschedule_needed);
+
+	if ((pipe->bytes_used != 0U) && (size != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	size_t  claimed = 0U;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (pipe_buffer_readable(pipe)) {
+		claimed = MIN(size, MIN(pipe->size - pipe->read_index,
+					pipe->bytes_used));
+	}
+
+	if (claimed != 0U) {
+		pipe->flags |= K_PIPE_FLAG_GET_CLAIM;
+		*data = &pipe->buffer[pipe->read_index];
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	bool  reschedule_needed = false;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/* The contiguous used space can only have grown since the claim */
+
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_GET_CLAIM) == 0U) ||
+		(size > MIN(pipe->size - pipe->read_index,
+			    pipe->bytes_used))) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIM;
+
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	pipe_buffer_update(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -152,6 +152,10 @@ static inline void register_event(struct k_poll_event *event,
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+#ifdef CONFIG_MSGQ_LOCKLESS
+		__ASSERT((event->msgq->flags & K_MSGQ_FLAG_LOCKLESS) == 0U,
+			 "lock-free message queues cannot be polled\n");
+#endif /* CONFIG_MSGQ_LOCKLESS */
 		add_event(&event->msgq->poll_events, event, poller);
 		break;
 #ifdef CONFIG_PIPES
@@ -467,11 +471,38 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
+	struct k_thread *pollers = NULL;
+	struct k_thread *thread;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(events);
-	if (poll_event != NULL) {
-		(void) signal_poll_event(poll_event, state);
+	/*
+	 * Signal all the events registered on the object. The threads
+	 * blocked in k_poll() are linked through their swap_data and woken
+	 * up in a single pass of the scheduler. Their mode is cleared so
+	 * that the other events they registered do not link them twice.
+	 */
+	while ((poll_event = (struct k_poll_event *)sys_dlist_get(events)) != NULL) {
+		struct z_poller *poller = poll_event->poller;
+
+		if ((poller == NULL) || (poller->mode != MODE_POLL)) {
+			(void)signal_poll_event(poll_event, state);
+			continue;
+		}
+
+		thread = poller_thread(poller);
+		if (z_is_thread_pending(thread)) {
+			thread->base.swap_data = pollers;
+			pollers = thread;
+		}
+
+		poller->mode = MODE_NONE;
+		poller->is_polling = false;
+		set_event_ready(poll_event, state);
+	}
+
+	if (pollers != NULL) {
+		(void)z_sched_wake_list(pollers,
+			state == K_POLL_STATE_CANCELLED ? -EINTR : 0);
 	}
 
 	k_spin_unlock(&lock, key);
@@ -617,16 +617,6 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
 		bool killed = (thread->base.thread_state &
 				(_THREAD_DEAD | _THREAD_ABORTING));
 
-#ifdef CONFIG_EVENTS
-		bool do_nothing = thread->no_wake_on_timeout && is_timeout;
-
-		thread->no_wake_on_timeout = false;
-
-		if (do_nothing) {
-			continue;
-		}
-#endif /* CONFIG_EVENTS */
-
 		if (!killed) {
 			/* The thread is not being killed */
 			if (thread->base.pended_on != NULL) {
@@ -952,18 +942,52 @@ void *z_get_next_switch_handle(void *interrupted)
 }
 #endif /* CONFIG_USE_SWITCH */
 
+/* Unpend a thread as part of a batch wakeup and put it on the run
+ * queue, accumulating the CPUs to interrupt in *ipi_mask.  The caller
+ * must hold _sched_spinlock and call wake_batch_done() afterwards.
+ */
+static void wake_batch_add(struct k_thread *thread, atomic_val_t *ipi_mask)
+{
+	unpend_thread_no_timeout(thread);
+	(void)z_abort_thread_timeout(thread);
+
+	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
+
+		queue_thread(thread);
+#ifdef CONFIG_SMP
+		*ipi_mask |= ipi_mask_create(thread);
+#endif /* CONFIG_SMP */
+	}
+}
+
+static void wake_batch_done(int woken, atomic_val_t ipi_mask)
+{
+	ARG_UNUSED(ipi_mask);
+
+	if (woken != 0) {
+		update_cache(0);
+		flag_ipi(ipi_mask);
+	}
+}
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
-	int need_sched = 0;
-	struct k_thread *thread;
+	int woken = 0;
 
-	for (thread = z_waitq_head(wait_q); thread != NULL; thread = z_waitq_head(wait_q)) {
-		z_unpend_thread(thread);
-		z_ready_thread(thread);
-		need_sched = 1;
+	K_SPINLOCK(&_sched_spinlock) {
+		struct k_thread *thread;
+		atomic_val_t ipi_mask = 0;
+
+		while ((thread = _priq_wait_best(&wait_q->waitq)) != NULL) {
+			wake_batch_add(thread, &ipi_mask);
+			woken++;
+		}
+
+		wake_batch_done(woken, ipi_mask);
 	}
 
-	return need_sched;
+	return (woken != 0) ? 1 : 0;
 }
 
 void init_ready_q(struct _ready_q *ready_q)
@@ -975,7 +999,7 @@ void init_ready_q(struct _ready_q *ready_q)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -1527,6 +1551,87 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+int z_sched_wake_batch(_wait_q_t *wait_q, int swap_retval, void *swap_data,
+		       bool (*filter)(struct k_thread *thread, void *data),
+		       void *data)
+{
+	int woken = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		struct k_thread *thread, *head = NULL, *tail = NULL;
+		atomic_val_t ipi_mask = 0;
+
+		if (filter == NULL) {
+			while ((thread = _priq_wait_best(&wait_q->waitq)) != NULL) {
+				z_thread_return_value_set_with_data(thread,
+								    swap_retval,
+								    swap_data);
+				wake_batch_add(thread, &ipi_mask);
+				woken++;
+			}
+		} else {
+			/* Unpending threads while walking a red/black
+			 * tree wait queue would break the walk, so first
+			 * chain the selected threads in wait queue order
+			 * through their swap_data, which gets overwritten
+			 * on wakeup anyway.
+			 */
+			_WAIT_Q_FOR_EACH(wait_q, thread) {
+				if (filter(thread, data)) {
+					thread->base.swap_data = NULL;
+					if (tail == NULL) {
+						head = thread;
+					} else {
+						tail->base.swap_data = thread;
+					}
+					tail = thread;
+				}
+			}
+
+			for (thread = head; thread != NULL; thread = head) {
+				head = thread->base.swap_data;
+				z_thread_return_value_set_with_data(thread,
+								    swap_retval,
+								    swap_data);
+				wake_batch_add(thread, &ipi_mask);
+				woken++;
+			}
+		}
+
+		wake_batch_done(woken, ipi_mask);
+	}
+
+	return woken;
+}
+
+int z_sched_wake_list(struct k_thread *head, int swap_retval)
+{
+	int woken = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		struct k_thread *thread;
+		atomic_val_t ipi_mask = 0;
+
+		for (thread = head; thread != NULL; thread = head) {
+			head = thread->base.swap_data;
+
+			if (!z_is_thread_pending(thread)) {
+				continue;
+			}
+
+			z_thread_return_value_set_with_data(thread,
+							    swap_retval,
+							    NULL);
+			wake_batch_add(thread, &ipi_mask);
+			woken++;
+		}
+
+		wake_batch_done(woken, ipi_mask);
+	}
+
+	return woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
@@ -165,17 +165,9 @@ out:
 
 void z_impl_k_sem_reset(struct k_sem *sem)
 {
-	struct k_thread *thread;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	while (true) {
-		thread = z_unpend_first_thread(&sem->wait_q);
-		if (thread == NULL) {
-			break;
-		}
-		arch_thread_return_value_set(thread, -EAGAIN);
-		z_ready_thread(thread);
-	}
+	(void)z_sched_wake_all(&sem->wait_q, -EAGAIN, NULL);
 	sem->count = 0;
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
@@ -11,11 +11,10 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +35,217 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+/*
+ * Timeout queue backends.  Each provides, with timeout_lock held:
+ *
+ * first()           - the earliest pending timeout, or NULL
+ * insert_timeout()  - queue a timeout whose dticks field holds the
+ *                     number of ticks from curr_tick until it expires
+ * remove_timeout()  - dequeue a pending timeout
+ * timeout_rem()     - ticks from curr_tick until a pending timeout expires
+ * advance()         - account for curr_tick having moved forward
+ *
+ * Timeouts expiring on the same tick must come out of first() in the
+ * order they were inserted.
+ */
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.  A pending timeout stores its absolute
+ * expiry (in wheel_tick units) in dticks, and lives on level N when
+ * its expiry and wheel_tick first differ in the Nth group of
+ * WHEEL_BITS bits, in the slot selected by that group of the expiry.
+ * Expiries never precede wheel_tick, so every timeout on a level
+ * expires after all timeouts on the levels below it, and the slot
+ * index order within a level is expiry order.  Timeouts beyond the
+ * top level are kept on an unsorted overflow list.
+ *
+ * As wheel_tick moves into a new slot on some level, the timeouts in
+ * that slot are redistributed ("cascaded") to the finer levels.
+ * Slot lists are only initialized while their bit in wheel_map is
+ * set, which spares us a boot-time init of the whole wheel.
+ */
+#define WHEEL_BITS   6
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+
+/* Tracks curr_tick, but is unaffected by sys_clock_tick_set() */
+static uint64_t wheel_tick;
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_map[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Cached result of first(), NULL when it must be recomputed */
+static struct _timeout *wheel_first;
+
+static int wheel_level(uint64_t expiry)
+{
+	uint64_t diff = expiry ^ wheel_tick;
+	int level;
+
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		if ((diff >> (WHEEL_BITS * (level + 1))) == 0U) {
+			break;
+		}
+	}
+
+	return level;
+}
+
+static inline int wheel_slot(uint64_t expiry, int level)
+{
+	return (expiry >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	int level = wheel_level(to->dticks);
+
+	if (level == WHEEL_LEVELS) {
+		sys_dlist_append(&wheel_overflow, &to->node);
+	} else {
+		int slot = wheel_slot(to->dticks, level);
+
+		if ((wheel_map[level] & BIT64(slot)) == 0U) {
+			sys_dlist_init(&wheel[level][slot]);
+			wheel_map[level] |= BIT64(slot);
+		}
+		sys_dlist_append(&wheel[level][slot], &to->node);
+	}
+}
+
+static struct _timeout *earliest(sys_dlist_t *list)
+{
+	struct _timeout *t, *ret = NULL;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if ((ret == NULL) || (t->dticks < ret->dticks)) {
+			ret = t;
+		}
+	}
+
+	return ret;
+}
+
+static struct _timeout *first(void)
+{
+	if (wheel_first != NULL) {
+		return wheel_first;
+	}
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		if (wheel_map[level] != 0U) {
+			sys_dlist_t *list =
+				&wheel[level][u64_count_trailing_zeros(wheel_map[level])];
+
+			/* Everything in a level 0 slot expires on the same tick */
+			wheel_first = (level == 0)
+				? CONTAINER_OF(sys_dlist_peek_head(list), struct _timeout, node)
+				: earliest(list);
+			return wheel_first;
+		}
+	}
+
+	wheel_first = earliest(&wheel_overflow);
+	return wheel_first;
+}
+
+static void insert_timeout(struct _timeout *to)
+{
+	to->dticks += wheel_tick;
+	wheel_insert(to);
+
+	if ((wheel_first != NULL) && (to->dticks < wheel_first->dticks)) {
+		wheel_first = to;
+	}
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	int level = wheel_level(t->dticks);
+
+	sys_dlist_remove(&t->node);
+
+	if (level < WHEEL_LEVELS) {
+		int slot = wheel_slot(t->dticks, level);
+
+		if (sys_dlist_is_empty(&wheel[level][slot])) {
+			wheel_map[level] &= ~BIT64(slot);
+		}
+	}
+
+	if (t == wheel_first) {
+		wheel_first = NULL;
+	}
+}
+
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return timeout->dticks - wheel_tick;
+}
+
+static void cascade(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* No timeout may expire strictly between the old and new wheel_tick */
+static void advance(int32_t ticks)
+{
+	uint64_t prev = wheel_tick;
+
+	wheel_tick += ticks;
+
+	if ((prev >> WHEEL_BITS) == (wheel_tick >> WHEEL_BITS)) {
+		return;
+	}
+
+	if ((prev >> (WHEEL_BITS * WHEEL_LEVELS)) !=
+	    (wheel_tick >> (WHEEL_BITS * WHEEL_LEVELS))) {
+		sys_dlist_t list = SYS_DLIST_STATIC_INIT(&list);
+		sys_dnode_t *node;
+
+		/* Entries may land back on the overflow list, so detach
+		 * them all first.
+		 */
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&list, node);
+		}
+		cascade(&list);
+	}
+
+	/* Top down, so entries cascaded into the current slot of a
+	 * lower level get cascaded again from there.
+	 */
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		if ((prev >> (WHEEL_BITS * level)) ==
+		    (wheel_tick >> (WHEEL_BITS * level))) {
+			continue;
+		}
+
+		int slot = wheel_slot(wheel_tick, level);
+
+		if ((wheel_map[level] & BIT64(slot)) != 0U) {
+			wheel_map[level] &= ~BIT64(slot);
+			cascade(&wheel[level][slot]);
+		}
+	}
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
+/* Ticks from curr_tick until the last timeout expires, i.e. the sum of
+ * the dticks of all timeouts in the list
+ */
+static k_ticks_t timeout_list_end;
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -43,6 +253,13 @@ static struct _timeout *first(void)
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
+static struct _timeout *last(void)
+{
+	sys_dnode_t *t = sys_dlist_peek_tail(&timeout_list);
+
+	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
 static struct _timeout *next(struct _timeout *t)
 {
 	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
@@ -50,15 +267,98 @@ static struct _timeout *next(struct _timeout *t)
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+static struct _timeout *prev(struct _timeout *t)
+{
+	sys_dnode_t *n = sys_dlist_peek_prev(&timeout_list, &t->node);
+
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Periodic timers, kicked watchdogs and the like mostly add timeouts at
+ * or near the end of the list, so that is checked first, and the list
+ * is walked from whichever end is closer in time.
+ */
+static void insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	if (to->dticks >= timeout_list_end) {
+		to->dticks -= timeout_list_end;
+		timeout_list_end += to->dticks;
+		sys_dlist_append(&timeout_list, &to->node);
+		return;
+	}
+
+	if (to->dticks >= timeout_list_end / 2) {
+		k_ticks_t ticks = timeout_list_end;
+
+		/* Find the first timeout expiring after the new one, whose
+		 * predecessor (if any) doesn't.
+		 */
+		for (t = last(); ; t = prev(t)) {
+			ticks -= t->dticks;
+			if ((ticks <= to->dticks) || (prev(t) == NULL)) {
+				break;
+			}
+		}
+
+		to->dticks -= ticks;
+		t->dticks -= to->dticks;
+		sys_dlist_insert(&t->node, &to->node);
+		return;
+	}
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
 		next(t)->dticks += t->dticks;
+	} else {
+		timeout_list_end -= t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static void advance(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+		timeout_list_end -= ticks;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -87,15 +387,36 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_rem(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_rem(to) - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+static void add_timeout_locked(struct _timeout *to, _timeout_func_t fn,
+			       k_timeout_t timeout)
+{
+	to->fn = fn;
+
+	if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
+	    (Z_TICK_ABS(timeout.ticks) >= 0)) {
+		k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+
+		to->dticks = MAX(1, ticks);
+	} else {
+		to->dticks = timeout.ticks + 1 + elapsed();
+	}
+
+	insert_timeout(to);
+
+	if (to == first() && announce_remaining == 0) {
+		sys_clock_set_timeout(next_timeout(), false);
+	}
+}
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
@@ -108,66 +429,47 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 #endif /* CONFIG_KERNEL_COHERENCE */
 
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
-	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-
-		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
-		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
-		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first() && announce_remaining == 0) {
-			sys_clock_set_timeout(next_timeout(), false);
-		}
+		add_timeout_locked(to, fn, timeout);
 	}
 }
 
-int z_abort_timeout(struct _timeout *to)
+int z_update_timeout(struct _timeout *to, _timeout_func_t fn,
+		     k_timeout_t timeout)
 {
 	int ret = -EINVAL;
 
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
 			remove_timeout(to);
 			ret = 0;
 		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			add_timeout_locked(to, fn, timeout);
+		}
 	}
 
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+int z_abort_timeout(struct _timeout *to)
 {
-	k_ticks_t ticks = 0;
+	int ret = -EINVAL;
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
+	K_SPINLOCK(&timeout_lock) {
+		if (sys_dnode_is_linked(&to->node)) {
+			remove_timeout(to);
+			ret = 0;
 		}
 	}
 
-	return ticks;
+	return ret;
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -228,12 +530,12 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t;
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_rem(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_rem(t);
 
 		curr_tick += dt;
-		t->dticks = 0;
+		advance(dt);
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -242,11 +544,8 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
 	curr_tick += announce_remaining;
+	advance(announce_remaining);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(), false);
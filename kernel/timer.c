@@ -170,12 +170,12 @@ void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
 		duration.ticks = MAX(duration.ticks - 1, 0);
 	}
 
-	(void)z_abort_timeout(&timer->timeout);
 	timer->period = period;
 	timer->status = 0U;
 
-	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-		     duration);
+	/* Restarting a running timer moves its timeout in place */
+	(void)z_update_timeout(&timer->timeout, z_timer_expiration_handler,
+			       duration);
 
 	k_spin_unlock(&lock, key);
 }
@@ -69,12 +69,10 @@ void z_reset_time_slice(struct k_thread *thread)
 {
 	int cpu = _current_cpu->id;
 
-	z_abort_timeout(&slice_timeouts[cpu]);
 	slice_expired[cpu] = false;
-	if (thread_is_sliceable(thread)) {
-		z_add_timeout(&slice_timeouts[cpu], slice_timeout,
-			      K_TICKS(slice_time(thread) - 1));
-	}
+	(void)z_update_timeout(&slice_timeouts[cpu], slice_timeout,
+			       thread_is_sliceable(thread)
+			       ? K_TICKS(slice_time(thread) - 1) : K_FOREVER);
 }
 
 void k_sched_time_slice_set(int32_t slice, int prio)
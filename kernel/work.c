@@ -1021,11 +1021,19 @@ int k_work_reschedule_for_queue(struct k_work_q *queue,
 	int ret;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	/* Remove any active scheduling. */
-	(void)unschedule_locked(dwork);
+	if (!K_TIMEOUT_EQ(delay, K_NO_WAIT) &&
+	    flag_test(&dwork->work.flags, K_WORK_DELAYED_BIT)) {
+		/* Still delayed, move the timeout to the new expiry */
+		dwork->queue = queue;
+		(void)z_update_timeout(&dwork->timeout, work_timeout, delay);
+		ret = 1;
+	} else {
+		/* Remove any active scheduling. */
+		(void)unschedule_locked(dwork);
 
-	/* Schedule the work item with the new parameters. */
-	ret = schedule_for_queue_locked(&queue, dwork, delay);
+		/* Schedule the work item with the new parameters. */
+		ret = schedule_for_queue_locked(&queue, dwork, delay);
+	}
 
 	k_spin_unlock(&lock, key);
 
@@ -160,6 +160,123 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SYS_HEAP_SLAB_MIN_SIZE),
+	     "slab size classes must be powers of two");
+
+#define SLAB_MIN_SHIFT LOG2(CONFIG_SYS_HEAP_SLAB_MIN_SIZE)
+#define SLAB_MAX_SIZE \
+	((size_t)CONFIG_SYS_HEAP_SLAB_MIN_SIZE << (CONFIG_SYS_HEAP_SLAB_CLASSES - 1))
+
+/* Size class serving a request of 1 to SLAB_MAX_SIZE bytes */
+static int slab_class(size_t bytes)
+{
+	if (bytes <= CONFIG_SYS_HEAP_SLAB_MIN_SIZE) {
+		return 0;
+	}
+
+	return 32 - __builtin_clz((uint32_t)bytes - 1U) - SLAB_MIN_SHIFT;
+}
+
+/* Size class a chunk can be cached in, or -1 if none */
+static int slab_chunk_class(struct z_heap *h, chunkid_t c)
+{
+	size_t bytes = chunksz_to_bytes(h, chunk_size(h, c));
+	int cls;
+
+	if ((bytes < CONFIG_SYS_HEAP_SLAB_MIN_SIZE) || (bytes > 2 * SLAB_MAX_SIZE)) {
+		return -1;
+	}
+
+	/* Chunk sizes are rounded up to whole units, so a chunk serving
+	 * a class is the one of the largest class fitting in it.
+	 */
+	cls = 31 - __builtin_clz((uint32_t)bytes) - SLAB_MIN_SHIFT;
+	if ((cls >= CONFIG_SYS_HEAP_SLAB_CLASSES) ||
+	    (chunk_size(h, c) != slab_chunksz(h, cls))) {
+		return -1;
+	}
+
+	return cls;
+}
+
+static void slab_push(struct z_heap *h, int cls, chunkid_t c)
+{
+	struct z_heap_slab *s = &h->slabs[cls];
+
+	CHECK(chunk_used(h, c));
+	CHECK(chunk_size(h, c) == slab_chunksz(h, cls));
+
+	set_next_free_chunk(h, c, s->next);
+	s->next = c;
+	s->count++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+}
+
+static chunkid_t slab_pop(struct z_heap *h, int cls)
+{
+	struct z_heap_slab *s = &h->slabs[cls];
+	chunkid_t c = s->next;
+
+	if (c != 0U) {
+		s->next = next_free_chunk(h, c);
+		s->count--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+	}
+
+	return c;
+}
+
+/* Caches a freed chunk, returns false if it must go back to the heap */
+static bool slab_free(struct z_heap *h, chunkid_t c)
+{
+	int cls;
+
+	if (!h->slab_enabled) {
+		return false;
+	}
+
+	cls = slab_chunk_class(h, c);
+	if ((cls < 0) || (h->slabs[cls].count >= CONFIG_SYS_HEAP_SLAB_CACHE_MAX)) {
+		return false;
+	}
+
+	slab_push(h, cls, c);
+	return true;
+}
+
+/* Returns all cached chunks to the heap, returns true if there were any */
+static bool slab_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+		chunkid_t c;
+
+		while ((c = slab_pop(h, i)) != 0U) {
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+
+void sys_heap_slab_enable(struct sys_heap *heap)
+{
+	heap->heap->slab_enabled = true;
+}
+
+#endif /* CONFIG_SYS_HEAP_SLAB */
+
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
@@ -184,7 +301,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +310,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (slab_free(h, c)) {
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -260,6 +383,129 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Carves CONFIG_SYS_HEAP_SLAB_REFILL adjacent chunks of class @a cls
+ * out of a single free chunk, caches all but the first one and
+ * returns that.  Returns 0 if there is no free chunk large enough.
+ */
+static chunkid_t slab_refill(struct z_heap *h, int cls)
+{
+	chunksz_t sz = slab_chunksz(h, cls);
+	chunksz_t total = sz * CONFIG_SYS_HEAP_SLAB_REFILL;
+	chunkid_t c;
+
+	if ((CONFIG_SYS_HEAP_SLAB_REFILL < 2) || (total >= h->end_chunk)) {
+		return 0;
+	}
+
+	c = alloc_chunk(h, total);
+	if (c == 0U) {
+		return 0;
+	}
+
+	if (chunk_size(h, c) > total) {
+		split_chunks(h, c, c + total);
+		free_list_add(h, c + total);
+	}
+
+	for (int i = CONFIG_SYS_HEAP_SLAB_REFILL - 1; i > 0; i--) {
+		chunkid_t rc = c + i * sz;
+
+		split_chunks(h, c, rc);
+		set_chunk_used(h, rc, true);
+		slab_push(h, cls, rc);
+	}
+
+	return c;
+}
+
+static chunkid_t slab_alloc(struct z_heap *h, int cls)
+{
+	chunkid_t c = slab_pop(h, cls);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	if (c != 0U) {
+		h->slabs[cls].hits++;
+	} else {
+		h->slabs[cls].misses++;
+	}
+#endif
+
+	if (c == 0U) {
+		c = slab_refill(h, cls);
+	}
+
+	return c;
+}
+#endif /* CONFIG_SYS_HEAP_SLAB */
+
+/* Like alloc_chunk(), but gives any cached slab chunks back to the
+ * heap and retries before failing.
+ */
+static chunkid_t alloc_chunk_reclaim(struct z_heap *h, chunksz_t sz)
+{
+	chunkid_t c = alloc_chunk(h, sz);
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if ((c == 0U) && slab_flush(h)) {
+		c = alloc_chunk(h, sz);
+	}
+#endif
+
+	return c;
+}
+
+/* Returns where an allocation of @a bytes aligned to @a align, then
+ * rewound by @a rew bytes, would start in chunk @a c, or NULL if it
+ * doesn't fit in that chunk.
+ */
+static uint8_t *chunk_aligned_mem(struct z_heap *h, chunkid_t c,
+				  size_t align, size_t rew, size_t bytes)
+{
+	uint8_t *mem = chunk_mem(h, c);
+	uint8_t *end = (uint8_t *)&chunk_buf(h)[right_chunk(h, c)];
+
+	mem = (uint8_t *) ROUND_UP(mem + rew, align) - rew;
+
+	return (mem + bytes <= end) ? mem : NULL;
+}
+
+/* Like alloc_chunk(), but for aligned allocations.  Free chunks from
+ * the bucket of the unpadded size up to the bucket of the padded size
+ * may already be suitably aligned to hold the allocation, so a bounded
+ * number of them is checked in each of these buckets first.  Only then
+ * is a chunk large enough for any alignment taken.  This avoids
+ * splitting large chunks, and the fragmentation that goes with it, when
+ * blocks with the same alignment are freed and allocated repeatedly.
+ */
+static chunkid_t alloc_chunk_aligned(struct z_heap *h, chunksz_t padded_sz,
+				     size_t align, size_t rew, size_t bytes)
+{
+	int bi = bucket_idx(h, bytes_to_chunksz(h, bytes));
+	int bmax = bucket_idx(h, padded_sz);
+	uint32_t bmask = h->avail_buckets & ~BIT_MASK(bi) &
+			 (BIT_MASK(bmax) | BIT(bmax));
+
+	while (bmask != 0U) {
+		int b = __builtin_ctz(bmask);
+		chunkid_t first = h->buckets[b].next;
+		chunkid_t c = first;
+		int i = CONFIG_SYS_HEAP_ALLOC_LOOPS;
+
+		do {
+			if (chunk_aligned_mem(h, c, align, rew, bytes) != NULL) {
+				free_list_remove_bidx(h, c, b);
+				return c;
+			}
+			c = next_free_chunk(h, c);
+		} while (--i && c != first);
+
+		bmask &= ~BIT(b);
+	}
+
+	return alloc_chunk(h, padded_sz);
+}
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -270,7 +516,20 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = 0;
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (h->slab_enabled && (bytes <= SLAB_MAX_SIZE)) {
+		int cls = slab_class(bytes);
+
+		chunk_sz = slab_chunksz(h, cls);
+		c = slab_alloc(h, cls);
+	}
+#endif
+
+	if (c == 0U) {
+		c = alloc_chunk_reclaim(h, chunk_sz);
+	}
 	if (c == 0U) {
 		return NULL;
 	}
@@ -328,26 +587,31 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	}
 
 	/*
-	 * Find a free block that is guaranteed to fit.
-	 * We over-allocate to account for alignment and then free
-	 * the extra allocations afterwards.
+	 * Find a free block that fits, preferably one that is already
+	 * suitably aligned.  Otherwise we over-allocate to account for
+	 * alignment and then free the extra allocations afterwards.
 	 */
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
-	chunkid_t c0 = alloc_chunk(h, padded_sz);
+	chunkid_t c0 = alloc_chunk_aligned(h, padded_sz, align, rew, bytes);
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if ((c0 == 0U) && slab_flush(h)) {
+		c0 = alloc_chunk_aligned(h, padded_sz, align, rew, bytes);
+	}
+#endif
 
 	if (c0 == 0) {
 		return NULL;
 	}
-	uint8_t *mem = chunk_mem(h, c0);
 
 	/* Align allocated memory */
-	mem = (uint8_t *) ROUND_UP(mem + rew, align) - rew;
+	uint8_t *mem = chunk_aligned_mem(h, c0, align, rew, bytes);
 	chunk_unit_t *end = (chunk_unit_t *) ROUND_UP(mem + bytes, CHUNK_UNIT);
 
 	/* Get corresponding chunks */
 	chunkid_t c = mem_to_chunkid(h, mem);
 	chunkid_t c_end = end - chunk_buf(h);
-	CHECK(c >= c0 && c  < c_end && c_end <= c0 + padded_sz);
+	CHECK(c >= c0 && c  < c_end && c_end <= right_chunk(h, c0));
 
 	/* Split and free unused prefix */
 	if (c > c0) {
@@ -376,6 +640,88 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	return mem;
 }
 
+/* Resizes an allocation by moving it within the span formed by its
+ * chunk and its free neighbors, for when it can't simply be shrunk or
+ * extended in place because it isn't aligned as requested or needs to
+ * grow past its right neighbor.  The left neighbor is only used when
+ * the right one doesn't provide enough room.  Returns NULL if the
+ * allocation doesn't fit in that span.
+ */
+static void *realloc_move(struct sys_heap *heap, void *ptr,
+			  size_t align, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, ptr);
+	chunkid_t lc = left_chunk(h, c);
+	chunkid_t rc = right_chunk(h, c);
+	chunkid_t start = c;
+	chunkid_t end = chunk_used(h, rc) ? rc : right_chunk(h, rc);
+	uint8_t *end_mem = (uint8_t *)&chunk_buf(h)[end];
+	size_t prev_bytes = chunksz_to_bytes(h, chunk_size(h, c));
+	size_t align_gap = (uint8_t *)ptr - (uint8_t *)chunk_mem(h, c);
+	uint8_t *mem;
+
+	align = MAX(align, 1);
+	mem = (uint8_t *) ROUND_UP(chunk_mem(h, start), align);
+	if (mem + bytes > end_mem) {
+		if (chunk_used(h, lc)) {
+			return NULL;
+		}
+		start = lc;
+		mem = (uint8_t *) ROUND_UP(chunk_mem(h, start), align);
+		if (mem + bytes > end_mem) {
+			return NULL;
+		}
+	}
+
+	chunkid_t nc = mem_to_chunkid(h, mem);
+	chunkid_t nc_end = (chunk_unit_t *) ROUND_UP(mem + bytes, CHUNK_UNIT) -
+			   chunk_buf(h);
+
+	/* The free neighbors' list linkage is about to be overwritten */
+	if (end != rc) {
+		free_list_remove(h, rc);
+	}
+	if (start != c) {
+		free_list_remove(h, lc);
+	}
+
+	memmove(mem, ptr, MIN(prev_bytes - align_gap, bytes));
+
+	/* Turn the span into a single chunk, then split off and free
+	 * whatever lies before and after the moved allocation.
+	 */
+	set_chunk_size(h, start, end - start);
+	set_left_chunk_size(h, end, end - start);
+
+	if (nc > start) {
+		split_chunks(h, start, nc);
+		set_chunk_used(h, nc, true);
+		free_chunk(h, start);
+	}
+
+	if (nc_end < end) {
+		split_chunks(h, nc, nc_end);
+		free_list_add(h, nc_end);
+	}
+
+	set_chunk_used(h, nc, true);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->allocated_bytes -= prev_bytes;
+	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, nc)));
+#endif
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+				   chunksz_to_bytes(h, chunk_size(h, nc)));
+	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), ptr,
+				  prev_bytes);
+#endif
+
+	return mem;
+}
+
 void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 			       size_t align, size_t bytes)
 {
@@ -464,6 +810,13 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 		;
 	}
 
+	/* Realign or grow into the free neighbors */
+	void *ptr2 = realloc_move(heap, ptr, align, bytes);
+
+	if (ptr2 != NULL) {
+		return ptr2;
+	}
+
 	/*
 	 * Fallback: allocate and copy
 	 *
@@ -471,7 +824,7 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	 * The calls to allocation and free functions generate
 	 * notification already, so there is no need to those here.
 	 */
-	void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+	ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
 
 	if (ptr2 != NULL) {
 		size_t prev_size = chunksz_to_bytes(h, chunk_size(h, c)) - align_gap;
@@ -517,6 +870,11 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+	h->slab_enabled = false;
+	memset(h->slabs, 0, sizeof(h->slabs));
+#endif
+
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
 				     nb_buckets * sizeof(struct z_heap_bucket));
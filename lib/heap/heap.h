@@ -65,6 +65,21 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Slab caches keep freed chunks of exactly one size class marked as
+ * used, singly linked through their FREE_NEXT field, so they neither
+ * merge with their neighbors nor show up in the bucket free lists.
+ */
+struct z_heap_slab {
+	chunkid_t next;
+	uint32_t count;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	uint32_t hits;
+	uint32_t misses;
+#endif
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +88,10 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SLAB
+	bool slab_enabled;
+	struct z_heap_slab slabs[CONFIG_SYS_HEAP_SLAB_CLASSES];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -262,6 +281,26 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 	return (bytes / CHUNK_UNIT) >= h->end_chunk;
 }
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+/* Chunk size of the blocks handed out by slab class @a cls */
+static inline chunksz_t slab_chunksz(struct z_heap *h, int cls)
+{
+	return bytes_to_chunksz(h, (size_t)CONFIG_SYS_HEAP_SLAB_MIN_SIZE << cls);
+}
+
+static inline size_t slab_cached_bytes(struct z_heap *h)
+{
+	size_t bytes = 0;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+		bytes += h->slabs[i].count *
+			 chunksz_to_bytes(h, slab_chunksz(h, i));
+	}
+
+	return bytes;
+}
+#endif
+
 static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
@@ -277,6 +316,14 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+	/* Cached slab chunks look used but are available memory */
+	size_t cached = slab_cached_bytes(h);
+
+	*alloc_bytes -= cached;
+	*free_bytes += cached;
+#endif
 }
 
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
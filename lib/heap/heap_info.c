@@ -43,6 +43,18 @@ static void heap_print_info(struct z_heap *h, bool dump_chunks)
 		}
 	}
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+	if (h->slab_enabled) {
+		printk("\n    slab#   block size       cached\n"
+		       "  ----------------------------------\n");
+		for (i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+			printk("%9d %12zd %12u\n", i,
+			       (size_t)CONFIG_SYS_HEAP_SLAB_MIN_SIZE << i,
+			       h->slabs[i].count);
+		}
+	}
+#endif
+
 	if (dump_chunks) {
 		printk("\nChunk dump:\n");
 		for (chunkid_t c = 0; ; c = right_chunk(h, c)) {
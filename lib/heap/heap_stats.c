@@ -32,3 +32,23 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 
 	return 0;
 }
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+int sys_heap_slab_stats_get(struct sys_heap *heap, int cls,
+			    struct sys_heap_slab_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL) ||
+	    (cls < 0) || (cls >= CONFIG_SYS_HEAP_SLAB_CLASSES)) {
+		return -EINVAL;
+	}
+
+	struct z_heap_slab *s = &heap->heap->slabs[cls];
+
+	stats->block_size = (size_t)CONFIG_SYS_HEAP_SLAB_MIN_SIZE << cls;
+	stats->cached = s->count;
+	stats->hits = s->hits;
+	stats->misses = s->misses;
+
+	return 0;
+}
+#endif
@@ -103,6 +103,27 @@ bool sys_heap_validate(struct sys_heap *heap)
 	}
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SLAB
+	/* Cached slab chunks must be used chunks of their class size,
+	 * in the expected number.
+	 */
+	for (int i = 0; i < CONFIG_SYS_HEAP_SLAB_CLASSES; i++) {
+		uint32_t n = 0;
+
+		for (c = h->slabs[i].next; c != 0; c = next_free_chunk(h, c)) {
+			if (!valid_chunk(h, c) || !chunk_used(h, c) ||
+			    (chunk_size(h, c) != slab_chunksz(h, i)) ||
+			    (++n > h->slabs[i].count)) {
+				return false;
+			}
+		}
+
+		if (n != h->slabs[i].count) {
+			return false;
+		}
+	}
+#endif
+
 	/* Check the free lists: entry count should match, empty bit
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
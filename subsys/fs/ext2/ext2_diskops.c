@@ -476,6 +476,45 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	return 0;
 }
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+void ext2_inode_readahead(struct ext2_inode *inode, uint32_t count)
+{
+	struct ext2_data *fs = inode->i_fs;
+	uint32_t offsets[MAX_OFFSETS_SIZE];
+	uint32_t last, block;
+	int lvl;
+
+	if (!(inode->flags & INODE_FETCHED_BLOCK) || inode->i_size == 0) {
+		return;
+	}
+
+	last = (inode->i_size - 1) / fs->block_size;
+
+	for (uint32_t i = inode->block_num + 1; i <= last && count > 0; i++, count--) {
+		lvl = get_level_offsets(fs, i, offsets);
+
+		/* Block numbers are known only for blocks in the fetched list. */
+		if (lvl != inode->block_lvl ||
+		    memcmp(offsets, inode->offsets, lvl * sizeof(uint32_t)) != 0) {
+			break;
+		}
+
+		if (lvl == 0) {
+			block = inode->i_block[offsets[0]];
+		} else {
+			uint32_t *list = (uint32_t *)inode->blocks[lvl - 1]->data;
+
+			block = sys_le32_to_cpu(list[offsets[lvl]]);
+		}
+
+		if (block == 0) {
+			break;
+		}
+		ext2_prefetch_block(fs, block);
+	}
+}
+#endif
+
 static bool all_zero(const uint32_t *offsets, int lvl)
 {
 	for (int i = 0; i < lvl; ++i) {
@@ -1154,7 +1193,7 @@ int ext2_free_inode(struct ext2_data *fs, uint32_t ino, bool directory)
 		LOG_DBG("block bitmap write returned: %d", rc);
 		return -EIO;
 	}
-	rc = fs->backend_ops->sync(fs);
+	rc = ext2_sync_blocks(fs);
 	if (rc < 0) {
 		return -EIO;
 	}
@@ -41,6 +41,16 @@ int ext2_fetch_inode(struct ext2_data *fs, uint32_t ino, struct ext2_inode *inod
  */
 int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block);
 
+/**
+ * @brief Read ahead blocks following the fetched block of the inode.
+ *
+ * Stops at the end of the file, at a hole and at the end of the fetched block list.
+ *
+ * @param inode Inode structure with a fetched block
+ * @param count Maximal number of blocks to read ahead
+ */
+void ext2_inode_readahead(struct ext2_inode *inode, uint32_t count);
+
 /**
  * @brief Fetch block group into buffer in fs structure.
  *
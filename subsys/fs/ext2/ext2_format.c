@@ -434,7 +434,7 @@ out:
 	ext2_drop_block(itable_block2);
 	ext2_drop_block(root_dir_blk);
 	ext2_drop_block(lost_found_dir_blk);
-	if ((ret >= 0) && (fs->backend_ops->sync(fs)) < 0) {
+	if ((ret >= 0) && (ext2_sync_blocks(fs) < 0)) {
 		ret = -EIO;
 	}
 	return ret;
@@ -22,14 +22,28 @@ LOG_MODULE_REGISTER(ext2, CONFIG_EXT2_LOG_LEVEL);
 static struct ext2_data __fs;
 static bool initialized;
 
-#define BLOCK_MEMORY_BUFFER_SIZE (CONFIG_EXT2_MAX_BLOCK_COUNT * CONFIG_EXT2_MAX_BLOCK_SIZE)
-#define BLOCK_STRUCT_BUFFER_SIZE (CONFIG_EXT2_MAX_BLOCK_COUNT * sizeof(struct ext2_block))
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+#define BLOCK_POOL_COUNT (CONFIG_EXT2_MAX_BLOCK_COUNT + CONFIG_EXT2_BLOCK_CACHE_SIZE)
+#else
+#define BLOCK_POOL_COUNT CONFIG_EXT2_MAX_BLOCK_COUNT
+#endif
+
+#define BLOCK_MEMORY_BUFFER_SIZE (BLOCK_POOL_COUNT * CONFIG_EXT2_MAX_BLOCK_SIZE)
+#define BLOCK_STRUCT_BUFFER_SIZE (BLOCK_POOL_COUNT * sizeof(struct ext2_block))
 
 /* Structures for blocks slab alocator */
 struct k_mem_slab ext2_block_memory_slab, ext2_block_struct_slab;
 char __aligned(sizeof(void *)) __ext2_block_memory_buffer[BLOCK_MEMORY_BUFFER_SIZE];
 char __aligned(sizeof(void *)) __ext2_block_struct_buffer[BLOCK_STRUCT_BUFFER_SIZE];
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+/* Assigned blocks, the most recently used first. Blocks that are not referenced stay in the
+ * list until their memory is needed for another block.
+ */
+static sys_dlist_t block_cache;
+static struct ext2_block_cache_stats block_cache_stats;
+#endif
+
 /* Initialize heap memory allocator */
 K_HEAP_DEFINE(direntry_heap, MAX_DIRENTRY_SIZE);
 K_MEM_SLAB_DEFINE(inode_struct_slab, sizeof(struct ext2_inode), MAX_INODES, sizeof(void *));
@@ -66,13 +80,83 @@ void error_behavior(struct ext2_data *fs, const char *msg)
 
 /* Block operations --------------------------------------------------------- */
 
-static struct ext2_block *get_block_struct(void)
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+static struct ext2_block *block_cache_find(uint32_t num)
+{
+	struct ext2_block *b;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&block_cache, b, node) {
+		if (b->num == num) {
+			return b;
+		}
+	}
+	return NULL;
+}
+
+static void block_cache_insert(struct ext2_block *b)
+{
+	b->flags |= EXT2_BLOCK_CACHED;
+	sys_dlist_prepend(&block_cache, &b->node);
+}
+
+static void block_cache_remove(struct ext2_block *b)
+{
+	b->flags &= ~(EXT2_BLOCK_CACHED | EXT2_BLOCK_DIRTY);
+	sys_dlist_remove(&b->node);
+}
+
+static int block_cache_writeback(struct ext2_data *fs, struct ext2_block *b)
+{
+	int ret;
+
+	ret = fs->backend_ops->write_block(fs, b->data, b->num);
+	if (ret < 0) {
+		LOG_ERR("block cache: write back of block %d error %d", b->num, ret);
+		return ret;
+	}
+
+	b->flags &= ~EXT2_BLOCK_DIRTY;
+	block_cache_stats.writebacks++;
+	return 0;
+}
+
+/* Take the least recently used block that nobody references out of the cache. */
+static struct ext2_block *block_cache_evict(struct ext2_data *fs)
+{
+	sys_dnode_t *node;
+	struct ext2_block *b;
+
+	for (node = sys_dlist_peek_tail(&block_cache); node != NULL;
+	     node = sys_dlist_peek_prev(&block_cache, node)) {
+		b = CONTAINER_OF(node, struct ext2_block, node);
+		if (b->ref > 0) {
+			continue;
+		}
+		if ((b->flags & EXT2_BLOCK_DIRTY) && block_cache_writeback(fs, b) < 0) {
+			return NULL;
+		}
+		block_cache_remove(b);
+		block_cache_stats.evictions++;
+		return b;
+	}
+	return NULL;
+}
+#endif
+
+static struct ext2_block *get_block_struct(struct ext2_data *fs)
 {
 	int ret;
 	struct ext2_block *b;
 
 	ret = k_mem_slab_alloc(&ext2_block_struct_slab, (void **)&b, K_NO_WAIT);
 	if (ret < 0) {
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+		b = block_cache_evict(fs);
+		if (b != NULL) {
+			b->ref = 1;
+			return b;
+		}
+#endif
 		LOG_ERR("get block: alloc block struct error %d", ret);
 		return NULL;
 	}
@@ -83,14 +167,37 @@ static struct ext2_block *get_block_struct(void)
 		k_mem_slab_free(&ext2_block_struct_slab, (void *)b);
 		return NULL;
 	}
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	b->ref = 1;
+#endif
 	return b;
 }
 
+static void free_block_struct(struct ext2_block *b)
+{
+	k_mem_slab_free(&ext2_block_memory_slab, (void *)b->data);
+	k_mem_slab_free(&ext2_block_struct_slab, (void *)b);
+}
+
 struct ext2_block *ext2_get_block(struct ext2_data *fs, uint32_t block)
 {
 	int ret;
-	struct ext2_block *b = get_block_struct();
+	struct ext2_block *b;
+
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	b = block_cache_find(block);
+	if (b != NULL) {
+		/* Move the block to the front of the LRU list */
+		sys_dlist_remove(&b->node);
+		sys_dlist_prepend(&block_cache, &b->node);
+		b->ref++;
+		block_cache_stats.hits++;
+		return b;
+	}
+	block_cache_stats.misses++;
+#endif
 
+	b = get_block_struct(fs);
 	if (!b) {
 		return NULL;
 	}
@@ -102,12 +209,40 @@ struct ext2_block *ext2_get_block(struct ext2_data *fs, uint32_t block)
 		ext2_drop_block(b);
 		return NULL;
 	}
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	block_cache_insert(b);
+#endif
 	return b;
 }
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+void ext2_prefetch_block(struct ext2_data *fs, uint32_t block)
+{
+	struct ext2_block *b;
+
+	if (block_cache_find(block) != NULL) {
+		return;
+	}
+
+	b = get_block_struct(fs);
+	if (!b) {
+		return;
+	}
+	b->num = block;
+	b->flags = EXT2_BLOCK_ASSIGNED;
+	b->ref = 0;
+	if (fs->backend_ops->read_block(fs, b->data, block) < 0) {
+		free_block_struct(b);
+		return;
+	}
+	block_cache_insert(b);
+	block_cache_stats.readahead++;
+}
+#endif
+
 struct ext2_block *ext2_get_empty_block(struct ext2_data *fs)
 {
-	struct ext2_block *b = get_block_struct();
+	struct ext2_block *b = get_block_struct(fs);
 
 	if (!b) {
 		return NULL;
@@ -126,6 +261,14 @@ int ext2_write_block(struct ext2_data *fs, struct ext2_block *b)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	if (b->flags & EXT2_BLOCK_CACHED) {
+		/* Written to the storage by ext2_sync_blocks() or when evicted */
+		b->flags |= EXT2_BLOCK_DIRTY;
+		return 0;
+	}
+#endif
+
 	ret = fs->backend_ops->write_block(fs, b->data, b->num);
 	if (ret < 0) {
 		return ret;
@@ -133,15 +276,39 @@ int ext2_write_block(struct ext2_data *fs, struct ext2_block *b)
 	return 0;
 }
 
+int ext2_sync_blocks(struct ext2_data *fs)
+{
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	int ret;
+	struct ext2_block *b;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&block_cache, b, node) {
+		if (b->flags & EXT2_BLOCK_DIRTY) {
+			ret = block_cache_writeback(fs, b);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+#endif
+	return fs->backend_ops->sync(fs);
+}
+
 void ext2_drop_block(struct ext2_block *b)
 {
 	if (b == NULL) {
 		return;
 	}
 
-	if (b != NULL && b->data != NULL) {
-		k_mem_slab_free(&ext2_block_memory_slab, (void *)b->data);
-		k_mem_slab_free(&ext2_block_struct_slab, (void *)b);
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	if (--b->ref > 0 || (b->flags & EXT2_BLOCK_CACHED)) {
+		/* Still in use or kept in the cache */
+		return;
+	}
+#endif
+
+	if (b->data != NULL) {
+		free_block_struct(b);
 	}
 }
 
@@ -153,12 +320,24 @@ void ext2_init_blocks_slab(struct ext2_data *fs)
 	/* These calls will always succeed because sizes and memory buffers are properly aligned. */
 
 	k_mem_slab_init(&ext2_block_struct_slab, __ext2_block_struct_buffer,
-			sizeof(struct ext2_block), CONFIG_EXT2_MAX_BLOCK_COUNT);
+			sizeof(struct ext2_block), BLOCK_POOL_COUNT);
 
 	k_mem_slab_init(&ext2_block_memory_slab, __ext2_block_memory_buffer, fs->block_size,
-			CONFIG_EXT2_MAX_BLOCK_COUNT);
+			BLOCK_POOL_COUNT);
+
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	sys_dlist_init(&block_cache);
+	memset(&block_cache_stats, 0, sizeof(block_cache_stats));
+#endif
 }
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+void ext2_block_cache_stats_get(struct ext2_block_cache_stats *stats)
+{
+	*stats = block_cache_stats;
+}
+#endif
+
 int ext2_assign_block_num(struct ext2_data *fs, struct ext2_block *b)
 {
 	int64_t new_block;
@@ -167,14 +346,62 @@ int ext2_assign_block_num(struct ext2_data *fs, struct ext2_block *b)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	/* The cache may still hold the previous contents of a freed block. While they are
+	 * referenced, their users could write them back over the new contents, so such blocks
+	 * stay allocated until another block is found. Each of them is a distinct block from
+	 * the pool, which bounds their number.
+	 */
+	uint32_t busy[BLOCK_POOL_COUNT];
+	uint32_t busy_count = 0;
+	struct ext2_block *stale = NULL;
+	int rc;
+
+	while (true) {
+		/* Allocate block in the file system. */
+		new_block = ext2_alloc_block(fs);
+		if (new_block < 0) {
+			break;
+		}
+
+		stale = block_cache_find(new_block);
+		if (stale == NULL || stale->ref == 0) {
+			break;
+		}
+
+		__ASSERT_NO_MSG(busy_count < ARRAY_SIZE(busy));
+		busy[busy_count++] = new_block;
+	}
+
+	for (uint32_t i = 0; i < busy_count; i++) {
+		rc = ext2_free_block(fs, busy[i]);
+		if (rc < 0) {
+			LOG_ERR("assign block: free of block %d error %d", busy[i], rc);
+		}
+	}
+
+	if (new_block < 0) {
+		return new_block;
+	}
+
+	if (stale != NULL) {
+		block_cache_remove(stale);
+		free_block_struct(stale);
+	}
+#else
 	/* Allocate block in the file system. */
 	new_block = ext2_alloc_block(fs);
 	if (new_block < 0) {
 		return new_block;
 	}
+#endif
 
 	b->num = new_block;
 	b->flags |= EXT2_BLOCK_ASSIGNED;
+
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	block_cache_insert(b);
+#endif
 	return 0;
 }
 
@@ -323,6 +550,10 @@ int ext2_init_fs(struct ext2_data *fs)
 		if (ret < 0) {
 			return ret;
 		}
+		ret = ext2_sync_blocks(fs);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
 	ret = ext2_fetch_block_group(fs, 0);
@@ -384,7 +615,7 @@ int ext2_close_fs(struct ext2_data *fs)
 	ext2_drop_block(fs->bgroup.inode_bitmap);
 	ext2_drop_block(fs->bgroup.block_bitmap);
 
-	if (fs->backend_ops->sync(fs) < 0) {
+	if (ext2_sync_blocks(fs) < 0) {
 		return -EIO;
 	}
 	return 0;
@@ -788,7 +1019,7 @@ int ext2_inode_sync(struct ext2_inode *inode)
 		if (ret < 0) {
 			return ret;
 		}
-		ret = fs->backend_ops->sync(fs);
+		ret = ext2_sync_blocks(fs);
 		if (ret < 0) {
 			return ret;
 		}
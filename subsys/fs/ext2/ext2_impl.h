@@ -30,6 +30,13 @@ struct ext2_block *ext2_get_block(struct ext2_data *fs, uint32_t block);
 
 struct ext2_block *ext2_get_empty_block(struct ext2_data *fs);
 
+/**
+ * @brief Read block into the block cache without taking a reference.
+ *
+ * Used to read ahead blocks that are expected to be requested soon. Errors are ignored.
+ */
+void ext2_prefetch_block(struct ext2_data *fs, uint32_t block);
+
 /**
  * @brief Free the block structure.
  */
@@ -43,6 +50,11 @@ void ext2_drop_block(struct ext2_block *b);
  */
 int ext2_write_block(struct ext2_data *fs, struct ext2_block *b);
 
+/**
+ * @brief Write back dirty cached blocks and sync the disk.
+ */
+int ext2_sync_blocks(struct ext2_data *fs);
+
 void ext2_init_blocks_slab(struct ext2_data *fs);
 
 /**
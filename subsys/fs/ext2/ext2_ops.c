@@ -15,6 +15,7 @@
 #include "ext2.h"
 #include "ext2_impl.h"
 #include "ext2_struct.h"
+#include "ext2_diskops.h"
 
 LOG_MODULE_DECLARE(ext2);
 
@@ -98,6 +99,9 @@ static int ext2_open(struct fs_file_t *filp, const char *fs_path, fs_mode_t flag
 
 	file->f_inode = found_inode;
 	file->f_off = 0;
+#if defined(CONFIG_EXT2_BLOCK_CACHE) && (CONFIG_EXT2_BLOCK_CACHE_READAHEAD > 0)
+	file->f_ra_off = 0;
+#endif
 	file->f_flags = flags & (FS_O_RDWR | FS_O_APPEND);
 
 	filp->filep = file;
@@ -145,6 +149,19 @@ static ssize_t ext2_read(struct fs_file_t *filp, void *dest, size_t nbytes)
 	if (r < 0) {
 		return r;
 	}
+
+#if defined(CONFIG_EXT2_BLOCK_CACHE) && (CONFIG_EXT2_BLOCK_CACHE_READAHEAD > 0)
+	uint32_t block_size = f->f_inode->i_fs->block_size;
+	bool new_block = (f->f_off % block_size == 0) ||
+			 (f->f_off / block_size != (f->f_off + r - 1) / block_size);
+
+	/* Read ahead when a sequential read has moved to a new block */
+	if (r > 0 && f->f_off == f->f_ra_off && new_block) {
+		ext2_inode_readahead(f->f_inode, CONFIG_EXT2_BLOCK_CACHE_READAHEAD);
+	}
+	f->f_ra_off = f->f_off + r;
+#endif
+
 	f->f_off += r;
 	return r;
 }
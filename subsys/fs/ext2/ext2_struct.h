@@ -131,11 +131,17 @@ struct ext2_superblock {
 	((struct ext2_disk_direntry *)(((uint8_t *)(addr)) + (offset)))
 
 #define EXT2_BLOCK_ASSIGNED BIT(0)
+#define EXT2_BLOCK_CACHED   BIT(1) /* block is in the block cache */
+#define EXT2_BLOCK_DIRTY    BIT(2) /* cached block must be written back */
 
 struct ext2_block {
 	uint32_t num;
 	uint8_t flags;
 	uint8_t *data;
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	sys_dnode_t node; /* node in the block cache LRU list */
+	uint16_t ref;     /* number of users of the block */
+#endif
 } __aligned(sizeof(void *));
 
 #define BGROUP_INODE_TABLE(bg) ((struct ext2_disk_inode *)(bg)->inode_table->data)
@@ -207,6 +213,9 @@ struct ext2_direntry {
 struct ext2_file {
 	struct ext2_inode *f_inode;
 	uint32_t f_off;
+#if defined(CONFIG_EXT2_BLOCK_CACHE) && (CONFIG_EXT2_BLOCK_CACHE_READAHEAD > 0)
+	uint32_t f_ra_off; /* offset following the previous read */
+#endif
 	uint8_t f_flags;
 };
 
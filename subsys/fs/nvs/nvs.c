@@ -10,6 +10,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <zephyr/fs/nvs.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/crc.h>
 #include "nvs_priv.h"
 
@@ -620,6 +621,146 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+/* A lookup cache snapshot is the data of an ATE with id 0xFFFF, written right
+ * after the garbage collection that opened a sector: the lookup cache for all
+ * the sectors before this one, followed by its CRC-32.
+ */
+static inline size_t nvs_snapshot_len(struct nvs_fs *fs)
+{
+	return nvs_al_size(fs, sizeof(fs->lookup_cache)) + sizeof(uint32_t);
+}
+
+/* Write a snapshot of the lookup cache in the sector that has just been
+ * opened, if it fits while leaving the required_space of the pending write,
+ * or room for a delete ate.
+ */
+static int nvs_lookup_cache_snapshot(struct nvs_fs *fs, size_t required_space)
+{
+	int rc;
+	struct nvs_ate snapshot_ate;
+	uint32_t snapshot_crc;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, nvs_snapshot_len(fs)) +
+			   ate_size + required_space)) {
+		LOG_DBG("No room for a lookup cache snapshot at %x", fs->ate_wra);
+		return 0;
+	}
+
+	snapshot_ate.id = 0xFFFF;
+	snapshot_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	snapshot_ate.len = (uint16_t)nvs_snapshot_len(fs);
+	snapshot_ate.part = 0xff;
+	nvs_ate_crc8_update(&snapshot_ate);
+
+	snapshot_crc = crc32_ieee((const uint8_t *)fs->lookup_cache,
+				  sizeof(fs->lookup_cache));
+
+	rc = nvs_flash_data_wrt(fs, fs->lookup_cache, sizeof(fs->lookup_cache),
+				false);
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_flash_data_wrt(fs, &snapshot_crc, sizeof(snapshot_crc), false);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, &snapshot_ate);
+}
+#endif /* CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT */
+
+/* Check if gc_ate, read at gc_addr in a sector to garbage collect, is the most
+ * recent ate of its id.
+ * return 1 if the ate must be copied, 0 if not, errcode on flash error.
+ */
+static int nvs_gc_ate_needs_copy(struct nvs_fs *fs, const struct nvs_ate *gc_ate,
+				 uint32_t gc_addr)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+	/* deleted items are never copied */
+	if (!nvs_ate_valid(fs, gc_ate) || !gc_ate->len) {
+		return 0;
+	}
+
+	/* Lookup cache snapshots are never moved */
+	if (IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT) &&
+	    (gc_ate->id == 0xFFFF)) {
+		return 0;
+	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate->id)];
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_addr copy is needed */
+	return (wlk_prev_addr == gc_addr) ? 1 : 0;
+}
+
+/* Copy gc_ate, read at gc_addr, and its data to the write position of the
+ * active sector.
+ */
+static int nvs_gc_move_ate(struct nvs_fs *fs, struct nvs_ate *gc_ate,
+			   uint32_t gc_addr)
+{
+	int rc;
+	uint32_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (gc_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_flash_ate_wrt(fs, gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+#ifdef CONFIG_NVS_GC_STATS
+	fs->gc_stats.bytes_moved += nvs_al_size(fs, gc_ate->len) +
+				    nvs_al_size(fs, sizeof(struct nvs_ate));
+#endif
+
+	return 0;
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -627,9 +768,8 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -638,6 +778,15 @@ static int nvs_gc(struct nvs_fs *fs)
 	nvs_sector_advance(fs, &sec_addr);
 	gc_addr = sec_addr + fs->sector_size - ate_size;
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	if (fs->gc_bg_addr == gc_addr) {
+		/* The entries have been copied in the background, which may
+		 * have started to erase the sector.
+		 */
+		goto gc_done;
+	}
+#endif
+
 	/* if the sector is not closed don't do gc */
 	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
 	if (rc < 0) {
@@ -669,55 +818,13 @@ static int nvs_gc(struct nvs_fs *fs)
 			return rc;
 		}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
+		rc = nvs_gc_ate_needs_copy(fs, &gc_ate, gc_prev_addr);
+		if (rc < 0) {
+			return rc;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
-
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+		if (rc) {
+			rc = nvs_gc_move_ate(fs, &gc_ate, gc_prev_addr);
 			if (rc) {
 				return rc;
 			}
@@ -739,12 +846,368 @@ gc_done:
 		}
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	if (fs->gc_bg_addr == (sec_addr + fs->sector_size)) {
+		/* The sector has already been erased in the background */
+		fs->gc_bg_addr = NVS_GC_BG_IDLE;
+		return 0;
+	}
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 
 	return rc;
 }
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+static K_THREAD_STACK_DEFINE(nvs_gc_bg_stack_area,
+			     CONFIG_NVS_GC_BACKGROUND_STACK_SIZE);
+static struct k_work_q nvs_gc_bg_work_q;
+
+/* The background garbage collection works on the oldest sector, the one that
+ * the garbage collection erases when the active sector is full.
+ * fs->gc_bg_addr tracks its progress:
+ * - NVS_GC_BG_IDLE or an address in another sector: not started
+ * - offset 0: stopped, the active sector has no room left for the copies
+ * - offset below the close ate: address of the next ate to check
+ * - offset of the close ate: all the ate's that must be kept have been copied,
+ *   the first fs->gc_bg_erased bytes of the sector have been erased
+ * - offset equal to the sector size: the sector has been erased
+ */
+static inline uint32_t nvs_gc_bg_sector(struct nvs_fs *fs)
+{
+	uint32_t addr = fs->ate_wra & ADDR_SECT_MASK;
+
+	nvs_sector_advance(fs, &addr);
+	nvs_sector_advance(fs, &addr);
+
+	return addr;
+}
+
+static bool nvs_gc_bg_pending(struct nvs_fs *fs)
+{
+	uint32_t offset;
+	size_t ate_size;
+
+	/* With 2 sectors, the oldest sector is the active one */
+	if ((fs->sector_count < 3) ||
+	    ((fs->ate_wra - fs->data_wra) >=
+	     ((uint32_t)fs->sector_size * CONFIG_NVS_GC_BACKGROUND_THRESHOLD / 100))) {
+		return false;
+	}
+
+	if ((fs->gc_bg_addr & ADDR_SECT_MASK) != nvs_gc_bg_sector(fs)) {
+		return true;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	offset = fs->gc_bg_addr & ADDR_OFFS_MASK;
+	if (offset == (fs->sector_size - ate_size)) {
+		/* Erasing the oldest sector in advance leaves a closed sector
+		 * followed by an open one only with 4 sectors or more, which
+		 * nvs_startup() needs to find the active sector.
+		 */
+		return fs->sector_count > 3;
+	}
+
+	return (offset != 0) && (offset != fs->sector_size);
+}
+
+/* Erase the next flash page of the oldest sector, from its start so that the
+ * close ate stays valid until the last page.
+ * return 0 if OK, errcode on flash error.
+ */
+static int nvs_gc_bg_erase_page(struct nvs_fs *fs, uint32_t sec_addr)
+{
+	int rc;
+	off_t offset;
+	struct flash_pages_info info;
+
+	offset = fs->offset;
+	offset += fs->sector_size * (sec_addr >> ADDR_SECT_SHIFT);
+	offset += fs->gc_bg_erased;
+
+	rc = flash_get_page_info_by_offs(fs->flash_device, offset, &info);
+	if (rc) {
+		return rc;
+	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (!fs->gc_bg_erased) {
+		nvs_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+	}
+#endif
+
+	LOG_DBG("Erasing flash at %lx, len %zu", (long int) offset, info.size);
+
+	rc = flash_flatten(fs->flash_device, offset, info.size);
+	if (rc) {
+		return rc;
+	}
+
+	if (nvs_flash_cmp_const(fs, sec_addr + fs->gc_bg_erased,
+				fs->flash_parameters->erase_value, info.size)) {
+		return -ENXIO;
+	}
+
+	fs->gc_bg_erased += info.size;
+	if (fs->gc_bg_erased >= fs->sector_size) {
+		fs->gc_bg_addr = sec_addr + fs->sector_size;
+	}
+
+	return 0;
+}
+
+/* Run one step of the background garbage collection: check up to
+ * CONFIG_NVS_GC_BACKGROUND_STEP ate's of the oldest sector and copy the ones
+ * that must be kept to the active sector, or erase one flash page of the
+ * oldest sector once nothing is left to copy.
+ * return 0 if OK, errcode on flash error.
+ */
+static int nvs_gc_bg_step(struct nvs_fs *fs)
+{
+	int rc = 0;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, stop_addr;
+	size_t ate_size, required_space;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	sec_addr = nvs_gc_bg_sector(fs);
+	stop_addr = sec_addr + fs->sector_size - ate_size;
+
+	if (fs->gc_bg_addr == stop_addr) {
+		return nvs_gc_bg_erase_page(fs, sec_addr);
+	}
+
+	if ((fs->gc_bg_addr & ADDR_SECT_MASK) != sec_addr) {
+		fs->gc_bg_erased = 0;
+
+		rc = nvs_flash_ate_rd(fs, stop_addr, &close_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!nvs_ate_cmp_const(&close_ate,
+				       fs->flash_parameters->erase_value)) {
+			/* Nothing to copy, erase the sector unless it is
+			 * already erased.
+			 */
+			rc = nvs_flash_cmp_const(fs, sec_addr,
+						 fs->flash_parameters->erase_value,
+						 fs->sector_size);
+			if (rc < 0) {
+				return rc;
+			}
+
+			fs->gc_bg_addr = rc ? stop_addr : (sec_addr + fs->sector_size);
+			return 0;
+		}
+
+		if (!nvs_close_ate_valid(fs, &close_ate)) {
+			/* Leave the recovery of the last ate to nvs_gc() */
+			fs->gc_bg_addr = sec_addr;
+			return 0;
+		}
+
+		fs->gc_bg_addr = sec_addr + close_ate.offset;
+	}
+
+	for (int i = 0; (i < CONFIG_NVS_GC_BACKGROUND_STEP) &&
+			(fs->gc_bg_addr != stop_addr); i++) {
+		gc_addr = fs->gc_bg_addr;
+		rc = nvs_flash_ate_rd(fs, gc_addr, &gc_ate);
+		if (rc) {
+			break;
+		}
+
+		rc = nvs_gc_ate_needs_copy(fs, &gc_ate, gc_addr);
+		if (rc < 0) {
+			break;
+		}
+
+		if (rc) {
+			/* Keep the room for a delete ate, as nvs_write() does */
+			required_space = nvs_al_size(fs, gc_ate.len) + ate_size;
+			if (fs->ate_wra < (fs->data_wra + required_space)) {
+				LOG_DBG("No room left to copy %d in the background",
+					gc_ate.id);
+				fs->gc_bg_addr = sec_addr;
+				rc = 0;
+				break;
+			}
+
+			rc = nvs_gc_move_ate(fs, &gc_ate, gc_addr);
+			if (rc) {
+				break;
+			}
+		}
+
+		fs->gc_bg_addr += ate_size;
+	}
+
+	return rc;
+}
+
+static void nvs_gc_bg_work_handler(struct k_work *work)
+{
+	int rc;
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->ready || !nvs_gc_bg_pending(fs)) {
+		goto end;
+	}
+
+	rc = nvs_gc_bg_step(fs);
+	if (rc) {
+		LOG_ERR("Background garbage collection failed, returned = %d", rc);
+		goto end;
+	}
+
+	/* Let the writers in between the steps */
+	if (nvs_gc_bg_pending(fs)) {
+		k_work_submit_to_queue(&nvs_gc_bg_work_q, work);
+	}
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+static int nvs_gc_bg_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "nvs_gc"};
+
+	k_work_queue_init(&nvs_gc_bg_work_q);
+	k_work_queue_start(&nvs_gc_bg_work_q, nvs_gc_bg_stack_area,
+			   K_THREAD_STACK_SIZEOF(nvs_gc_bg_stack_area),
+			   CONFIG_NVS_GC_BACKGROUND_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_bg_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_NVS_GC_BACKGROUND */
+
+/* The background garbage collection moves the ATEs: when it is enabled, the lookups take the
+ * lock as the writes do.
+ */
+static inline void nvs_lookup_lock(struct nvs_fs *fs)
+{
+	if (IS_ENABLED(CONFIG_NVS_GC_BACKGROUND)) {
+		k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	}
+}
+
+static inline void nvs_lookup_unlock(struct nvs_fs *fs)
+{
+	if (IS_ENABLED(CONFIG_NVS_GC_BACKGROUND)) {
+		k_mutex_unlock(&fs->nvs_lock);
+	}
+}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+/* Restore the lookup cache from the snapshot of the active sector and replay
+ * on top of it the ate's written in this sector, instead of walking the ate's
+ * of all the sectors.
+ * return 0 if OK, -ENOENT if there is no valid snapshot, errcode on flash error.
+ */
+static int nvs_lookup_cache_restore(struct nvs_fs *fs)
+{
+	int rc;
+	bool found = false;
+	uint32_t addr, first_addr, snapshot_crc;
+	struct nvs_ate ate, snapshot_ate;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	first_addr = (fs->ate_wra & ADDR_SECT_MASK) + fs->sector_size - 2 * ate_size;
+
+	/* Look for the snapshot, from the oldest to the newest ate of the sector */
+	for (addr = first_addr; addr > fs->ate_wra; addr -= ate_size) {
+		rc = nvs_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+		if (nvs_ate_valid(fs, &ate) && (ate.id == 0xFFFF) &&
+		    (ate.len == nvs_snapshot_len(fs))) {
+			snapshot_ate = ate;
+			found = true;
+		}
+	}
+
+	if (!found) {
+		return -ENOENT;
+	}
+
+	addr = (fs->ate_wra & ADDR_SECT_MASK) + snapshot_ate.offset;
+	rc = nvs_flash_rd(fs, addr, fs->lookup_cache, sizeof(fs->lookup_cache));
+	if (rc) {
+		return rc;
+	}
+
+	addr += nvs_al_size(fs, sizeof(fs->lookup_cache));
+	rc = nvs_flash_rd(fs, addr, &snapshot_crc, sizeof(snapshot_crc));
+	if (rc) {
+		return rc;
+	}
+
+	if (crc32_ieee((const uint8_t *)fs->lookup_cache,
+		       sizeof(fs->lookup_cache)) != snapshot_crc) {
+		LOG_WRN("Invalid lookup cache snapshot");
+		return -ENOENT;
+	}
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	/* The oldest sector may have been erased in the background after the
+	 * snapshot.
+	 */
+	addr = fs->ate_wra & ADDR_SECT_MASK;
+	nvs_sector_advance(fs, &addr);
+	nvs_sector_advance(fs, &addr);
+	rc = nvs_flash_ate_rd(fs, addr + fs->sector_size - ate_size, &ate);
+	if (rc) {
+		return rc;
+	}
+	if (!nvs_ate_cmp_const(&ate, fs->flash_parameters->erase_value)) {
+		nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+	}
+#endif
+
+	for (addr = first_addr; addr > fs->ate_wra; addr -= ate_size) {
+		rc = nvs_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+		if ((ate.id != 0xFFFF) && nvs_ate_valid(fs, &ate)) {
+			fs->lookup_cache[nvs_lookup_cache_pos(ate.id)] = addr;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT */
+
+static int nvs_lookup_cache_load(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+	int rc;
+
+	rc = nvs_lookup_cache_restore(fs);
+	if (rc != -ENOENT) {
+		return rc;
+	}
+
+	LOG_DBG("No lookup cache snapshot, rebuilding the cache");
+#endif
+
+	return nvs_lookup_cache_rebuild(fs);
+}
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -951,7 +1414,7 @@ end:
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	if (!rc) {
-		rc = nvs_lookup_cache_rebuild(fs);
+		rc = nvs_lookup_cache_load(fs);
 	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
@@ -970,12 +1433,19 @@ int nvs_clear(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr;
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -995,8 +1465,23 @@ int nvs_mount(struct nvs_fs *fs)
 	int rc;
 	struct flash_pages_info info;
 	size_t write_block_size;
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	if (fs->ready) {
+		/* Remount: wait for a running background step to complete */
+		k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+#endif
 
 	k_mutex_init(&fs->nvs_lock);
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	k_work_init(&fs->gc_work, nvs_gc_bg_work_handler);
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+#endif
+#ifdef CONFIG_NVS_GC_STATS
+	memset(&fs->gc_stats, 0, sizeof(fs->gc_stats));
+#endif
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
 	if (fs->flash_parameters == NULL) {
@@ -1056,6 +1541,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	uint32_t wlk_addr, rd_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
 	bool prev_found = false;
+#ifdef CONFIG_NVS_GC_STATS
+	uint32_t start, stall_us;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1076,6 +1564,12 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_NVS_GC_STATS
+	start = k_cycle_get_32();
+#endif
+	/* The lock is taken again below for the write, k_mutex is recursive */
+	nvs_lookup_lock(fs);
+
 	/* find latest entry with same id */
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
@@ -1092,7 +1586,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
-			return rc;
+			goto end_lookup;
 		}
 		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
 			prev_found = true;
@@ -1118,20 +1612,22 @@ no_cached_entry:
 				/* skip delete entry as it is already the
 				 * last one
 				 */
-				return 0;
+				rc = 0;
+				goto end_lookup;
 			}
 		} else if (len + NVS_DATA_CRC_SIZE == wlk_ate.len) {
 			/* do not try to compare if lengths are not equal */
 			/* compare the data and if equal return 0 */
 			rc = nvs_flash_block_cmp(fs, rd_addr, data, len + NVS_DATA_CRC_SIZE);
 			if (rc <= 0) {
-				return rc;
+				goto end_lookup;
 			}
 		}
 	} else {
 		/* skip delete entry for non-existing entry */
 		if (len == 0) {
-			return 0;
+			rc = 0;
+			goto end_lookup;
 		}
 	}
 
@@ -1172,11 +1668,32 @@ no_cached_entry:
 		if (rc) {
 			goto end;
 		}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+		rc = nvs_lookup_cache_snapshot(fs, required_space);
+		if (rc) {
+			goto end;
+		}
+#endif
 		gc_count++;
 	}
 	rc = len;
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	if (nvs_gc_bg_pending(fs)) {
+		k_work_submit_to_queue(&nvs_gc_bg_work_q, &fs->gc_work);
+	}
+#endif
 end:
+#ifdef CONFIG_NVS_GC_STATS
+	stall_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	if (stall_us > fs->gc_stats.max_stall_us) {
+		fs->gc_stats.max_stall_us = stall_us;
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
+end_lookup:
+	nvs_lookup_unlock(fs);
 	return rc;
 }
 
@@ -1210,12 +1727,14 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+	nvs_lookup_lock(fs);
+
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
-		goto err;
+		goto end;
 	}
 #else
 	wlk_addr = fs->ate_wra;
@@ -1226,7 +1745,7 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
-			goto err;
+			goto end;
 		}
 		if ((wlk_ate.id == id) &&  (nvs_ate_valid(fs, &wlk_ate))) {
 			cnt_his++;
@@ -1238,13 +1757,15 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	if (((wlk_addr == fs->ate_wra) && (wlk_ate.id != id)) ||
 	    (wlk_ate.len == 0U) || (cnt_his < cnt)) {
-		return -ENOENT;
+		rc = -ENOENT;
+		goto end;
 	}
 
 #ifdef CONFIG_NVS_DATA_CRC
 	/* When data CRC is enabled, there should be at least the CRC stored in the data field */
 	if (wlk_ate.len < NVS_DATA_CRC_SIZE) {
-		return -ENOENT;
+		rc = -ENOENT;
+		goto end;
 	}
 #endif
 
@@ -1252,7 +1773,7 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 	rd_addr += wlk_ate.offset;
 	rc = nvs_flash_rd(fs, rd_addr, data, MIN(len, wlk_ate.len - NVS_DATA_CRC_SIZE));
 	if (rc) {
-		goto err;
+		goto end;
 	}
 
 	/* Check data CRC (only if the whole element data has been read) */
@@ -1261,7 +1782,7 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		rd_addr += wlk_ate.len - NVS_DATA_CRC_SIZE;
 		rc = nvs_flash_rd(fs, rd_addr, &read_data_crc, sizeof(read_data_crc));
 		if (rc) {
-			goto err;
+			goto end;
 		}
 
 		computed_data_crc = crc32_ieee(data, wlk_ate.len - NVS_DATA_CRC_SIZE);
@@ -1269,14 +1790,15 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 			LOG_ERR("Invalid data CRC: read_data_crc=0x%08X, computed_data_crc=0x%08X",
 				read_data_crc, computed_data_crc);
 			rc = -EIO;
-			goto err;
+			goto end;
 		}
 	}
 #endif
 
-	return wlk_ate.len - NVS_DATA_CRC_SIZE;
+	rc = wlk_ate.len - NVS_DATA_CRC_SIZE;
 
-err:
+end:
+	nvs_lookup_unlock(fs);
 	return rc;
 }
 
@@ -1288,18 +1810,13 @@ ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
 	return rc;
 }
 
-ssize_t nvs_calc_free_space(struct nvs_fs *fs)
+static ssize_t nvs_free_space_walk(struct nvs_fs *fs)
 {
 	int rc;
 	struct nvs_ate step_ate, wlk_ate;
 	uint32_t step_addr, wlk_addr;
 	size_t ate_size, free_space;
 
-	if (!fs->ready) {
-		LOG_ERR("NVS not initialized");
-		return -EACCES;
-	}
-
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	/*
@@ -1337,6 +1854,9 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 				if (step_ate.id == 0xFFFF) {
 					free_space -= ate_size;
 				}
+			} else if (IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT) &&
+				   (step_ate.id == 0xFFFF)) {
+				/* Lookup cache snapshots are not moved by gc */
 			} else if (wlk_addr == step_addr) {
 				/* count needed */
 				free_space -= nvs_al_size(fs, step_ate.len);
@@ -1351,6 +1871,22 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	return free_space;
 }
 
+ssize_t nvs_calc_free_space(struct nvs_fs *fs)
+{
+	ssize_t free_space;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	nvs_lookup_lock(fs);
+	free_space = nvs_free_space_walk(fs);
+	nvs_lookup_unlock(fs);
+
+	return free_space;
+}
+
 size_t nvs_sector_max_data_size(struct nvs_fs *fs)
 {
 	size_t ate_size;
@@ -1382,8 +1918,34 @@ int nvs_sector_use_next(struct nvs_fs *fs)
 	}
 
 	ret = nvs_gc(fs);
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+	if (ret == 0) {
+		ret = nvs_lookup_cache_snapshot(fs, 0U);
+	}
+#endif
 
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return ret;
 }
+
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats)
+{
+#ifdef CONFIG_NVS_GC_STATS
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	*stats = fs->gc_stats;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return 0;
+#else
+	ARG_UNUSED(fs);
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif
+}
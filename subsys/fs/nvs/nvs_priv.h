@@ -30,6 +30,8 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+#define NVS_GC_BG_IDLE 0xFFFFFFFF
+
 /*
  * Allow to use the NVS_DATA_CRC_SIZE macro in computations whether data CRC is enabled or not
  */
@@ -73,6 +73,10 @@ static struct fs_mount_t littlefs_mnt = {
 #endif
 #endif
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+#include <zephyr/fs/ext2.h>
+#endif
+
 #define BUF_CNT 64
 
 #define MAX_PATH_LEN 128
@@ -745,6 +749,21 @@ static int cmd_erase_write_test(const struct shell *sh, size_t argc, char **argv
 }
 #endif
 
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+static int cmd_ext2_cache(const struct shell *sh, size_t argc, char **argv)
+{
+	struct ext2_block_cache_stats stats;
+
+	ext2_block_cache_stats_get(&stats);
+
+	shell_print(sh, "hits: %u, misses: %u, readahead: %u, writebacks: %u, evictions: %u",
+		    stats.hits, stats.misses, stats.readahead, stats.writebacks,
+		    stats.evictions);
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_FAT_FILESYSTEM_ELM)		\
 	|| defined(CONFIG_FILE_SYSTEM_LITTLEFS)
 static char *mntpt_prepare(char *mntpt)
@@ -861,6 +880,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_fs,
 		      cmd_read_test, 2, 2),
 	SHELL_CMD_ARG(erase_write_test, NULL, "Erase/write file test",
 		      cmd_erase_write_test, 3, 3),
+#endif
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+	SHELL_CMD(ext2_cache, NULL, "Show ext2 block cache statistics", cmd_ext2_cache),
 #endif
 	SHELL_SUBCMD_SET_END
 );
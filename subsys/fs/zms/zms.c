@@ -9,6 +9,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <zephyr/fs/zms.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/crc.h>
 #include "zms_priv.h"
 
@@ -104,6 +105,25 @@ static void zms_lookup_cache_invalidate(struct zms_fs *fs, uint32_t sector)
 	}
 }
 
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+
+#define ZMS_SNAPSHOT_LEN SIZEOF_FIELD(struct zms_fs, lookup_cache)
+
+BUILD_ASSERT((ZMS_SNAPSHOT_LEN > ZMS_DATA_IN_ATE_SIZE) && (ZMS_SNAPSHOT_LEN <= UINT16_MAX),
+	     "The lookup cache snapshot must fit in the data of a single entry");
+
+/* A lookup cache snapshot is the data of an ATE with ID ZMS_HEAD_ID and the length of the
+ * lookup cache, written right after the garbage collection that opened a sector. It holds
+ * the lookup cache for all the sectors before this one.
+ */
+static bool zms_snapshot_ate_valid(struct zms_fs *fs, const struct zms_ate *entry)
+{
+	return zms_ate_valid(fs, entry) && (entry->id == ZMS_HEAD_ID) &&
+	       (entry->len == ZMS_SNAPSHOT_LEN);
+}
+
+#endif /* CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT */
+
 #endif /* CONFIG_ZMS_LOOKUP_CACHE */
 
 /* Helper to compute offset given the address */
@@ -722,6 +742,40 @@ static int zms_add_gc_done_ate(struct zms_fs *fs)
 	return zms_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+/* Write a snapshot of the lookup cache in the sector that has just been opened, if it fits
+ * while leaving the required_space of the pending write, or room for a delete ATE.
+ */
+static int zms_lookup_cache_snapshot(struct zms_fs *fs, uint32_t required_space)
+{
+	int rc;
+	struct zms_ate snapshot_ate;
+
+	if (!SECTOR_OFFSET(fs->ate_wra) || !SECTOR_OFFSET(fs->ate_wra - fs->ate_size) ||
+	    (fs->ate_wra < (fs->data_wra + zms_al_size(fs, ZMS_SNAPSHOT_LEN) + fs->ate_size +
+			    required_space))) {
+		LOG_DBG("No room for a lookup cache snapshot at %llx", fs->ate_wra);
+		return 0;
+	}
+
+	memset(&snapshot_ate, 0, sizeof(struct zms_ate));
+	snapshot_ate.id = ZMS_HEAD_ID;
+	snapshot_ate.len = ZMS_SNAPSHOT_LEN;
+	snapshot_ate.cycle_cnt = fs->sector_cycle;
+	snapshot_ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+	snapshot_ate.data_crc = crc32_ieee((const uint8_t *)fs->lookup_cache, ZMS_SNAPSHOT_LEN);
+
+	zms_ate_crc8_update(&snapshot_ate);
+
+	rc = zms_flash_data_wrt(fs, fs->lookup_cache, ZMS_SNAPSHOT_LEN);
+	if (rc) {
+		return rc;
+	}
+
+	return zms_flash_ate_wrt(fs, &snapshot_ate);
+}
+#endif /* CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT */
+
 static int zms_add_empty_ate(struct zms_fs *fs, uint64_t addr)
 {
 	struct zms_ate empty_ate;
@@ -867,6 +921,91 @@ static int zms_find_ate_with_id(struct zms_fs *fs, uint32_t id, uint64_t start_a
 	return prev_found;
 }
 
+/* Check if gc_ate, read at gc_addr in a sector to garbage collect, is the most recent ATE of its
+ * ID. The cycle counter of the sector to garbage collect must be in fs->sector_cycle.
+ * return 1 if the ATE must be copied, 0 if not, errcode on flash error.
+ */
+static int zms_gc_ate_needs_copy(struct zms_fs *fs, const struct zms_ate *gc_ate, uint64_t gc_addr)
+{
+	int rc;
+	struct zms_ate wlk_ate;
+	uint64_t wlk_addr;
+	uint64_t wlk_prev_addr;
+
+	if (!zms_ate_valid(fs, gc_ate) || !gc_ate->len) {
+		return 0;
+	}
+
+	/* Lookup cache snapshots are never moved */
+	if (IS_ENABLED(CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT) && (gc_ate->id == ZMS_HEAD_ID)) {
+		return 0;
+	}
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate->id)];
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+
+	/* Initialize the wlk_prev_addr as if no previous ID will be found */
+	wlk_prev_addr = gc_addr;
+	/* Search for a previous valid ATE with the same ID. If it doesn't exist
+	 * then wlk_prev_addr will be equal to gc_addr.
+	 */
+	rc = zms_find_ate_with_id(fs, gc_ate->id, wlk_addr, fs->ate_wra, &wlk_ate, &wlk_prev_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* if walk_addr has reached the same address as gc_addr, a copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == gc_addr) ? 1 : 0;
+}
+
+/* Copy gc_ate, read at gc_addr, and its data to the write position of the active sector */
+static int zms_gc_move_ate(struct zms_fs *fs, struct zms_ate *gc_ate, uint64_t gc_addr,
+			   uint8_t cycle_cnt)
+{
+	int rc;
+	uint64_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	if (gc_ate->len > ZMS_DATA_IN_ATE_SIZE) {
+		/* Copy Data only when len > 8
+		 * Otherwise, Data is already inside ATE
+		 */
+		data_addr = (gc_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate->offset;
+		gc_ate->offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+
+		rc = zms_flash_block_move(fs, data_addr, gc_ate->len);
+		if (rc) {
+			return rc;
+		}
+#ifdef CONFIG_ZMS_GC_STATS
+		fs->gc_stats.bytes_moved += zms_al_size(fs, gc_ate->len);
+#endif
+	}
+
+	gc_ate->cycle_cnt = cycle_cnt;
+	zms_ate_crc8_update(gc_ate);
+	rc = zms_flash_ate_wrt(fs, gc_ate);
+	if (rc) {
+		return rc;
+	}
+#ifdef CONFIG_ZMS_GC_STATS
+	fs->gc_stats.bytes_moved += fs->ate_size;
+#endif
+
+	return 0;
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -877,14 +1016,10 @@ static int zms_gc(struct zms_fs *fs)
 	int sec_closed;
 	struct zms_ate close_ate;
 	struct zms_ate gc_ate;
-	struct zms_ate wlk_ate;
 	struct zms_ate empty_ate;
 	uint64_t sec_addr;
 	uint64_t gc_addr;
 	uint64_t gc_prev_addr;
-	uint64_t wlk_addr;
-	uint64_t wlk_prev_addr;
-	uint64_t data_addr;
 	uint64_t stop_addr;
 	uint8_t previous_cycle = 0;
 
@@ -917,6 +1052,15 @@ static int zms_gc(struct zms_fs *fs)
 	zms_sector_advance(fs, &sec_addr);
 	gc_addr = sec_addr + fs->sector_size - fs->ate_size;
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	if (fs->gc_bg_addr == zms_close_ate_addr(fs, sec_addr)) {
+		/* The entries have been copied in the background, which may have started to
+		 * erase the sector.
+		 */
+		goto gc_done;
+	}
+#endif
+
 	/* verify if the sector is closed */
 	sec_closed = zms_validate_closed_sector(fs, gc_addr, &empty_ate, &close_ate);
 	if (sec_closed < 0) {
@@ -946,55 +1090,13 @@ static int zms_gc(struct zms_fs *fs)
 			return rc;
 		}
 
-		if (!zms_ate_valid(fs, &gc_ate) || !gc_ate.len) {
-			continue;
-		}
-
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-
-		/* Initialize the wlk_prev_addr as if no previous ID will be found */
-		wlk_prev_addr = gc_prev_addr;
-		/* Search for a previous valid ATE with the same ID. If it doesn't exist
-		 * then wlk_prev_addr will be equal to gc_prev_addr.
-		 */
-		rc = zms_find_ate_with_id(fs, gc_ate.id, wlk_addr, fs->ate_wra, &wlk_ate,
-					  &wlk_prev_addr);
+		rc = zms_gc_ate_needs_copy(fs, &gc_ate, gc_prev_addr);
 		if (rc < 0) {
 			return rc;
 		}
 
-		/* if walk_addr has reached the same address as gc_addr, a copy is
-		 * needed unless it is a deleted item.
-		 */
-		if (wlk_prev_addr == gc_prev_addr) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
-				/* Copy Data only when len > 8
-				 * Otherwise, Data is already inside ATE
-				 */
-				data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-				data_addr += gc_ate.offset;
-				gc_ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
-
-				rc = zms_flash_block_move(fs, data_addr, gc_ate.len);
-				if (rc) {
-					return rc;
-				}
-			}
-
-			gc_ate.cycle_cnt = previous_cycle;
-			zms_ate_crc8_update(&gc_ate);
-			rc = zms_flash_ate_wrt(fs, &gc_ate);
+		if (rc) {
+			rc = zms_gc_move_ate(fs, &gc_ate, gc_prev_addr, previous_cycle);
 			if (rc) {
 				return rc;
 			}
@@ -1014,6 +1116,15 @@ gc_done:
 		return rc;
 	}
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	if (fs->gc_bg_addr == zms_empty_ate_addr(fs, sec_addr)) {
+		/* The sector has already been erased in the background */
+		fs->gc_bg_addr = ZMS_GC_BG_IDLE;
+		return 0;
+	}
+	fs->gc_bg_addr = ZMS_GC_BG_IDLE;
+#endif
+
 	/* Erase the GC'ed sector when needed */
 	rc = zms_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -1028,16 +1139,268 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+static K_THREAD_STACK_DEFINE(zms_gc_bg_stack_area, CONFIG_ZMS_GC_BACKGROUND_STACK_SIZE);
+static struct k_work_q zms_gc_bg_work_q;
+
+/* The background garbage collection works on the oldest sector, the one that the garbage
+ * collection erases when the active sector is full. fs->gc_bg_addr tracks its progress:
+ * - ZMS_GC_BG_IDLE or an address in another sector: not started
+ * - offset 0: stopped, the active sector has no room left for the copies
+ * - offset below the close ATE: address of the next ATE to check
+ * - offset of the close ATE: all the ATEs that must be kept have been copied, the first
+ *   fs->gc_bg_erased bytes of the sector have been erased
+ * - offset of the empty ATE: the sector has been erased
+ */
+static inline uint64_t zms_gc_bg_sector(struct zms_fs *fs)
+{
+	uint64_t addr = fs->ate_wra & ADDR_SECT_MASK;
+
+	zms_sector_advance(fs, &addr);
+	zms_sector_advance(fs, &addr);
+
+	return addr;
+}
+
+static bool zms_gc_bg_pending(struct zms_fs *fs)
+{
+	uint32_t offset;
+
+	/* With 2 sectors, the oldest sector is the active one */
+	if ((fs->sector_count < 3) ||
+	    ((fs->ate_wra - fs->data_wra) >=
+	     ((uint64_t)fs->sector_size * CONFIG_ZMS_GC_BACKGROUND_THRESHOLD / 100))) {
+		return false;
+	}
+
+	if ((fs->gc_bg_addr & ADDR_SECT_MASK) != zms_gc_bg_sector(fs)) {
+		return true;
+	}
+
+	offset = SECTOR_OFFSET(fs->gc_bg_addr);
+	if (offset == (fs->sector_size - 2 * fs->ate_size)) {
+		/* Erasing the oldest sector in advance leaves a closed sector only with 4 sectors
+		 * or more, which zms_init() needs to find the active sector.
+		 */
+		return fs->sector_count > 3;
+	}
+
+	return (offset != 0) && (offset != (fs->sector_size - fs->ate_size));
+}
+
+/* Erase the next flash page of the oldest sector, from its start so that the close ATE stays
+ * valid until the last page, and add the empty ATE once the whole sector is erased.
+ * return 0 if OK, errcode on flash error.
+ */
+static int zms_gc_bg_erase_page(struct zms_fs *fs, uint64_t sec_addr)
+{
+	int rc;
+	off_t offset;
+	struct flash_pages_info info;
+
+	if (!(flash_params_get_erase_cap(fs->flash_parameters) & FLASH_ERASE_C_EXPLICIT)) {
+		/* Nothing to erase on devices that do not have erase capability */
+		fs->gc_bg_erased = fs->sector_size;
+	} else {
+		offset = zms_addr_to_offset(fs, sec_addr + fs->gc_bg_erased);
+		rc = flash_get_page_info_by_offs(fs->flash_device, offset, &info);
+		if (rc) {
+			return rc;
+		}
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+		if (!fs->gc_bg_erased) {
+			zms_lookup_cache_invalidate(fs, SECTOR_NUM(sec_addr));
+		}
+#endif
+
+		LOG_DBG("Erasing flash at offset 0x%lx, len %zu", (long)offset, info.size);
+		rc = flash_erase(fs->flash_device, offset, info.size);
+		if (rc) {
+			return rc;
+		}
+
+		if (zms_flash_cmp_const(fs, sec_addr + fs->gc_bg_erased,
+					fs->flash_parameters->erase_value, info.size)) {
+			LOG_ERR("Failure while erasing the page at offset 0x%lx", (long)offset);
+			return -ENXIO;
+		}
+
+		fs->gc_bg_erased += info.size;
+	}
+
+	if (fs->gc_bg_erased < fs->sector_size) {
+		return 0;
+	}
+
+	rc = zms_add_empty_ate(fs, sec_addr);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc_bg_addr = zms_empty_ate_addr(fs, sec_addr);
+
+	return 0;
+}
+
+/* Run one step of the background garbage collection: check up to CONFIG_ZMS_GC_BACKGROUND_STEP
+ * ATEs of the oldest sector and copy the ones that must be kept to the active sector, or erase
+ * one flash page of the oldest sector once nothing is left to copy.
+ * return 0 if OK, errcode on flash error.
+ */
+static int zms_gc_bg_step(struct zms_fs *fs)
+{
+	int rc = 0;
+	int sec_closed;
+	struct zms_ate close_ate;
+	struct zms_ate empty_ate;
+	struct zms_ate gc_ate;
+	uint64_t sec_addr;
+	uint64_t gc_addr;
+	uint64_t stop_addr;
+	uint32_t required_space;
+	uint8_t active_cycle = fs->sector_cycle;
+
+	sec_addr = zms_gc_bg_sector(fs);
+	stop_addr = zms_close_ate_addr(fs, sec_addr);
+
+	if (fs->gc_bg_addr == stop_addr) {
+		return zms_gc_bg_erase_page(fs, sec_addr);
+	}
+
+	sec_closed = zms_validate_closed_sector(fs, sec_addr, &empty_ate, &close_ate);
+	if (sec_closed < 0) {
+		return sec_closed;
+	}
+
+	if (!sec_closed) {
+		/* Nothing to copy, but the sector content is unknown: erase it */
+		fs->gc_bg_addr = stop_addr;
+		fs->gc_bg_erased = 0;
+		return 0;
+	}
+
+	if ((fs->gc_bg_addr & ADDR_SECT_MASK) != sec_addr) {
+		fs->gc_bg_addr = sec_addr + close_ate.offset;
+		fs->gc_bg_erased = 0;
+	}
+
+	for (int i = 0; (i < CONFIG_ZMS_GC_BACKGROUND_STEP) && (fs->gc_bg_addr != stop_addr); i++) {
+		gc_addr = fs->gc_bg_addr;
+		rc = zms_flash_ate_rd(fs, gc_addr, &gc_ate);
+		if (rc) {
+			break;
+		}
+
+		fs->sector_cycle = empty_ate.cycle_cnt;
+		rc = zms_gc_ate_needs_copy(fs, &gc_ate, gc_addr);
+		fs->sector_cycle = active_cycle;
+		if (rc < 0) {
+			break;
+		}
+
+		if (rc) {
+			required_space = fs->ate_size;
+			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
+				required_space += zms_al_size(fs, gc_ate.len);
+			}
+
+			/* Keep the room for a delete ATE, as zms_write() does */
+			if (!SECTOR_OFFSET(fs->ate_wra - fs->ate_size) ||
+			    (fs->ate_wra < (fs->data_wra + required_space))) {
+				LOG_DBG("No room left to copy %d in the background", gc_ate.id);
+				fs->gc_bg_addr = sec_addr;
+				rc = 0;
+				break;
+			}
+
+			rc = zms_gc_move_ate(fs, &gc_ate, gc_addr, active_cycle);
+			if (rc) {
+				break;
+			}
+		}
+
+		fs->gc_bg_addr += fs->ate_size;
+	}
+
+	return rc;
+}
+
+static void zms_gc_bg_work_handler(struct k_work *work)
+{
+	int rc;
+	struct zms_fs *fs = CONTAINER_OF(work, struct zms_fs, gc_work);
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	if (!fs->ready || !zms_gc_bg_pending(fs)) {
+		goto end;
+	}
+
+	rc = zms_gc_bg_step(fs);
+	if (rc) {
+		LOG_ERR("Background garbage collection failed, returned = %d", rc);
+		goto end;
+	}
+
+	/* Let the writers in between the steps */
+	if (zms_gc_bg_pending(fs)) {
+		k_work_submit_to_queue(&zms_gc_bg_work_q, work);
+	}
+
+end:
+	k_mutex_unlock(&fs->zms_lock);
+}
+
+static int zms_gc_bg_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "zms_gc"};
+
+	k_work_queue_init(&zms_gc_bg_work_q);
+	k_work_queue_start(&zms_gc_bg_work_q, zms_gc_bg_stack_area,
+			   K_THREAD_STACK_SIZEOF(zms_gc_bg_stack_area),
+			   CONFIG_ZMS_GC_BACKGROUND_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(zms_gc_bg_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_ZMS_GC_BACKGROUND */
+
+/* The background garbage collection moves the ATEs and changes fs->sector_cycle: when it is
+ * enabled, the lookups take the lock as the writes do.
+ */
+static inline void zms_lookup_lock(struct zms_fs *fs)
+{
+	if (IS_ENABLED(CONFIG_ZMS_GC_BACKGROUND)) {
+		k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	}
+}
+
+static inline void zms_lookup_unlock(struct zms_fs *fs)
+{
+	if (IS_ENABLED(CONFIG_ZMS_GC_BACKGROUND)) {
+		k_mutex_unlock(&fs->zms_lock);
+	}
+}
+
 int zms_clear(struct zms_fs *fs)
 {
 	int rc;
 	uint64_t addr;
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	struct k_work_sync sync;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("zms not initialized");
 		return -EACCES;
 	}
 
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 	for (uint32_t i = 0; i < fs->sector_count; i++) {
 		addr = (uint64_t)i << ADDR_SECT_SHIFT;
@@ -1060,6 +1423,96 @@ end:
 	return 0;
 }
 
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+/* Restore the lookup cache from the snapshot of the active sector and replay on top of it
+ * the ATEs written in this sector, instead of walking the ATEs of all the sectors.
+ * return 0 if OK, -ENOENT if there is no valid snapshot, errcode on flash error.
+ */
+static int zms_lookup_cache_restore(struct zms_fs *fs)
+{
+	int rc;
+	bool found = false;
+	uint64_t addr;
+	const uint64_t first_addr = zms_close_ate_addr(fs, fs->ate_wra) - fs->ate_size;
+	struct zms_ate ate;
+	struct zms_ate snapshot_ate;
+
+	/* Look for the snapshot, from the oldest to the newest ATE of the sector */
+	for (addr = first_addr; addr > fs->ate_wra; addr -= fs->ate_size) {
+		rc = zms_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+		if (zms_snapshot_ate_valid(fs, &ate)) {
+			snapshot_ate = ate;
+			found = true;
+		}
+	}
+
+	if (!found) {
+		return -ENOENT;
+	}
+
+	rc = zms_flash_rd(fs, (fs->ate_wra & ADDR_SECT_MASK) + snapshot_ate.offset,
+			  fs->lookup_cache, ZMS_SNAPSHOT_LEN);
+	if (rc) {
+		return rc;
+	}
+
+	if (crc32_ieee((const uint8_t *)fs->lookup_cache, ZMS_SNAPSHOT_LEN) !=
+	    snapshot_ate.data_crc) {
+		LOG_WRN("Invalid lookup cache snapshot");
+		return -ENOENT;
+	}
+
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	/* The oldest sector may have been erased in the background after the snapshot */
+	addr = fs->ate_wra & ADDR_SECT_MASK;
+	zms_sector_advance(fs, &addr);
+	zms_sector_advance(fs, &addr);
+	rc = zms_validate_closed_sector(fs, addr, &ate, &snapshot_ate);
+	if (rc < 0) {
+		return rc;
+	}
+	if (!rc) {
+		zms_lookup_cache_invalidate(fs, SECTOR_NUM(addr));
+	}
+#endif
+
+	for (addr = first_addr; addr > fs->ate_wra; addr -= fs->ate_size) {
+		rc = zms_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+		if (zms_ate_valid(fs, &ate) && (ate.id != ZMS_HEAD_ID)) {
+			fs->lookup_cache[zms_lookup_cache_pos(ate.id)] = addr;
+		}
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT */
+
+static int zms_lookup_cache_load(struct zms_fs *fs)
+{
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+	int rc;
+
+	rc = zms_lookup_cache_restore(fs);
+	if (rc != -ENOENT) {
+		return rc;
+	}
+
+	LOG_DBG("No lookup cache snapshot, rebuilding the cache");
+#endif
+
+	return zms_lookup_cache_rebuild(fs);
+}
+
+#endif /* CONFIG_ZMS_LOOKUP_CACHE */
+
 static int zms_init(struct zms_fs *fs)
 {
 	int rc;
@@ -1306,7 +1759,7 @@ static int zms_init(struct zms_fs *fs)
 end:
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	if (!rc) {
-		rc = zms_lookup_cache_rebuild(fs);
+		rc = zms_lookup_cache_load(fs);
 	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
@@ -1325,8 +1778,23 @@ int zms_mount(struct zms_fs *fs)
 	int rc;
 	struct flash_pages_info info;
 	size_t write_block_size;
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	if (fs->ready) {
+		/* Remount: wait for a running background step to complete */
+		k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+#endif
 
 	k_mutex_init(&fs->zms_lock);
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	k_work_init(&fs->gc_work, zms_gc_bg_work_handler);
+	fs->gc_bg_addr = ZMS_GC_BG_IDLE;
+#endif
+#ifdef CONFIG_ZMS_GC_STATS
+	memset(&fs->gc_stats, 0, sizeof(fs->gc_stats));
+#endif
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
 	if (fs->flash_parameters == NULL) {
@@ -1398,6 +1866,10 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	uint32_t gc_count;
 	uint32_t required_space = 0U; /* no space, appropriate for delete ate */
 	int prev_found = 0;
+#ifdef CONFIG_ZMS_GC_STATS
+	uint32_t start;
+	uint32_t stall_us;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("zms not initialized");
@@ -1416,6 +1888,12 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_ZMS_GC_STATS
+	start = k_cycle_get_32();
+#endif
+	/* The lock is taken again below for the write, k_mutex is recursive */
+	zms_lookup_lock(fs);
+
 	/* find latest entry with same id */
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
@@ -1431,7 +1909,8 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	/* Search for a previous valid ATE with the same ID */
 	prev_found = zms_find_ate_with_id(fs, id, wlk_addr, fs->ate_wra, &wlk_ate, &rd_addr);
 	if (prev_found < 0) {
-		return prev_found;
+		rc = prev_found;
+		goto end_lookup;
 	}
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
@@ -1450,7 +1929,8 @@ no_cached_entry:
 				/* skip delete entry as it is already the
 				 * last one
 				 */
-				return 0;
+				rc = 0;
+				goto end_lookup;
 			}
 		} else if (len == wlk_ate.len) {
 			/* do not try to compare if lengths are not equal */
@@ -1458,19 +1938,20 @@ no_cached_entry:
 			if (len <= ZMS_DATA_IN_ATE_SIZE) {
 				rc = memcmp(&wlk_ate.data, data, len);
 				if (!rc) {
-					return 0;
+					goto end_lookup;
 				}
 			} else {
 				rc = zms_flash_block_cmp(fs, rd_addr, data, len);
 				if (rc <= 0) {
-					return rc;
+					goto end_lookup;
 				}
 			}
 		}
 	} else {
 		/* skip delete entry for non-existing entry */
 		if (len == 0) {
-			return 0;
+			rc = 0;
+			goto end_lookup;
 		}
 	}
 
@@ -1521,11 +2002,32 @@ no_cached_entry:
 			LOG_ERR("Garbage collection failed, returned = %d", rc);
 			goto end;
 		}
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+		rc = zms_lookup_cache_snapshot(fs, required_space);
+		if (rc) {
+			LOG_ERR("Failed to write the lookup cache snapshot, returned = %d", rc);
+			goto end;
+		}
+#endif
 		gc_count++;
 	}
 	rc = len;
+
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	if (zms_gc_bg_pending(fs)) {
+		k_work_submit_to_queue(&zms_gc_bg_work_q, &fs->gc_work);
+	}
+#endif
 end:
+#ifdef CONFIG_ZMS_GC_STATS
+	stall_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	if (stall_us > fs->gc_stats.max_stall_us) {
+		fs->gc_stats.max_stall_us = stall_us;
+	}
+#endif
 	k_mutex_unlock(&fs->zms_lock);
+end_lookup:
+	zms_lookup_unlock(fs);
 	return rc;
 }
 
@@ -1554,12 +2056,14 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 
 	cnt_his = 0U;
 
+	zms_lookup_lock(fs);
+
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
-		goto err;
+		goto end;
 	}
 #else
 	wlk_addr = fs->ate_wra;
@@ -1571,7 +2075,8 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 		prev_found = zms_find_ate_with_id(fs, id, wlk_addr, fs->ate_wra, &wlk_ate,
 						  &wlk_prev_addr);
 		if (prev_found < 0) {
-			return prev_found;
+			rc = prev_found;
+			goto end;
 		}
 		if (prev_found) {
 			cnt_his++;
@@ -1583,7 +2088,7 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 			 */
 			rc = zms_compute_prev_addr(fs, &wlk_prev_addr);
 			if (rc) {
-				return rc;
+				goto end;
 			}
 			/* wlk_addr will be the start research address in the next loop */
 			wlk_addr = wlk_prev_addr;
@@ -1593,7 +2098,8 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 	}
 
 	if (((!prev_found) || (wlk_ate.id != id)) || (wlk_ate.len == 0U) || (cnt_his < cnt)) {
-		return -ENOENT;
+		rc = -ENOENT;
+		goto end;
 	}
 
 	if (wlk_ate.len <= ZMS_DATA_IN_ATE_SIZE) {
@@ -1608,7 +2114,7 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 		if (data) {
 			rc = zms_flash_rd(fs, rd_addr, data, MIN(len, wlk_ate.len));
 			if (rc) {
-				goto err;
+				goto end;
 			}
 		}
 #ifdef CONFIG_ZMS_DATA_CRC
@@ -1619,15 +2125,17 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 				LOG_ERR("Invalid data CRC: ATE_CRC=0x%08X, "
 					"computed_data_crc=0x%08X",
 					wlk_ate.data_crc, computed_data_crc);
-				return -EIO;
+				rc = -EIO;
+				goto end;
 			}
 		}
 #endif
 	}
 
-	return wlk_ate.len;
+	rc = wlk_ate.len;
 
-err:
+end:
+	zms_lookup_unlock(fs);
 	return rc;
 }
 
@@ -1653,7 +2161,7 @@ ssize_t zms_get_data_length(struct zms_fs *fs, uint32_t id)
 	return rc;
 }
 
-ssize_t zms_calc_free_space(struct zms_fs *fs)
+static ssize_t zms_free_space_walk(struct zms_fs *fs)
 {
 	int rc;
 	int previous_sector_num = ZMS_INVALID_SECTOR_NUM;
@@ -1672,11 +2180,6 @@ ssize_t zms_calc_free_space(struct zms_fs *fs)
 	ssize_t free_space = 0;
 	const uint32_t second_to_last_offset = (2 * fs->ate_size);
 
-	if (!fs->ready) {
-		LOG_ERR("zms not initialized");
-		return -EACCES;
-	}
-
 	/*
 	 * There is always a closing ATE , an empty ATE, a GC_done ATE and a reserved ATE for
 	 * deletion in each sector.
@@ -1768,6 +2271,22 @@ ssize_t zms_calc_free_space(struct zms_fs *fs)
 	return free_space;
 }
 
+ssize_t zms_calc_free_space(struct zms_fs *fs)
+{
+	ssize_t free_space;
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+	zms_lookup_lock(fs);
+	free_space = zms_free_space_walk(fs);
+	zms_lookup_unlock(fs);
+
+	return free_space;
+}
+
 size_t zms_active_sector_free_space(struct zms_fs *fs)
 {
 	if (!fs->ready) {
@@ -1795,8 +2314,34 @@ int zms_sector_use_next(struct zms_fs *fs)
 	}
 
 	ret = zms_gc(fs);
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+	if (ret == 0) {
+		ret = zms_lookup_cache_snapshot(fs, 0U);
+	}
+#endif
 
 end:
 	k_mutex_unlock(&fs->zms_lock);
 	return ret;
 }
+
+int zms_gc_stats_get(struct zms_fs *fs, struct zms_gc_stats *stats)
+{
+#ifdef CONFIG_ZMS_GC_STATS
+	if (!fs->ready) {
+		LOG_ERR("ZMS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	*stats = fs->gc_stats;
+	k_mutex_unlock(&fs->zms_lock);
+
+	return 0;
+#else
+	ARG_UNUSED(fs);
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif
+}
@@ -31,6 +31,7 @@ extern "C" {
 #endif
 
 #define ZMS_LOOKUP_CACHE_NO_ADDR GENMASK64(63, 0)
+#define ZMS_GC_BG_IDLE           GENMASK64(63, 0)
 #define ZMS_HEAD_ID              GENMASK(31, 0)
 
 #define ZMS_VERSION_MASK        GENMASK(7, 0)
@@ -59,10 +59,30 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+#define NET_CONN_PORT_TABLE_SIZE	BIT(CONFIG_NET_CONN_PORT_HASH_BITS)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
-static sys_slist_t conn_used;
+
+/* Connections in use are kept on one of three kinds of chains:
+ * - UDP/TCP handlers bound to a local port, hashed by that port,
+ * - UDP/TCP handlers not bound to a port, which match any port,
+ * - raw packet and CAN handlers.
+ * An IP packet only needs to be matched against the chain of its
+ * destination port and the wildcard chain.
+ */
+static sys_slist_t conn_ports[NET_CONN_PORT_TABLE_SIZE];
+static sys_slist_t conn_wildcard;
+static sys_slist_t conn_raw;
+
+/* Iterator over the chains of connections that may match a packet */
+struct conn_walk {
+	sys_snode_t *node;
+	uint16_t port;
+	uint16_t chain;
+	bool all;
+};
 
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
@@ -116,6 +136,82 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static sys_slist_t *conn_port_chain(uint16_t port)
+{
+	uint16_t p = ntohs(port);
+
+	if (p == 0U) {
+		return &conn_wildcard;
+	}
+
+	return &conn_ports[(p ^ (p >> 8)) & (NET_CONN_PORT_TABLE_SIZE - 1)];
+}
+
+static sys_slist_t *conn_chain_of(uint8_t family, uint16_t local_port)
+{
+	if (family == AF_INET || family == AF_INET6 || family == AF_UNSPEC) {
+		return conn_port_chain(local_port);
+	}
+
+	return &conn_raw;
+}
+
+/* Returns the chains to walk in turn: for IP packets, the destination
+ * port's and the wildcard one, otherwise all of them.
+ */
+static sys_slist_t *conn_walk_chain(struct conn_walk *walk)
+{
+	uint16_t chain = walk->chain++;
+
+	if (!walk->all) {
+		if (chain == 0U) {
+			return conn_port_chain(walk->port);
+		}
+
+		return (chain == 1U) ? &conn_wildcard : NULL;
+	}
+
+	if (chain == 0U) {
+		return &conn_raw;
+	}
+
+	if (chain == 1U) {
+		return &conn_wildcard;
+	}
+
+	return (chain - 2U < NET_CONN_PORT_TABLE_SIZE) ?
+		&conn_ports[chain - 2U] : NULL;
+}
+
+static void conn_walk_init(struct conn_walk *walk, bool all, uint16_t port)
+{
+	walk->node = NULL;
+	walk->port = port;
+	/* Without a port, the port chain is the wildcard one */
+	walk->chain = (!all && port == 0U) ? 1U : 0U;
+	walk->all = all;
+}
+
+static struct net_conn *conn_walk_next(struct conn_walk *walk)
+{
+	sys_slist_t *chain;
+
+	if (walk->node != NULL) {
+		walk->node = sys_slist_peek_next(walk->node);
+	}
+
+	while (walk->node == NULL) {
+		chain = conn_walk_chain(walk);
+		if (chain == NULL) {
+			return NULL;
+		}
+
+		walk->node = sys_slist_peek_head(chain);
+	}
+
+	return CONTAINER_OF(walk->node, struct net_conn, node);
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -140,7 +236,9 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_chain_of(conn->family,
+					net_sin(&conn->local_addr)->sin_port),
+			  &conn->node);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -167,7 +265,9 @@ static struct net_conn *conn_find_handler(struct net_if *iface,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+	/* Only the handlers of the same local port can be identical */
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(conn_chain_of(family, htons(local_port)),
+					  conn, tmp, node) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -451,7 +551,9 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_chain_of(conn->family,
+						net_sin(&conn->local_addr)->sin_port),
+				  &conn->node);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -689,6 +791,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
 	struct net_conn *conn;
+	struct conn_walk walk;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
 
@@ -708,9 +811,17 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	/* IP packets can only match handlers bound to their destination
+	 * port or to no port at all, other packets are matched against all.
+	 */
+	conn_walk_init(&walk,
+		       !(IS_ENABLED(CONFIG_NET_IP) &&
+			 (pkt_family == AF_INET || pkt_family == AF_INET6)),
+		       dst_port);
+
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	for (conn = conn_walk_next(&walk); conn != NULL; conn = conn_walk_next(&walk)) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -948,10 +1059,13 @@ drop:
 void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 {
 	struct net_conn *conn;
+	struct conn_walk walk;
+
+	conn_walk_init(&walk, true, 0U);
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	for (conn = conn_walk_next(&walk); conn != NULL; conn = conn_walk_next(&walk)) {
 		cb(conn, user_data);
 	}
 
@@ -963,7 +1077,12 @@ void net_conn_init(void)
 	int i;
 
 	sys_slist_init(&conn_unused);
-	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+	sys_slist_init(&conn_raw);
+
+	for (i = 0; i < NET_CONN_PORT_TABLE_SIZE; i++) {
+		sys_slist_init(&conn_ports[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -139,6 +139,399 @@ bool net_context_is_timestamping_set(struct net_context *context)
 #endif
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Send that a zero-copy buffer belongs to. Only the last buffer of a send
+ * notifies its completion, the network stack releasing the buffers of a
+ * packet in order.
+ */
+struct zerocopy_buf_ud {
+	struct net_context *context;
+	uint32_t gen;
+	uint32_t id;
+	bool notify;
+};
+
+static void zerocopy_buf_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(zerocopy_bufs, CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT,
+			  0, sizeof(struct zerocopy_buf_ud), zerocopy_buf_destroy);
+
+/* Buffers are released from any thread, possibly after their context was
+ * put and reused, so a single lock protects the completions of all contexts
+ * and the generation tells apart the sends of the previous user.
+ */
+static struct k_spinlock zerocopy_lock;
+static uint32_t zerocopy_gen;
+
+static void zerocopy_init(struct net_context *context)
+{
+	k_spinlock_key_t key = k_spin_lock(&zerocopy_lock);
+
+	(void)memset(&context->zerocopy, 0, sizeof(context->zerocopy));
+	k_poll_signal_init(&context->zerocopy.signal);
+	context->zerocopy.gen = ++zerocopy_gen;
+
+	k_spin_unlock(&zerocopy_lock, key);
+}
+
+/* Room for the completion was reserved by zerocopy_full() */
+static void zerocopy_complete(struct net_context *context, uint32_t id,
+			      bool copied)
+{
+	uint8_t count = context->zerocopy.count;
+	uint8_t idx;
+
+	if (count > 0) {
+		idx = (context->zerocopy.head + count - 1) %
+		      CONFIG_NET_CONTEXT_ZEROCOPY_MAX_PENDING;
+
+		if (context->zerocopy.done[idx].copied == copied &&
+		    context->zerocopy.done[idx].hi + 1 == id) {
+			context->zerocopy.done[idx].hi = id;
+			goto out;
+		}
+	}
+
+	idx = (context->zerocopy.head + count) %
+	      CONFIG_NET_CONTEXT_ZEROCOPY_MAX_PENDING;
+
+	context->zerocopy.done[idx].lo = id;
+	context->zerocopy.done[idx].hi = id;
+	context->zerocopy.done[idx].copied = copied;
+	context->zerocopy.count++;
+
+out:
+	k_poll_signal_raise(&context->zerocopy.signal, 0);
+	net_context_notify(context);
+}
+
+static void zerocopy_buf_destroy(struct net_buf *buf)
+{
+	struct zerocopy_buf_ud *ud = net_buf_user_data(buf);
+	k_spinlock_key_t key;
+
+	if (ud->notify) {
+		key = k_spin_lock(&zerocopy_lock);
+
+		if (ud->context->zerocopy.gen == ud->gen) {
+			ud->context->zerocopy.pending--;
+			zerocopy_complete(ud->context, ud->id, false);
+		}
+
+		k_spin_unlock(&zerocopy_lock, key);
+	}
+
+	net_buf_destroy(buf);
+}
+
+static bool zerocopy_requested(struct net_context *context, int flags)
+{
+	return (flags & ZSOCK_MSG_ZEROCOPY) && context->options.zerocopy;
+}
+
+static bool zerocopy_full(struct net_context *context)
+{
+	k_spinlock_key_t key = k_spin_lock(&zerocopy_lock);
+	bool full;
+
+	full = context->zerocopy.pending + context->zerocopy.count >=
+	       CONFIG_NET_CONTEXT_ZEROCOPY_MAX_PENDING;
+
+	k_spin_unlock(&zerocopy_lock, key);
+
+	return full;
+}
+
+static struct net_buf *zerocopy_frag_alloc(struct net_context *context,
+					   const void *data, size_t len)
+{
+	struct zerocopy_buf_ud *ud;
+	struct net_buf *frag;
+
+	frag = net_buf_alloc_with_data(&zerocopy_bufs, (void *)data, len,
+				       K_NO_WAIT);
+	if (frag == NULL) {
+		return NULL;
+	}
+
+	ud = net_buf_user_data(frag);
+	ud->context = context;
+	ud->gen = context->zerocopy.gen;
+	ud->notify = false;
+
+	return frag;
+}
+
+int net_context_zerocopy_wrap(struct net_context *context, const void *data,
+			      size_t len, const struct msghdr *msg,
+			      struct net_buf **frags)
+{
+	struct zerocopy_buf_ud *ud;
+	struct net_buf *frag;
+	k_spinlock_key_t key;
+	size_t iov_len;
+
+	*frags = NULL;
+
+	if (len == 0) {
+		return -ENODATA;
+	}
+
+	if (msg == NULL) {
+		*frags = zerocopy_frag_alloc(context, data, len);
+		if (*frags == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	for (int i = 0; msg != NULL && i < msg->msg_iovlen && len > 0; i++) {
+		iov_len = MIN(msg->msg_iov[i].iov_len, len);
+		if (iov_len == 0) {
+			continue;
+		}
+
+		frag = zerocopy_frag_alloc(context, msg->msg_iov[i].iov_base,
+					   iov_len);
+		if (frag == NULL) {
+			if (*frags != NULL) {
+				net_buf_unref(*frags);
+				*frags = NULL;
+			}
+
+			return -ENOMEM;
+		}
+
+		if (*frags == NULL) {
+			*frags = frag;
+		} else {
+			net_buf_frag_insert(net_buf_frag_last(*frags), frag);
+		}
+
+		len -= iov_len;
+	}
+
+	if (*frags == NULL) {
+		return -ENODATA;
+	}
+
+	ud = net_buf_user_data(net_buf_frag_last(*frags));
+
+	key = k_spin_lock(&zerocopy_lock);
+
+	ud->id = context->zerocopy.next_id++;
+	ud->notify = true;
+	context->zerocopy.pending++;
+
+	k_spin_unlock(&zerocopy_lock, key);
+
+	return 0;
+}
+
+/* Forget a send whose buffers are released without being sent */
+static void zerocopy_unwrap(struct net_context *context, struct net_buf *frags)
+{
+	struct zerocopy_buf_ud *ud = net_buf_user_data(net_buf_frag_last(frags));
+	k_spinlock_key_t key = k_spin_lock(&zerocopy_lock);
+
+	ud->notify = false;
+	context->zerocopy.next_id--;
+	context->zerocopy.pending--;
+
+	k_spin_unlock(&zerocopy_lock, key);
+}
+
+void net_context_zerocopy_copied(struct net_context *context)
+{
+	k_spinlock_key_t key = k_spin_lock(&zerocopy_lock);
+
+	zerocopy_complete(context, context->zerocopy.next_id++, true);
+
+	k_spin_unlock(&zerocopy_lock, key);
+}
+
+/* Datagrams are sent without copy only when they fit in a single packet */
+static bool zerocopy_udp_fits(struct net_context *context, sa_family_t family,
+			      size_t len)
+{
+	struct net_if *iface = net_context_get_iface(context);
+	size_t hdr_len = NET_UDPH_LEN;
+
+	if (iface == NULL) {
+		return false;
+	}
+
+	hdr_len += family == AF_INET6 ? NET_IPV6H_LEN : NET_IPV4H_LEN;
+
+	return len + hdr_len <= net_if_get_mtu(iface);
+}
+
+int net_context_get_zerocopy_completion(struct net_context *context,
+					uint32_t *lo, uint32_t *hi,
+					bool *copied)
+{
+	k_spinlock_key_t key = k_spin_lock(&zerocopy_lock);
+	uint8_t head = context->zerocopy.head;
+	int ret = 0;
+
+	if (context->zerocopy.count == 0) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	*lo = context->zerocopy.done[head].lo;
+	*hi = context->zerocopy.done[head].hi;
+	*copied = context->zerocopy.done[head].copied;
+
+	context->zerocopy.head = (head + 1) % CONFIG_NET_CONTEXT_ZEROCOPY_MAX_PENDING;
+	context->zerocopy.count--;
+
+	if (context->zerocopy.count == 0) {
+		k_poll_signal_reset(&context->zerocopy.signal);
+	}
+
+out:
+	k_spin_unlock(&zerocopy_lock, key);
+
+	return ret;
+}
+
+bool net_context_has_zerocopy_completion(struct net_context *context)
+{
+	return context->zerocopy.count > 0;
+}
+#else
+static inline void zerocopy_init(struct net_context *context)
+{
+	ARG_UNUSED(context);
+}
+
+static inline bool zerocopy_requested(struct net_context *context, int flags)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(flags);
+
+	return false;
+}
+
+static inline bool zerocopy_full(struct net_context *context)
+{
+	ARG_UNUSED(context);
+
+	return false;
+}
+
+static inline void zerocopy_unwrap(struct net_context *context,
+				   struct net_buf *frags)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(frags);
+}
+
+static inline bool zerocopy_udp_fits(struct net_context *context,
+				     sa_family_t family, size_t len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(family);
+	ARG_UNUSED(len);
+
+	return false;
+}
+
+int net_context_get_zerocopy_completion(struct net_context *context,
+					uint32_t *lo, uint32_t *hi,
+					bool *copied)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(lo);
+	ARG_UNUSED(hi);
+	ARG_UNUSED(copied);
+
+	return -ENOTSUP;
+}
+
+bool net_context_has_zerocopy_completion(struct net_context *context)
+{
+	ARG_UNUSED(context);
+
+	return false;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
+#if defined(CONFIG_NET_CONTEXT_WATCH)
+/* Protects the watchers lists of all the contexts */
+static struct k_spinlock watchers_lock;
+
+int net_context_watch(struct net_context *context,
+		      struct net_context_watcher *watcher)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&watchers_lock);
+
+	if (!net_context_is_used(context)) {
+		ret = -EBADF;
+		goto out;
+	}
+
+	sys_slist_append(&context->watchers, &watcher->node);
+
+out:
+	k_spin_unlock(&watchers_lock, key);
+
+	return ret;
+}
+
+void net_context_unwatch(struct net_context *context,
+			 struct net_context_watcher *watcher)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&watchers_lock);
+	(void)sys_slist_find_and_remove(&context->watchers, &watcher->node);
+	k_spin_unlock(&watchers_lock, key);
+}
+
+void net_context_notify(struct net_context *context)
+{
+	struct net_context_watcher *watcher;
+	k_spinlock_key_t key;
+
+	if (sys_slist_is_empty(&context->watchers)) {
+		return;
+	}
+
+	key = k_spin_lock(&watchers_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&context->watchers, watcher, node) {
+		watcher->cb(watcher, false);
+	}
+
+	k_spin_unlock(&watchers_lock, key);
+}
+
+static void release_watchers(struct net_context *context)
+{
+	struct net_context_watcher *watcher;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&watchers_lock);
+
+	while ((node = sys_slist_get(&context->watchers)) != NULL) {
+		watcher = CONTAINER_OF(node, struct net_context_watcher, node);
+		watcher->cb(watcher, true);
+	}
+
+	k_spin_unlock(&watchers_lock, key);
+}
+#else
+static inline void release_watchers(struct net_context *context)
+{
+	ARG_UNUSED(context);
+}
+#endif /* CONFIG_NET_CONTEXT_WATCH */
+
 #if defined(CONFIG_NET_UDP) || defined(CONFIG_NET_TCP)
 static inline bool is_in_tcp_listen_state(struct net_context *context)
 {
@@ -542,6 +935,7 @@ int net_context_get(sa_family_t family, enum net_sock_type type, uint16_t proto,
 		}
 
 		k_mutex_init(&contexts[i].lock);
+		zerocopy_init(&contexts[i]);
 
 		contexts[i].flags |= NET_CONTEXT_IN_USE;
 		*context = &contexts[i];
@@ -623,6 +1017,11 @@ int net_context_put(struct net_context *context)
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
+	/* The application is done with the context, whatever the stack
+	 * still has to do with it.
+	 */
+	release_watchers(context);
+
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
 		context->flags &= ~NET_CONTEXT_IN_USE;
@@ -1771,12 +2170,29 @@ static int get_context_timestamping(struct net_context *context,
 #endif
 }
 
+static int get_context_zerocopy(struct net_context *context,
+				void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	return get_bool_option(context->options.zerocopy, value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. If sum is set, the data is summed in the same
+ * pass, starting at offset 0 of the checksummed area.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      uint16_t *sum)
 {
+	size_t offset = 0;
 	int ret = 0;
 
 	if (msghdr) {
@@ -1785,17 +2201,27 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
 			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
 
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    len);
+			if (sum) {
+				ret = net_pkt_write_chksum(pkt,
+							   msghdr->msg_iov[i].iov_base,
+							   len, offset, sum);
+			} else {
+				ret = net_pkt_write(pkt,
+						    msghdr->msg_iov[i].iov_base,
+						    len);
+			}
 			if (ret < 0) {
 				break;
 			}
 
+			offset += len;
 			buf_len -= len;
 			if (buf_len == 0) {
 				break;
 			}
 		}
+	} else if (sum) {
+		ret = net_pkt_write_chksum(pkt, buf, buf_len, offset, sum);
 	} else {
 		ret = net_pkt_write(pkt, buf, buf_len);
 	}
@@ -1810,7 +2236,8 @@ static int context_setup_udp_packet(struct net_context *context,
 				    size_t len,
 				    const struct msghdr *msg,
 				    const struct sockaddr *dst_addr,
-				    socklen_t addrlen)
+				    socklen_t addrlen,
+				    struct net_buf *frags)
 {
 	int ret = -EINVAL;
 	uint16_t dst_port = 0U;
@@ -1848,9 +2275,30 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
-	if (ret) {
-		return ret;
+	if (frags != NULL) {
+		/* The payload references the data, drop the buffer space
+		 * that was left for it after the headers.
+		 */
+		net_pkt_trim_buffer(pkt);
+		net_pkt_append_buffer(pkt, frags);
+	} else if (IS_ENABLED(CONFIG_NET_UDP_TX_CHKSUM_COPY) &&
+		   net_if_need_calc_tx_checksum(net_pkt_iface(pkt),
+					 family == AF_INET6 ?
+					 NET_IF_CHECKSUM_IPV6_UDP :
+					 NET_IF_CHECKSUM_IPV4_UDP)) {
+		uint16_t sum = 0U;
+
+		ret = context_write_data(pkt, buf, len, msg, &sum);
+		if (ret) {
+			return ret;
+		}
+
+		net_pkt_set_data_chksum(pkt, sum);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg, NULL);
+		if (ret) {
+			return ret;
+		}
 	}
 
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
@@ -1945,9 +2393,13 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  int flags)
 {
 	const struct msghdr *msghdr = NULL;
+	struct net_buf *zc_frags = NULL;
+	bool zc_attached = false;
+	bool zerocopy = false;
 	struct net_if *iface;
 	struct net_pkt *pkt = NULL;
 	sa_family_t family;
@@ -2180,6 +2632,15 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
+	if (zerocopy_requested(context, flags)) {
+		/* Each send needs room for its completion */
+		if (zerocopy_full(context)) {
+			return -ENOBUFS;
+		}
+
+		zerocopy = true;
+	}
+
 	context->send_cb = cb;
 	context->user_data = user_data;
 
@@ -2189,15 +2650,26 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY) && zerocopy &&
+	    net_context_get_proto(context) == IPPROTO_UDP &&
+	    !net_if_is_ip_offloaded(net_context_get_iface(context)) &&
+	    zerocopy_udp_fits(context, family, len)) {
+		/* The data is copied when out of zero-copy buffers */
+		(void)net_context_zerocopy_wrap(context, buf, len, msghdr,
+						&zc_frags);
+	}
+
+	pkt = context_alloc_pkt(context, family, zc_frags ? 0 : len,
+				PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
-		return -ENOBUFS;
+		ret = -ENOBUFS;
+		goto fail;
 	}
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (zc_frags == NULL && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -2231,7 +2703,7 @@ static int context_sendto(struct net_context *context,
 skip_alloc:
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2249,27 +2721,31 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       dst_addr, addrlen, zc_frags);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		zc_attached = zc_frags != NULL;
+
 		context_finalize_packet(context, family, pkt);
 
 		ret = net_send_data(pkt);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr, zerocopy);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		/* TCP reports the completion, as it decides whether to copy */
+		zerocopy = false;
 		len = ret;
 
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && family == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2299,7 +2775,7 @@ skip_alloc:
 		}
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN &&
 		   net_context_get_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2317,8 +2793,20 @@ skip_alloc:
 		goto fail;
 	}
 
+	if (zerocopy && zc_frags == NULL) {
+		net_context_zerocopy_copied(context);
+	}
+
 	return len;
 fail:
+	if (zc_frags != NULL) {
+		zerocopy_unwrap(context, zc_frags);
+
+		if (!zc_attached) {
+			net_buf_unref(zc_frags);
+		}
+	}
+
 	if (pkt != NULL) {
 		net_pkt_unref(pkt);
 	}
@@ -2362,7 +2850,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, 0);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2381,13 +2869,41 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, flags);
 
 	k_mutex_unlock(&context->lock);
 
 	return ret;
 }
 
+int net_context_sendmmsg(struct net_context *context,
+			 struct mmsghdr *msgvec,
+			 unsigned int vlen,
+			 int flags,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data)
+{
+	unsigned int i;
+	int ret = 0;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = context_sendto(context, &msgvec[i].msg_hdr, 0, NULL, 0,
+				     cb, timeout, user_data, true, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(&context->lock);
+
+	return i > 0 ? (int)i : ret;
+}
+
 int net_context_sendto(struct net_context *context,
 		       const void *buf,
 		       size_t len,
@@ -2402,7 +2918,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, 0);
 
 	k_mutex_unlock(&context->lock);
 
@@ -3103,6 +3619,20 @@ static int set_context_timestamping(struct net_context *context,
 #endif
 }
 
+static int set_context_zerocopy(struct net_context *context,
+				const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	return set_bool_option(&context->options.zerocopy, value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -3172,6 +3702,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_TIMESTAMPING:
 		ret = set_context_timestamping(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = set_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -3248,6 +3781,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_TIMESTAMPING:
 		ret = get_context_timestamping(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = get_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
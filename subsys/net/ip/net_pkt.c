@@ -1730,7 +1730,8 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
-				  bool copy, bool write)
+				  bool copy, bool write,
+				  size_t offset, uint16_t *sum)
 {
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
@@ -1761,7 +1762,15 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			len = d_len;
 		}
 
-		if (copy && data) {
+		if (copy && data && sum) {
+			/* Data at an odd offset straddles the 16-bit words */
+			uint16_t s = (offset % 2) ? BSWAP_16(*sum) : *sum;
+
+			s = calc_chksum_copy(s, write ? c_op->pos : data,
+					     write ? data : c_op->pos, len);
+			*sum = (offset % 2) ? BSWAP_16(s) : s;
+			offset += len;
+		} else if (copy && data) {
 			memcpy(write ? c_op->pos : data,
 			       write ? data : c_op->pos,
 			       len);
@@ -1794,21 +1803,21 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
-	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
+	return net_pkt_cursor_operate(pkt, NULL, skip, false, true, 0, NULL);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
-	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
+	return net_pkt_cursor_operate(pkt, &byte, amount, false, true, 0, NULL);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	return net_pkt_cursor_operate(pkt, data, length, true, false);
+	return net_pkt_cursor_operate(pkt, data, length, true, false, 0, NULL);
 }
 
 int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
@@ -1855,7 +1864,17 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 		return net_pkt_skip(pkt, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      0, NULL);
+}
+
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 size_t offset, uint16_t *sum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      offset, sum);
 }
 
 int net_pkt_copy(struct net_pkt *pkt_dst,
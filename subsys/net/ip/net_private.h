@@ -71,6 +71,33 @@ extern int net_icmp_call_ipv6_handlers(struct net_pkt *pkt,
 
 extern struct net_if *net_ipip_get_virtual_interface(struct net_if *input_iface);
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+int net_context_zerocopy_wrap(struct net_context *context, const void *data,
+			      size_t len, const struct msghdr *msg,
+			      struct net_buf **frags);
+void net_context_zerocopy_copied(struct net_context *context);
+#else
+static inline int net_context_zerocopy_wrap(struct net_context *context,
+					    const void *data, size_t len,
+					    const struct msghdr *msg,
+					    struct net_buf **frags)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(msg);
+
+	*frags = NULL;
+
+	return -ENOTSUP;
+}
+
+static inline void net_context_zerocopy_copied(struct net_context *context)
+{
+	ARG_UNUSED(context);
+}
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_SERVICE)
 extern void socket_service_init(void);
 #else
@@ -254,8 +281,24 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
+extern uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst,
+				 const uint8_t *src, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Calculate the checksum of a transport packet whose data is already
+ *        summed, as computed by net_pkt_write_chksum()
+ *
+ * @param pkt		Network packet, with the IP header
+ * @param proto		Transport protocol
+ * @param hdr_len	Length of the transport header, summed from the packet
+ * @param data_sum	Sum of the data following the transport header
+ *
+ * @return Checksum to put in the transport header
+ */
+extern uint16_t net_calc_chksum_data(struct net_pkt *pkt, uint8_t proto,
+				     size_t hdr_len, uint16_t data_sum);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -309,7 +352,14 @@ static inline uint16_t net_calc_chksum_icmpv4(struct net_pkt *pkt)
 
 static inline uint16_t net_calc_chksum_udp(struct net_pkt *pkt)
 {
-	uint16_t chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	uint16_t chksum;
+
+	if (net_pkt_has_data_chksum(pkt)) {
+		chksum = net_calc_chksum_data(pkt, IPPROTO_UDP, NET_UDPH_LEN,
+					      net_pkt_data_chksum(pkt));
+	} else {
+		chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	}
 
 	return chksum == 0U ? 0xffff : chksum;
 }
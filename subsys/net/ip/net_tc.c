@@ -13,10 +13,13 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
@@ -32,6 +35,16 @@ K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
+#if defined(CONFIG_NET_TC_RX_FLOW_QUEUES)
+#define NET_TC_RX_FLOW_QUEUES CONFIG_NET_TC_RX_FLOW_QUEUES
+#else
+#define NET_TC_RX_FLOW_QUEUES 1
+#endif
+
+/* Stacks for the RX flow queues of traffic class 0, besides its own queue */
+K_KERNEL_STACK_ARRAY_DEFINE(rx_flow_stack, NET_TC_RX_FLOW_QUEUES - 1,
+			    CONFIG_NET_RX_STACK_SIZE);
+
 #if NET_TC_TX_COUNT > 0
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
@@ -40,6 +53,10 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
 #endif
 
+#if NET_TC_RX_FLOW_QUEUES > 1
+static struct net_traffic_class rx_flows[NET_TC_RX_FLOW_QUEUES - 1];
+#endif
+
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
 static void submit_to_queue(struct k_fifo *queue, struct net_pkt *pkt)
 {
@@ -60,11 +77,157 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if NET_TC_RX_FLOW_QUEUES > 1
+static uint32_t flow_hash_mix(uint32_t hash, uint32_t value)
+{
+	hash = (hash ^ value) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+/* L2s which hand raw IP packets to the stack. The frames of other L2s, for
+ * instance IEEE 802.15.4 with 6LoWPAN, cannot be parsed before L2 processing.
+ */
+static bool rx_flow_l2_is_raw_ip(struct net_if *iface)
+{
+	const struct net_l2 *l2 = net_if_l2(iface);
+
+	ARG_UNUSED(l2);
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (l2 == &NET_L2_GET_NAME(DUMMY)) {
+		return true;
+	}
+#endif
+#if defined(CONFIG_NET_L2_OPENTHREAD)
+	if (l2 == &NET_L2_GET_NAME(OPENTHREAD)) {
+		return true;
+	}
+#endif
+
+	return false;
+}
+
+/* Hash the addresses, protocol and ports of a received IP packet. IP
+ * fragments and IPv6 packets with extension headers hash on what is known of
+ * them, which keeps each flow on a single queue. Packets which are not IP, or
+ * come from an L2 whose frames cannot be parsed here, all hash to 0 so that
+ * they stay on the first queue, in order.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct net_pkt_cursor backup;
+	uint8_t hdr[NET_IPV6H_LEN];
+	const uint8_t *addrs;
+	bool has_ports = false;
+	uint16_t type = 0U;
+	uint32_t ports = 0U;
+	uint32_t hash = 0U;
+	size_t addrs_len;
+	size_t opts_len = 0U;
+	uint8_t proto;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) &&
+	    net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		if (net_pkt_skip(pkt, 2 * sizeof(struct net_eth_addr)) ||
+		    net_pkt_read_be16(pkt, &type)) {
+			goto out;
+		}
+
+		if (type == NET_ETH_PTYPE_VLAN &&
+		    (net_pkt_skip(pkt, sizeof(uint16_t)) ||
+		     net_pkt_read_be16(pkt, &type))) {
+			goto out;
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			goto out;
+		}
+	} else if (!rx_flow_l2_is_raw_ip(iface)) {
+		goto out;
+	}
+
+	if (net_pkt_read(pkt, hdr, NET_IPV4H_LEN)) {
+		goto out;
+	}
+
+	if ((hdr[0] >> 4) == 4) {
+		struct net_ipv4_hdr *ipv4 = (struct net_ipv4_hdr *)hdr;
+		size_t hdr_len = (ipv4->vhl & NET_IPV4_IHL_MASK) * 4U;
+
+		proto = ipv4->proto;
+		addrs = ipv4->src;
+		addrs_len = 2 * sizeof(struct in_addr);
+
+		/* Only the first fragment holds the ports */
+		if (!(sys_get_be16(ipv4->offset) &
+		      (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) &&
+		    hdr_len >= NET_IPV4H_LEN) {
+			opts_len = hdr_len - NET_IPV4H_LEN;
+			has_ports = true;
+		}
+	} else if ((hdr[0] >> 4) == 6) {
+		struct net_ipv6_hdr *ipv6 = (struct net_ipv6_hdr *)hdr;
+
+		if (net_pkt_read(pkt, hdr + NET_IPV4H_LEN,
+				 NET_IPV6H_LEN - NET_IPV4H_LEN)) {
+			goto out;
+		}
+
+		proto = ipv6->nexthdr;
+		addrs = ipv6->src;
+		addrs_len = 2 * sizeof(struct in6_addr);
+		has_ports = true;
+	} else {
+		goto out;
+	}
+
+	for (size_t i = 0; i < addrs_len; i += sizeof(uint32_t)) {
+		hash = flow_hash_mix(hash, sys_get_be32(&addrs[i]));
+	}
+
+	if (has_ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_skip(pkt, opts_len)) {
+		(void)net_pkt_read_be32(pkt, &ports);
+	}
+
+	hash = flow_hash_mix(hash, ports);
+	hash = flow_hash_mix(hash, proto);
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return hash;
+}
+
+static struct k_fifo *rx_flow_queue(struct net_pkt *pkt)
+{
+	uint32_t queue = rx_flow_hash(pkt) % NET_TC_RX_FLOW_QUEUES;
+
+	if (queue == 0U) {
+		return &rx_classes[0].fifo;
+	}
+
+	return &rx_flows[queue - 1].fifo;
+}
+#endif
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
+#if NET_TC_RX_FLOW_QUEUES > 1
+	if (tc == 0U) {
+		submit_to_queue(rx_flow_queue(pkt), pkt);
+		return;
+	}
+#endif
+
 	submit_to_queue(&rx_classes[tc].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
@@ -279,6 +442,69 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 }
 #endif
 
+#if NET_TC_RX_COUNT > 0
+static void rx_flow_pin(k_tid_t tid, int queue)
+{
+#if defined(CONFIG_NET_TC_RX_FLOW_CPU_PIN)
+	int ret;
+
+	ret = k_thread_cpu_pin(tid, queue % arch_num_cpus());
+	if (ret < 0) {
+		NET_ERR("Cannot pin RX flow queue %d (%d)", queue, ret);
+	}
+#else
+	ARG_UNUSED(tid);
+	ARG_UNUSED(queue);
+#endif
+}
+
+/* Start the threads of the flow queues 1 and up of traffic class 0. They
+ * run at the priority of the traffic class.
+ */
+static void rx_flow_init(uint8_t thread_priority)
+{
+#if NET_TC_RX_FLOW_QUEUES > 1
+	int priority;
+	k_tid_t tid;
+
+	priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
+		K_PRIO_COOP(thread_priority) :
+		K_PRIO_PREEMPT(thread_priority);
+
+	for (int i = 0; i < ARRAY_SIZE(rx_flows); i++) {
+		NET_DBG("[%d] Starting RX flow handler %p stack size %zd "
+			"prio %d", i + 1, &rx_flows[i].handler,
+			K_KERNEL_STACK_SIZEOF(rx_flow_stack[i]), priority);
+
+		k_fifo_init(&rx_flows[i].fifo);
+
+		tid = k_thread_create(&rx_flows[i].handler, rx_flow_stack[i],
+				      K_KERNEL_STACK_SIZEOF(rx_flow_stack[i]),
+				      tc_rx_handler,
+				      &rx_flows[i].fifo, NULL, NULL,
+				      priority, 0, K_FOREVER);
+		if (!tid) {
+			NET_ERR("Cannot create RX flow handler thread %d", i + 1);
+			continue;
+		}
+
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			char name[MAX_NAME_LEN];
+
+			snprintk(name, sizeof(name), "rx_f[%d]", i + 1);
+			k_thread_name_set(tid, name);
+		}
+
+		rx_flow_pin(tid, i + 1);
+
+		k_thread_start(tid);
+	}
+#else
+	ARG_UNUSED(thread_priority);
+#endif
+}
+#endif
+
 /* Create a fifo for each traffic class we are using. All the network
  * traffic goes through these classes.
  */
@@ -393,7 +619,14 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+		/* Traffic class 0 is also flow queue 0 */
+		if (i == 0) {
+			rx_flow_pin(tid, 0);
+		}
+
 		k_thread_start(tid);
 	}
+
+	rx_flow_init(rx_tc2thread(0));
 #endif
 }
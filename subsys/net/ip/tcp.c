@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/udp.h>
+#include <zephyr/net/socket.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
@@ -26,18 +27,18 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "net_private.h"
 #include "tcp_internal.h"
 
-#define ACK_TIMEOUT_MS tcp_max_timeout_ms
+#define ACK_TIMEOUT_MS tcp_max_timeout_ms(conn)
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
-#define LAST_ACK_TIMEOUT_MS tcp_max_timeout_ms
+#define LAST_ACK_TIMEOUT_MS tcp_max_timeout_ms(conn)
 #define LAST_ACK_TIMEOUT K_MSEC(LAST_ACK_TIMEOUT_MS)
-#define FIN_TIMEOUT K_MSEC(tcp_max_timeout_ms)
+#define FIN_TIMEOUT K_MSEC(tcp_max_timeout_ms(conn))
 #define ACK_DELAY K_MSEC(100)
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
+#define TCP_RTO_MAX_MS 60000U
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
-static int tcp_max_timeout_ms;
 static int tcp_rx_window =
 #if (CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE != 0)
 	CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE;
@@ -58,20 +59,23 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 #define TCP_RTO_MS (conn->rto)
-#else
-#define TCP_RTO_MS (tcp_rto)
-#endif
-
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+/* Connections with both endpoints set are also hashed on them into a
+ * lookup table, so that finding the connection of an incoming segment
+ * doesn't walk tcp_conns. The table has its own spinlock, so lookups
+ * stay off tcp_lock.
+ */
+#define TCP_CONN_TABLE_SIZE BIT(CONFIG_NET_TCP_CONN_HASH_BITS)
+
+static sys_slist_t tcp_conn_table[TCP_CONN_TABLE_SIZE];
+static struct k_spinlock tcp_conn_table_lock;
+static uint32_t tcp_conn_hash_seed;
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -239,6 +243,63 @@ static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 	return ret;
 }
 
+/* FNV-1a over both endpoints, seeded so that remote peers can't
+ * predict which connections share a bucket.
+ */
+static uint32_t tcp_conn_hash(const union tcp_endpoint *src,
+			      const union tcp_endpoint *dst)
+{
+	size_t len = tcp_endpoint_len(src->sa.sa_family);
+	const uint8_t *p = (const uint8_t *)src;
+	uint32_t hash = 2166136261U ^ tcp_conn_hash_seed;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	p = (const uint8_t *)dst;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void tcp_conn_unhash_locked(struct tcp *conn)
+{
+	if (conn->hashed) {
+		sys_slist_find_and_remove(
+			&tcp_conn_table[conn->hash & (TCP_CONN_TABLE_SIZE - 1)],
+			&conn->hash_next);
+		conn->hashed = false;
+	}
+}
+
+/* (Re)hash the connection on its current src and dst */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	k_spinlock_key_t key = k_spin_lock(&tcp_conn_table_lock);
+
+	tcp_conn_unhash_locked(conn);
+
+	conn->hash = tcp_conn_hash(&conn->src, &conn->dst);
+	sys_slist_append(&tcp_conn_table[conn->hash & (TCP_CONN_TABLE_SIZE - 1)],
+			 &conn->hash_next);
+	conn->hashed = true;
+
+	k_spin_unlock(&tcp_conn_table_lock, key);
+}
+
+static void tcp_conn_hash_remove(struct tcp *conn)
+{
+	k_spinlock_key_t key = k_spin_lock(&tcp_conn_table_lock);
+
+	tcp_conn_unhash_locked(conn);
+
+	k_spin_unlock(&tcp_conn_table_lock, key);
+}
+
 int net_tcp_endpoint_copy(struct net_context *ctx,
 			  struct sockaddr *local,
 			  struct sockaddr *peer,
@@ -418,45 +479,272 @@ out:
 	tcp_pkt_unref(pkt);
 }
 
+/* Compute the rto from the round trip time estimates according to RFC6298,
+ * tcp_rto is used until the first sample.
+ */
+static void tcp_rto_update(struct tcp *conn)
+{
+	uint32_t rto = (uint32_t)tcp_rto;
+
+	if (conn->srtt != 0U) {
+		rto = (conn->srtt >> 3) + MAX(conn->rttvar, 1U);
+		rto = CLAMP(rto, CONFIG_NET_TCP_MIN_RETRANSMISSION_TIMEOUT,
+			    TCP_RTO_MAX_MS);
+	}
+
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	rto = (conn->rto_gain * rto) >> 9;
+#endif
+
+	conn->rto = rto;
+}
+
 static void tcp_derive_rto(struct tcp *conn)
 {
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
-	uint32_t gain;
+	/* Draw a gain randomizing the rto between 1 and 1.5 times its value */
 	uint8_t gain8;
-	uint32_t rto;
 
 	/* Getting random is computational expensive, so only use 8 bits */
 	sys_rand_get(&gain8, sizeof(uint8_t));
 
-	gain = (uint32_t)gain8;
-	gain += 1 << 9;
+	conn->rto_gain = (uint16_t)gain8 + (1 << 9);
+#endif
+
+	tcp_rto_update(conn);
+}
+
+/* Retransmission timeout for the given retry, growing by a factor 1.5
+ * every retry up to TCP_RTO_MAX_MS.
+ */
+static uint32_t tcp_backoff_rto(struct tcp *conn, int retries)
+{
+	uint32_t rto = TCP_RTO_MS;
+
+	for (int i = 0; i < retries && rto < TCP_RTO_MAX_MS; i++) {
+		rto = MIN(rto + (rto >> 1), TCP_RTO_MAX_MS);
+	}
+
+	return rto;
+}
+
+/* Largest time the retransmissions of a segment can take */
+static int tcp_max_timeout_ms(struct tcp *conn)
+{
+	uint32_t timeout = 0U;
+
+	for (int i = 0; i < tcp_retries; i++) {
+		timeout += tcp_backoff_rto(conn, i);
+	}
+
+	/* At the last timeout cycle */
+	return timeout + TCP_RTO_MS;
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+
+/* Implementation according to RFC7323 */
+
+/* The peer timestamp clock may have wrapped around after 24 days of idle */
+#define TCP_PAWS_IDLE_MS (24U * 24U * 3600U * MSEC_PER_SEC)
+
+static bool tcp_ts_ok(struct tcp *conn)
+{
+	return conn->ts_ok;
+}
+
+/* Our timestamp clock ticks in milliseconds, from a random offset */
+static uint32_t tcp_ts_now(struct tcp *conn)
+{
+	return k_uptime_get_32() + conn->ts_offset;
+}
+
+/* Timestamps are used when both ends put them in their SYN */
+static void tcp_ts_negotiate(struct tcp *conn)
+{
+	conn->ts_ok = conn->recv_options.ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+		conn->ts_recent_stamp = k_uptime_get_32();
+	}
+}
+
+static size_t tcp_ts_opt_add(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	size_t len = 0;
+
+	/* Offer timestamps on our SYN, then only send them once they are
+	 * negotiated. Resets do not carry them.
+	 */
+	if ((flags & RST) || (!conn->ts_ok && (flags & (SYN | ACK)) != SYN)) {
+		return 0;
+	}
+
+	opts[len++] = NET_TCP_NOP_OPT;
+	opts[len++] = NET_TCP_NOP_OPT;
+	opts[len++] = NET_TCP_TIMESTAMP_OPT;
+	opts[len++] = NET_TCP_TIMESTAMP_SIZE;
+
+	UNALIGNED_PUT(htonl(tcp_ts_now(conn)), (uint32_t *)&opts[len]);
+	UNALIGNED_PUT(htonl(conn->ts_recent), (uint32_t *)&opts[len + 4]);
+
+	return len + 8;
+}
+
+/* Length of the timestamps option carried by the data segments */
+static int tcp_ts_opt_len(struct tcp *conn)
+{
+	return conn->ts_ok ? 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE : 0;
+}
+
+/* Protection against wrapped sequence numbers (PAWS): a segment carrying
+ * an older timestamp than the last one kept is an old duplicate. RST
+ * segments are acceptable regardless of their timestamp (RFC 7323
+ * section 5.3).
+ */
+static bool tcp_ts_paws_reject(struct tcp *conn, struct tcphdr *th)
+{
+	if ((th_flags(th) & RST) != 0U ||
+	    !conn->ts_ok || !conn->recv_options.ts_found ||
+	    (int32_t)(conn->recv_options.tsval - conn->ts_recent) >= 0) {
+		return false;
+	}
+
+	return k_uptime_get_32() - conn->ts_recent_stamp <= TCP_PAWS_IDLE_MS;
+}
+
+/* Keep the timestamp of the in-sequence segments, it is echoed to the
+ * peer in the following segments.
+ */
+static void tcp_ts_update(struct tcp *conn, struct tcphdr *th)
+{
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+		conn->ts_recent = conn->recv_options.tsval;
+		conn->ts_recent_stamp = k_uptime_get_32();
+	}
+}
+
+/* Every acknowledgment echoes the time the data it was triggered by was
+ * sent at, retransmitted or not.
+ */
+static bool tcp_ts_rtt(struct tcp *conn, uint32_t *rtt)
+{
+	if (!conn->ts_ok || !conn->recv_options.ts_found ||
+	    conn->recv_options.tsecr == 0U) {
+		return false;
+	}
+
+	*rtt = tcp_ts_now(conn) - conn->recv_options.tsecr;
+
+	/* Ignore a bogus echo */
+	return *rtt <= TCP_RTO_MAX_MS;
+}
 
-	rto = (uint32_t)tcp_rto;
-	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
 #else
-	ARG_UNUSED(conn);
-#endif
+
+static bool tcp_ts_ok(struct tcp *conn) { return false; }
+
+static void tcp_ts_negotiate(struct tcp *conn) { }
+
+static size_t tcp_ts_opt_add(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	return 0;
+}
+
+static int tcp_ts_opt_len(struct tcp *conn) { return 0; }
+
+static bool tcp_ts_paws_reject(struct tcp *conn, struct tcphdr *th)
+{
+	return false;
 }
 
+static void tcp_ts_update(struct tcp *conn, struct tcphdr *th) { }
+
+static bool tcp_ts_rtt(struct tcp *conn, uint32_t *rtt) { return false; }
+
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+/* Round trip time estimation according to RFC6298 */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		/* RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R| */
+		conn->rttvar += abs(delta) - (conn->rttvar >> 2);
+		/* SRTT = 7/8 SRTT + 1/8 R */
+		conn->srtt += delta;
+	}
+
+	tcp_rto_update(conn);
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+
+/* Without timestamps, time one segment per round trip. Retransmitted
+ * segments are not timed (Karn's algorithm), so every retransmission drops
+ * the running measurement.
+ */
+static void tcp_rtt_data_sent(struct tcp *conn, int len)
+{
+	if (conn->data_mode == TCP_DATA_MODE_SEND && !conn->rtt_pending &&
+	    !tcp_ts_ok(conn)) {
+		conn->rtt_seq = conn->seq + conn->unacked_len + len;
+		conn->rtt_start = k_uptime_get_32();
+		conn->rtt_pending = true;
+	}
+}
+
+/* Take a round trip time sample from an acknowledgment of new data */
+static void tcp_rtt_ack(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t rtt;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	conn->ca.rtt = 0U;
+#endif
 
-/* Implementation according to RFC6582 */
+	if (!tcp_ts_rtt(conn, &rtt)) {
+		if (!conn->rtt_pending ||
+		    net_tcp_seq_cmp(conn->seq + acked_len, conn->rtt_seq) < 0) {
+			return;
+		}
+
+		rtt = k_uptime_get_32() - conn->rtt_start;
+	}
+
+	conn->rtt_pending = false;
+	rtt = CLAMP(rtt, 1U, TCP_RTO_MAX_MS);
+	tcp_rtt_update(conn, rtt);
 
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	conn->ca.rtt = rtt;
+#endif
+}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+
+void tcp_ca_log(struct tcp *conn, const char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	NET_DBG("conn: %p, ca %s %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+		conn, conn->ca_ops->name, step, conn->ca.cwnd,
+		conn->ca.ssthresh, conn->ca.pending_fast_retransmit_bytes);
 }
 
+/* Implementation according to RFC6582 */
+
 static void tcp_new_reno_init(struct tcp *conn)
 {
 	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
 	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
 	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	tcp_ca_log(conn, "init");
 }
 
 static void tcp_new_reno_fast_retransmit(struct tcp *conn)
@@ -466,7 +754,7 @@ static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 		/* Account for the lost segments */
 		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
 		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+		tcp_ca_log(conn, "fast_retransmit");
 	}
 }
 
@@ -474,7 +762,7 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 {
 	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
 	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	tcp_ca_log(conn, "timeout");
 }
 
 /* For every duplicate ack increment the cwnd by mss */
@@ -484,7 +772,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 
 	new_win += conn_mss(conn);
 	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	tcp_ca_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
@@ -510,33 +798,119 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			conn->ca.cwnd -= acked_len;
 		}
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+	tcp_ca_log(conn, "pkts_acked");
 }
 
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+/* Algorithms selectable with the TCP_CONGESTION socket option */
+static const struct tcp_ca_ops *const tcp_ca_algos[] = {
+	&tcp_ca_new_reno,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_ca_cubic,
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+	&tcp_ca_bbr,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_ca_cubic)
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CA_DEFAULT (&tcp_ca_bbr)
+#else
+#define TCP_CA_DEFAULT (&tcp_ca_new_reno)
+#endif
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	memset(&conn->ca, 0, sizeof(conn->ca));
+	conn->ca_ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca_ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca_ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca_ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca_ops->pkts_acked(conn, acked_len);
+}
+
+/* Accepted connections use the algorithm selected on the listening one */
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca_ops = from->ca_ops;
 }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops = NULL;
+	size_t name_len;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = strnlen(value, MIN(len, TCP_CA_NAME_MAX));
+
+	ARRAY_FOR_EACH(tcp_ca_algos, i) {
+		if (strlen(tcp_ca_algos[i]->name) == name_len &&
+		    memcmp(tcp_ca_algos[i]->name, value, name_len) == 0) {
+			ops = tcp_ca_algos[i];
+			break;
+		}
+	}
+
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca_ops) {
+		conn->ca_ops = ops;
+
+		/* Restart from the initial window on a running connection */
+		if (conn->state == TCP_ESTABLISHED ||
+		    conn->state == TCP_CLOSE_WAIT) {
+			tcp_ca_init(conn);
+		}
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca_ops->name) + 1;
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->ca_ops->name, *len);
+
+	return 0;
+}
+
 #else
 
 static void tcp_ca_init(struct tcp *conn) { }
@@ -549,6 +923,312 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+#define tcp_ca_param_copy(...)
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+
+/* Implementation according to RFC2018 */
+
+/* Keep a block of the out-of-order receive queue for the SACK option. The
+ * block holding the latest out-of-order segment goes first (RFC 2018
+ * section 4), the others follow in sequence order.
+ */
+static void tcp_sack_block_add(struct tcp *conn, struct tcp_sack_block *blocks,
+			       uint8_t max, uint8_t *cnt,
+			       const struct tcp_sack_block *block)
+{
+	if (net_tcp_seq_cmp(block->start, conn->sack_last) <= 0 &&
+	    net_tcp_seq_cmp(block->end, conn->sack_last) > 0) {
+		blocks[0] = *block;
+		return;
+	}
+
+	if (*cnt < max) {
+		blocks[++(*cnt)] = *block;
+	}
+}
+
+/* Collect the SACK blocks to report to the peer from the out-of-order
+ * receive queue, coalescing the contiguous fragments.
+ */
+static uint8_t tcp_sack_blocks_get(struct tcp *conn,
+				   struct tcp_sack_block *blocks)
+{
+	/* The timestamps option leaves room for one block less */
+	uint8_t max = NET_TCP_SACK_MAX_BLOCKS - (tcp_ts_ok(conn) ? 1 : 0);
+	/* The latest block, if any, followed by up to max other blocks */
+	struct tcp_sack_block found[NET_TCP_SACK_MAX_BLOCKS + 1];
+	struct tcp_sack_block block;
+	struct net_buf *buf;
+	uint32_t start;
+	uint32_t end;
+	uint8_t cnt = 0;
+
+	if (!conn->sack_ok || CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0 ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	found[0].start = 0;
+	found[0].end = 0;
+	block.end = conn->ack;
+
+	for (buf = conn->queue_recv_data->buffer; buf; buf = buf->frags) {
+		start = tcp_get_seq(buf);
+		end = start + buf->len;
+
+		if (net_tcp_seq_cmp(end, conn->ack) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(start, conn->ack) < 0) {
+			start = conn->ack;
+		}
+
+		if (block.end == start && block.end != conn->ack) {
+			block.end = end;
+			continue;
+		}
+
+		if (block.end != conn->ack) {
+			tcp_sack_block_add(conn, found, max, &cnt, &block);
+		}
+
+		block.start = start;
+		block.end = end;
+	}
+
+	if (block.end != conn->ack) {
+		tcp_sack_block_add(conn, found, max, &cnt, &block);
+	}
+
+	if (found[0].start != found[0].end) {
+		cnt = MIN(cnt + 1, max);
+		memcpy(blocks, found, cnt * sizeof(found[0]));
+	} else {
+		memcpy(blocks, &found[1], cnt * sizeof(found[0]));
+	}
+
+	return cnt;
+}
+
+static size_t tcp_sack_opt_add(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_MAX_BLOCKS];
+	size_t len = 0;
+	uint8_t cnt;
+
+	if (flags & SYN) {
+		/* Offer SACK on our SYN, accept it on our SYN-ACK */
+		if ((flags & ACK) && !conn->sack_ok) {
+			return 0;
+		}
+
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_SIZE;
+
+		return len;
+	}
+
+	if (!(flags & ACK)) {
+		return 0;
+	}
+
+	cnt = tcp_sack_blocks_get(conn, blocks);
+	if (cnt == 0) {
+		return 0;
+	}
+
+	opts[len++] = NET_TCP_NOP_OPT;
+	opts[len++] = NET_TCP_NOP_OPT;
+	opts[len++] = NET_TCP_SACK_OPT;
+	opts[len++] = 2 + cnt * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (uint8_t i = 0; i < cnt; i++) {
+		UNALIGNED_PUT(htonl(blocks[i].start), (uint32_t *)&opts[len]);
+		UNALIGNED_PUT(htonl(blocks[i].end), (uint32_t *)&opts[len + 4]);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return len;
+}
+
+/* Length of the SACK option carried by the data segments */
+static int tcp_sack_opt_len(struct tcp *conn)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t cnt = tcp_sack_blocks_get(conn, blocks);
+
+	return cnt ? 4 + cnt * NET_TCP_SACK_BLOCK_SIZE : 0;
+}
+
+static void tcp_sack_insert(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint8_t i = 0;
+	uint8_t j;
+
+	while (i < conn->sacked_cnt && net_tcp_seq_cmp(sb[i].end, start) < 0) {
+		i++;
+	}
+
+	/* Merge the new block with the ones it overlaps or touches */
+	for (j = i; j < conn->sacked_cnt &&
+		    net_tcp_seq_cmp(sb[j].start, end) <= 0; j++) {
+		if (net_tcp_seq_cmp(sb[j].start, start) < 0) {
+			start = sb[j].start;
+		}
+
+		if (net_tcp_seq_cmp(sb[j].end, end) > 0) {
+			end = sb[j].end;
+		}
+	}
+
+	if (j > i) {
+		sb[i].start = start;
+		sb[i].end = end;
+		memmove(&sb[i + 1], &sb[j],
+			(conn->sacked_cnt - j) * sizeof(sb[0]));
+		conn->sacked_cnt -= j - i - 1;
+		return;
+	}
+
+	/* The scoreboard is full, forget about the highest block as the
+	 * lowest ones matter the most for the retransmissions.
+	 */
+	if (conn->sacked_cnt == NET_TCP_SACK_MAX_BLOCKS) {
+		if (i == NET_TCP_SACK_MAX_BLOCKS) {
+			return;
+		}
+
+		conn->sacked_cnt--;
+	}
+
+	memmove(&sb[i + 1], &sb[i], (conn->sacked_cnt - i) * sizeof(sb[0]));
+	sb[i].start = start;
+	sb[i].end = end;
+	conn->sacked_cnt++;
+}
+
+/* Update the scoreboard from the SACK blocks of an incoming ACK */
+static void tcp_sack_update(struct tcp *conn, struct tcphdr *th)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t una = conn->seq;
+	uint32_t max = conn->seq + conn->send_data_total;
+	uint32_t start;
+	uint32_t end;
+	uint8_t i;
+
+	if (net_tcp_seq_cmp(th_ack(th), una) > 0 &&
+	    net_tcp_seq_cmp(th_ack(th), max) <= 0) {
+		una = th_ack(th);
+	}
+
+	for (i = 0; i < conn->recv_options.sack_cnt; i++) {
+		start = conn->recv_options.sack[i].start;
+		end = conn->recv_options.sack[i].end;
+
+		/* Ignore D-SACK and bogus blocks */
+		if (net_tcp_seq_cmp(start, una) < 0 ||
+		    net_tcp_seq_cmp(end, max) > 0 ||
+		    net_tcp_seq_cmp(end, start) <= 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, start, end);
+	}
+
+	conn->recv_options.sack_cnt = 0;
+
+	/* Drop what the cumulative ACK covers */
+	i = 0;
+	while (i < conn->sacked_cnt && net_tcp_seq_cmp(sb[i].end, una) <= 0) {
+		i++;
+	}
+
+	if (i > 0) {
+		conn->sacked_cnt -= i;
+		memmove(&sb[0], &sb[i], conn->sacked_cnt * sizeof(sb[0]));
+	}
+}
+
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sacked_cnt = 0;
+}
+
+/* Move the send position past the data already SACKed by the peer */
+static void tcp_sack_skip(struct tcp *conn)
+{
+	uint32_t pos;
+
+	for (uint8_t i = 0; i < conn->sacked_cnt; i++) {
+		pos = conn->seq + conn->unacked_len;
+
+		if (net_tcp_seq_cmp(conn->sacked[i].start, pos) > 0) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(conn->sacked[i].end, pos) > 0) {
+			conn->unacked_len = conn->sacked[i].end - conn->seq;
+		}
+	}
+}
+
+/* Stop a segment at the start of the next SACKed block */
+static int tcp_sack_clamp(struct tcp *conn, int len)
+{
+	uint32_t pos = conn->seq + conn->unacked_len;
+
+	for (uint8_t i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(conn->sacked[i].start, pos) > 0) {
+			return MIN(len, (int)(conn->sacked[i].start - pos));
+		}
+	}
+
+	return len;
+}
+
+/* Check whether data below the highest SACKed block remains to be
+ * retransmitted.
+ */
+static bool tcp_sack_hole_pending(struct tcp *conn)
+{
+	if (conn->sacked_cnt == 0) {
+		return false;
+	}
+
+	tcp_sack_skip(conn);
+
+	return net_tcp_seq_cmp(conn->seq + conn->unacked_len,
+			       conn->sacked[conn->sacked_cnt - 1].start) < 0;
+}
+#else
+
+static size_t tcp_sack_opt_add(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	return 0;
+}
+
+static int tcp_sack_opt_len(struct tcp *conn) { return 0; }
+
+static void tcp_sack_update(struct tcp *conn, struct tcphdr *th) { }
+
+static void tcp_sack_reset(struct tcp *conn) { }
+
+static void tcp_sack_skip(struct tcp *conn) { }
+
+static int tcp_sack_clamp(struct tcp *conn, int len) { return len; }
+
+static bool tcp_sack_hole_pending(struct tcp *conn) { return false; }
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -804,6 +1484,9 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+#if defined(CONFIG_NET_TCP_PACING)
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+#endif
 	keep_alive_timer_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
@@ -811,6 +1494,8 @@ static void tcp_conn_release(struct k_work *work)
 	net_context_unref(conn->context);
 	conn->context = NULL;
 
+	tcp_conn_hash_remove(conn);
+
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 	k_mutex_unlock(&tcp_lock);
@@ -830,6 +1515,13 @@ void tcp_install_close_cb(struct net_context *ctx,
 }
 #endif
 
+/* Wake the senders and the watchers waiting for send space */
+static void tcp_tx_sem_give(struct tcp *conn)
+{
+	k_sem_give(&conn->tx_sem);
+	net_context_notify(conn->context);
+}
+
 static int tcp_conn_unref(struct tcp *conn)
 {
 	int ref_count = atomic_get(&conn->ref_count);
@@ -885,7 +1577,7 @@ static int tcp_conn_close(struct tcp *conn, int status)
 				       status, conn->recv_user_data);
 	}
 
-	k_sem_give(&conn->tx_sem);
+	tcp_tx_sem_give(conn);
 
 	return tcp_conn_unref(conn);
 }
@@ -1096,8 +1788,16 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS and window scale are only sent on SYN segments, keep what was
+	 * negotiated when later segments carry other options.
+	 */
+	recv_options->sack_perm_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_cnt = 0;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	recv_options->ts_found = false;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1146,6 +1846,50 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE != 0 ||
+			    opt_len == 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_cnt = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						     NET_TCP_SACK_MAX_BLOCKS);
+			for (int i = 0; i < recv_options->sack_cnt; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].end =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+
+			NET_DBG("SACK blocks=%hu", (uint16_t)recv_options->sack_cnt);
+			break;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1337,7 +2081,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1351,11 +2095,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -1416,23 +2156,57 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+static int get_tcp_info(struct tcp *conn, void *value, size_t *len)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	struct tcp_info info = { 0 };
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	info.tcpi_state = conn->state;
+	info.tcpi_retransmits = conn->send_data_retries;
+#if defined(CONFIG_NET_TCP_SACK)
+	info.tcpi_options |= conn->sack_ok ? TCPI_OPT_SACK : 0;
+#endif
+	info.tcpi_options |= tcp_ts_ok(conn) ? TCPI_OPT_TIMESTAMPS : 0;
+	info.tcpi_rto = conn->rto * USEC_PER_MSEC;
+	info.tcpi_snd_mss = conn_mss(conn);
+	info.tcpi_rtt = (uint64_t)conn->srtt * USEC_PER_MSEC >> 3;
+	info.tcpi_rttvar = (uint64_t)conn->rttvar * USEC_PER_MSEC >> 2;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	info.tcpi_snd_ssthresh = conn->ca.ssthresh;
+	info.tcpi_snd_cwnd = conn->ca.cwnd;
+#endif
+	info.tcpi_snd_wnd = conn->send_win;
+	info.tcpi_rcv_wnd = conn->recv_win;
+	info.tcpi_unacked = conn->unacked_len;
+
+	*len = MIN(*len, sizeof(info));
+	memcpy(value, &info, *len);
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+	return 0;
+}
+
+/* Write the options of an outgoing segment, return their length */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	size_t len = 0;
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss;
+
+		recv_mss = net_tcp_get_supported_mss(conn);
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+
+		UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)opts);
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	len += tcp_sack_opt_add(conn, flags, opts + len);
+	len += tcp_ts_opt_add(conn, flags, opts + len);
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1539,15 +2313,14 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[NET_TCP_MAX_OPT_SIZE];
+	size_t opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
+	opts_len = tcp_options_build(conn, flags, opts);
 
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -1565,14 +2338,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1615,9 +2388,22 @@ static void tcp_out(struct tcp *conn, uint8_t flags)
 	(void)tcp_out_ext(conn, flags, NULL /* no data */, conn->seq);
 }
 
+/* Room left at the end of a send queue buffer. There is none in the buffers
+ * referencing MSG_ZEROCOPY data, the caller memory is never written to.
+ */
+static size_t tcp_buf_tailroom(struct net_buf *buf)
+{
+	if (buf->flags & NET_BUF_EXTERNAL_DATA) {
+		return 0;
+	}
+
+	return net_buf_tailroom(buf);
+}
+
 static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 {
 	int total = net_pkt_get_len(pkt);
+	struct net_buf *buf;
 	int ret = 0;
 
 	if (len > total) {
@@ -1625,9 +2411,32 @@ static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 		goto out;
 	}
 
+	/* Acknowledged buffers are dropped whole. The data left in a
+	 * MSG_ZEROCOPY buffer is referenced from its new start instead of
+	 * being moved, the other ones are compacted to reuse their tailroom.
+	 */
+	while (len > 0) {
+		buf = pkt->buffer;
+
+		if (len >= buf->len) {
+			len -= buf->len;
+			pkt->buffer = buf->frags;
+			buf->frags = NULL;
+			net_buf_unref(buf);
+			continue;
+		}
+
+		if (buf->flags & NET_BUF_EXTERNAL_DATA) {
+			(void)net_buf_pull(buf, len);
+		} else {
+			memmove(buf->data, buf->data + len, buf->len - len);
+			buf->len -= len;
+		}
+
+		len = 0;
+	}
+
 	net_pkt_cursor_init(pkt);
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_pull(pkt, len);
 	net_pkt_trim_buffer(pkt);
  out:
 	return ret;
@@ -1656,8 +2465,8 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	if (pkt->buffer) {
 		buf = net_buf_frag_last(pkt->buffer);
 
-		if (len > net_buf_tailroom(buf)) {
-			alloc_len -= net_buf_tailroom(buf);
+		if (len > tcp_buf_tailroom(buf)) {
+			alloc_len -= tcp_buf_tailroom(buf);
 		} else {
 			alloc_len = 0;
 		}
@@ -1676,7 +2485,7 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	}
 
 	while (buf != NULL && len > 0) {
-		size_t write_len = MIN(len, net_buf_tailroom(buf));
+		size_t write_len = MIN(len, tcp_buf_tailroom(buf));
 
 		net_buf_add_mem(buf, data, write_len);
 
@@ -1734,13 +2543,65 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_PACING)
+static uint64_t tcp_pacing_now(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* Account for a transmitted segment in the earliest time of the next one */
+static void tcp_pacing_update(struct tcp *conn, int len)
+{
+	if (conn->ca.pacing_rate == 0U) {
+		return;
+	}
+
+	conn->pacing_next = MAX(conn->pacing_next, tcp_pacing_now()) +
+			    (uint64_t)len * USEC_PER_SEC / conn->ca.pacing_rate;
+}
+
+/* Check if the pacing rate defers the next transmission, in which case the
+ * pacing timer resumes it.
+ */
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	uint64_t now;
+
+	if (conn->ca.pacing_rate == 0U) {
+		return false;
+	}
+
+	now = tcp_pacing_now();
+	if (conn->pacing_next <= now) {
+		return false;
+	}
+
+	(void)k_work_schedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+					K_USEC(conn->pacing_next - now));
+
+	return true;
+}
+#else
+static void tcp_pacing_update(struct tcp *conn, int len) { }
+
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	return false;
+}
+#endif /* CONFIG_NET_TCP_PACING */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	/* Only retransmit what the peer has not SACKed */
+	tcp_sack_skip(conn);
+
+	len = MIN(tcp_unsent_len(conn), conn_mss(conn) - tcp_sack_opt_len(conn) -
+		  tcp_ts_opt_len(conn));
+	len = tcp_sack_clamp(conn, len);
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1767,6 +2628,8 @@ static int tcp_send_data(struct tcp *conn)
 
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
+		tcp_rtt_data_sent(conn, len);
+		tcp_pacing_update(conn, len);
 		conn->unacked_len += len;
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
@@ -1815,6 +2678,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_pacing_wait(conn)) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -1838,6 +2705,26 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_PACING)
+static void tcp_pacing_send(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+	int ret;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		ret = tcp_send_queued_data(conn);
+		if (ret < 0 && ret != -ENOBUFS) {
+			tcp_conn_close(conn, ret);
+		}
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif /* CONFIG_NET_TCP_PACING */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1881,6 +2768,15 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+	/* The peer may discard data it has SACKed (RFC 2018 section 8), so
+	 * stop relying on the scoreboard when retransmissions keep timing out.
+	 */
+	if (conn->send_data_retries > 0) {
+		tcp_sack_reset(conn);
+	}
+
+	/* Do not time the retransmitted data */
+	conn->rtt_pending = false;
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1890,7 +2786,7 @@ static void tcp_resend_data(struct k_work *work)
 		if (conn->in_close && conn->send_data_total == 0) {
 			NET_DBG("TCP connection in %s close, "
 				"not disposing yet (waiting %dms)",
-				"active", tcp_max_timeout_ms);
+				"active", tcp_max_timeout_ms(conn));
 			k_work_reschedule_for_queue(&tcp_work_q,
 						    &conn->fin_timer,
 						    FIN_TIMEOUT);
@@ -1918,10 +2814,7 @@ static void tcp_resend_data(struct k_work *work)
 	exp_tcp_rto = TCP_RTO_MS;
 	/* The last retransmit does not need to wait that long */
 	if (conn->send_data_retries < tcp_retries) {
-		/* Every retransmit, the retransmission timeout increases by a factor 1.5 */
-		for (int i = 0; i < conn->send_data_retries; i++) {
-			exp_tcp_rto += exp_tcp_rto >> 1;
-		}
+		exp_tcp_rto = tcp_backoff_rto(conn, conn->send_data_retries);
 	}
 
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
@@ -1965,7 +2858,7 @@ static void tcp_fin_timeout(struct k_work *work)
 		return;
 	}
 
-	NET_DBG("Did not receive %s in %dms", "FIN", tcp_max_timeout_ms);
+	NET_DBG("Did not receive %s in %dms", "FIN", tcp_max_timeout_ms(conn));
 	NET_DBG("conn: %p %s", conn, tcp_conn_state(conn, NULL));
 
 	(void)tcp_conn_close(conn, -ETIMEDOUT);
@@ -2138,6 +3031,11 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca_ops = TCP_CA_DEFAULT;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Do not disclose the uptime in the timestamps */
+	sys_rand_get(&conn->ts_offset, sizeof(conn->ts_offset));
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2152,6 +3050,9 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->fin_timer, tcp_fin_timeout);
 	k_work_init_delayable(&conn->send_data_timer, tcp_resend_data);
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
+#if defined(CONFIG_NET_TCP_PACING)
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_send);
+#endif
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
 	k_work_init(&conn->conn_release, tcp_conn_release);
@@ -2195,42 +3096,40 @@ int net_tcp_get(struct net_context *context)
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	union tcp_endpoint ep_tmp;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	struct tcp *found = NULL;
+	struct tcp *conn;
+	k_spinlock_key_t key;
+	uint32_t hash;
+	size_t len;
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
+	/* The local end of the packet is the source of the connection */
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
 	}
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
-}
+	hash = tcp_conn_hash(&src, &dst);
+	len = tcp_endpoint_len(src.sa.sa_family);
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
-{
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
-}
-
-static struct tcp *tcp_conn_search(struct net_pkt *pkt)
-{
-	bool found = false;
-	struct tcp *conn;
-	struct tcp *tmp;
+	key = k_spin_lock(&tcp_conn_table_lock);
 
-	k_mutex_lock(&tcp_lock, K_FOREVER);
-
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conn_table[hash & (TCP_CONN_TABLE_SIZE - 1)],
+				     conn, hash_next) {
+		if (conn->hash == hash &&
+		    memcmp(&conn->src, &src, len) == 0 &&
+		    memcmp(&conn->dst, &dst, len) == 0) {
+			found = conn;
 			break;
 		}
 	}
 
-	k_mutex_unlock(&tcp_lock);
+	k_spin_unlock(&tcp_conn_table_lock, key);
 
-	return found ? conn : NULL;
+	return found;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -2419,6 +3318,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr),
@@ -2755,6 +3656,10 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	/* We received out-of-order data. Try to queue it.
 	 */
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_last = seq;
+#endif
 }
 
 static void tcp_check_sock_options(struct tcp *conn)
@@ -2867,6 +3772,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Only use the timestamps of this segment */
+	conn->recv_options.ts_found = false;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2891,7 +3801,16 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (th && tcp_ts_paws_reject(conn, th)) {
+		NET_DBG("conn: %p, DROP: old timestamp", conn);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		goto out;
+	}
+
 	if (th) {
+		tcp_ts_update(conn, th);
+
 		conn->send_win = ntohs(th_win(th));
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
@@ -2914,7 +3833,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (tcp_window_full(conn)) {
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
-			k_sem_give(&conn->tx_sem);
+			tcp_tx_sem_give(conn);
 		}
 	}
 
@@ -2924,6 +3843,11 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = tcp_options_len > 0 &&
+					conn->recv_options.sack_perm_found;
+#endif
+			tcp_ts_negotiate(conn);
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -2962,6 +3886,7 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3024,6 +3949,8 @@ next_state:
 			next = TCP_ESTABLISHED;
 
 			tcp_ca_init(conn);
+			/* The ACK echoes the timestamp of our SYN-ACK */
+			tcp_rtt_ack(conn, 0);
 
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3051,6 +3978,11 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = tcp_options_len > 0 &&
+					conn->recv_options.sack_perm_found;
+#endif
+			tcp_ts_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3068,6 +4000,8 @@ next_state:
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 			tcp_ca_init(conn);
+			/* The SYN-ACK echoes the timestamp of our SYN */
+			tcp_rtt_ack(conn, 0);
 			tcp_out(conn, ACK);
 			keep_alive_timer_restart(conn);
 
@@ -3134,6 +4068,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_update(conn, th);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3159,11 +4097,18 @@ next_state:
 
 				conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+				/* With SACK, resend every hole below the highest
+				 * SACKed data, not just the first segment.
+				 */
+				do {
+					ret = tcp_send_data(conn);
+				} while (ret == 0 && tcp_sack_hole_pending(conn));
 
 				/* Restore the current transmission */
 				conn->unacked_len = temp_unacked_len;
 
+				/* Do not time the retransmitted data */
+				conn->rtt_pending = false;
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
@@ -3198,6 +4143,7 @@ next_state:
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
 #endif
+			tcp_rtt_ack(conn, len_acked);
 			tcp_ca_pkts_acked(conn, len_acked);
 
 			conn->send_data_total -= len_acked;
@@ -3208,7 +4154,7 @@ next_state:
 			}
 
 			if (!tcp_window_full(conn)) {
-				k_sem_give(&conn->tx_sem);
+				tcp_tx_sem_give(conn);
 			}
 
 			conn_seq(conn, + len_acked);
@@ -3311,7 +4257,7 @@ next_state:
 		if (tcp_window_full(conn)) {
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
-			k_sem_give(&conn->tx_sem);
+			tcp_tx_sem_give(conn);
 		}
 
 		break;
@@ -3580,6 +4526,7 @@ out:
 			}
 
 			k_sem_give(&conn->connect_sem);
+			net_context_notify(conn->context);
 		}
 
 		goto next_state;
@@ -3655,7 +4602,7 @@ int net_tcp_put(struct net_context *context)
 
 			NET_DBG("TCP connection in %s close, "
 				"not disposing yet (waiting %dms)",
-				"active", tcp_max_timeout_ms);
+				"active", tcp_max_timeout_ms(conn));
 			k_work_reschedule_for_queue(&tcp_work_q,
 						    &conn->fin_timer,
 						    FIN_TIMEOUT);
@@ -3710,9 +4657,10 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 }
 
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg)
+		  const struct msghdr *msg, bool zerocopy)
 {
 	struct tcp *conn = context->tcp;
+	struct net_buf *frags;
 	size_t queued_len = 0;
 	int ret = 0;
 
@@ -3746,7 +4694,17 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 	 */
 	len = MIN(conn->send_win - conn->send_data_total, len);
 
-	if (msg) {
+	/* The queued data is referenced until acknowledged, the segments
+	 * still copy it. The data is copied when out of zero-copy buffers.
+	 * The referenced buffers are never written to: acknowledged data is
+	 * pulled from them by reference and later sends start a new buffer.
+	 */
+	if (zerocopy &&
+	    net_context_zerocopy_wrap(context, data, len, msg, &frags) == 0) {
+		net_pkt_append_buffer(conn->send_data, frags);
+		queued_len = len;
+		zerocopy = false;
+	} else if (msg) {
 		for (int i = 0; i < msg->msg_iovlen; i++) {
 			int iovlen = MIN(msg->msg_iov[i].iov_len, len);
 
@@ -3777,6 +4735,11 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
+	/* Zero-copy was asked for but the data was copied */
+	if (zerocopy) {
+		net_context_zerocopy_copied(context);
+	}
+
 	conn->send_data_total += queued_len;
 
 	/* Successfully queued data for transmission. Even if there's a transmit
@@ -3905,6 +4868,10 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	if (ret == 0) {
+		tcp_conn_hash_add(conn);
+	}
+
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
@@ -4145,6 +5112,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -4269,6 +5237,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -4470,6 +5439,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4507,6 +5479,12 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
+	case TCP_OPT_INFO:
+		ret = get_tcp_info(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4535,8 +5513,6 @@ struct k_sem *net_tcp_conn_sem_get(struct net_context *context)
 
 void net_tcp_init(void)
 {
-	int i;
-	int rto;
 #if defined(CONFIG_NET_TEST_PROTOCOL)
 	/* Register inputs for TTCN-3 based TCP sanity check */
 	test_cb_register(AF_INET,  IPPROTO_TCP, 4242, 4242, tcp_input);
@@ -4553,27 +5529,14 @@ void net_tcp_init(void)
 #define THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NET_TCP_WORKER_PRIO)
 #endif
 
+	tcp_conn_hash_seed = sys_rand32_get();
+
 	/* Use private workqueue in order not to block the system work queue.
 	 */
 	k_work_queue_start(&tcp_work_q, work_q_stack,
 			   K_KERNEL_STACK_SIZEOF(work_q_stack), THREAD_PRIORITY,
 			   NULL);
 
-	/* Compute the largest possible retransmission timeout */
-	tcp_max_timeout_ms = 0;
-	rto = tcp_rto;
-	for (i = 0; i < tcp_retries; i++) {
-		tcp_max_timeout_ms += rto;
-		rto += rto >> 1;
-	}
-	/* At the last timeout cycle */
-	tcp_max_timeout_ms += tcp_rto;
-
-	/* When CONFIG_NET_TCP_RANDOMIZED_RTO is active in can be worse case 1.5 times larger */
-	if (IS_ENABLED(CONFIG_NET_TCP_RANDOMIZED_RTO)) {
-		tcp_max_timeout_ms += tcp_max_timeout_ms >> 1;
-	}
-
 	k_thread_name_set(&tcp_work_q.thread, "tcp_work");
 	NET_DBG("Workq started. Thread ID: %p", &tcp_work_q.thread);
 }
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+
+#include "tcp_internal.h"
+
+/* A simplified BBR, after draft-cardwell-iccrg-bbr-congestion-control.
+ *
+ * The bottleneck bandwidth is the maximum delivery rate over the last
+ * rounds, the delivery rate being sampled once per round trip as the data
+ * acknowledged during it over its duration. The minimum RTT comes from the
+ * samples taken by the TCP core and expires after a while. The transmission
+ * is paced at a gain times the bandwidth and the congestion window is
+ * bounded by a gain times the bandwidth-delay product:
+ *
+ * - STARTUP doubles the rate every round until the bandwidth stops growing
+ * - DRAIN empties the queue built during STARTUP
+ * - PROBE_BW cycles the pacing gain to probe for more bandwidth and then
+ *   drain the queue that probing built
+ *
+ * There is no PROBE_RTT state, so the minimum RTT is only refreshed by the
+ * lower inflight phases of PROBE_BW, and losses are not taken as congestion
+ * signals beyond a retransmission timeout.
+ */
+
+/* Gains are in units of 1/256 */
+#define BBR_UNIT       256U
+#define BBR_HIGH_GAIN  739U /* 2/ln(2) */
+#define BBR_DRAIN_GAIN 88U  /* ln(2)/2 */
+#define BBR_CWND_GAIN  512U
+
+/* A bandwidth 25% higher than the previous one means the pipe is not full */
+#define BBR_FULL_BW_THRESH 320U
+#define BBR_FULL_BW_CNT    3U
+
+#define BBR_BW_FILTER_ROUNDS 10U
+#define BBR_MIN_RTT_WIN_MS   (10U * MSEC_PER_SEC)
+#define BBR_MIN_CWND_SEGS    4U
+
+static const uint16_t tcp_bbr_probe_bw_gain[] = {
+	320U, 192U, 256U, 256U, 256U, 256U, 256U, 256U
+};
+
+static const char *const tcp_bbr_mode_str[] = {
+	[TCP_BBR_STARTUP] = "startup",
+	[TCP_BBR_DRAIN] = "drain",
+	[TCP_BBR_PROBE_BW] = "probe_bw",
+};
+
+static void tcp_bbr_log(struct tcp *conn, const char *step)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	NET_DBG("conn: %p, bbr %s %s, btl_bw=%u, min_rtt=%u, pacing=%u",
+		conn, step, tcp_bbr_mode_str[bbr->mode], bbr->btl_bw,
+		bbr->min_rtt, conn->ca.pacing_rate);
+	tcp_ca_log(conn, step);
+}
+
+static uint32_t tcp_bbr_bdp(struct tcp *conn, uint32_t gain)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint64_t bdp = (uint64_t)bbr->btl_bw * bbr->min_rtt * gain /
+		       (MSEC_PER_SEC * BBR_UNIT);
+
+	return MIN(bdp, UINT16_MAX);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = UINT16_MAX;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.pacing_rate = 0U;
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = TCP_BBR_STARTUP;
+	bbr->round_start = k_uptime_get_32();
+	bbr->round_end = conn->seq + conn->unacked_len;
+
+	tcp_bbr_log(conn, "init");
+}
+
+/* Losses do not drive the model, the data in flight is bounded by it */
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	tcp_bbr_log(conn, "fast_retransmit");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_bbr_log(conn, "timeout");
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+/* Update the bandwidth and RTT estimates, return true at the end of a round */
+static bool tcp_bbr_update_model(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+	uint64_t bw;
+
+	if (conn->ca.rtt != 0U &&
+	    (bbr->min_rtt == 0U || conn->ca.rtt <= bbr->min_rtt ||
+	     now - bbr->min_rtt_stamp > BBR_MIN_RTT_WIN_MS)) {
+		bbr->min_rtt = conn->ca.rtt;
+		bbr->min_rtt_stamp = now;
+	}
+
+	bbr->round_acked += acked_len;
+
+	if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end) < 0) {
+		return false;
+	}
+
+	bw = (uint64_t)bbr->round_acked * MSEC_PER_SEC /
+	     MAX(now - bbr->round_start, 1U);
+
+	bbr->round++;
+	if (bw >= bbr->btl_bw ||
+	    bbr->round - bbr->btl_bw_round > BBR_BW_FILTER_ROUNDS) {
+		bbr->btl_bw = MIN(bw, UINT32_MAX);
+		bbr->btl_bw_round = bbr->round;
+	}
+
+	bbr->round_end = conn->seq + conn->unacked_len;
+	bbr->round_start = now;
+	bbr->round_acked = 0U;
+
+	return true;
+}
+
+static void tcp_bbr_update_mode(struct tcp *conn, uint32_t acked_len,
+				bool round_end)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t inflight = 0U;
+
+	if (conn->unacked_len > acked_len) {
+		inflight = conn->unacked_len - acked_len;
+	}
+
+	switch (bbr->mode) {
+	case TCP_BBR_STARTUP:
+		if (!round_end) {
+			break;
+		}
+
+		if ((uint64_t)bbr->btl_bw * BBR_UNIT >=
+		    (uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH) {
+			bbr->full_bw = bbr->btl_bw;
+			bbr->full_bw_cnt = 0U;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_CNT) {
+			bbr->mode = TCP_BBR_DRAIN;
+			tcp_bbr_log(conn, "pipe full");
+		}
+		break;
+	case TCP_BBR_DRAIN:
+		if (inflight <= tcp_bbr_bdp(conn, BBR_UNIT)) {
+			/* Cruise first, the queue has just been drained */
+			bbr->mode = TCP_BBR_PROBE_BW;
+			bbr->cycle_idx = 2U;
+			tcp_bbr_log(conn, "drained");
+		}
+		break;
+	case TCP_BBR_PROBE_BW:
+		if (round_end) {
+			bbr->cycle_idx = (bbr->cycle_idx + 1U) %
+					 ARRAY_SIZE(tcp_bbr_probe_bw_gain);
+		}
+		break;
+	}
+}
+
+static void tcp_bbr_set_controls(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t min_cwnd = conn_mss(conn) * BBR_MIN_CWND_SEGS;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t pacing_gain;
+	uint32_t cwnd_gain;
+	uint32_t target;
+
+	if (bbr->btl_bw == 0U || bbr->min_rtt == 0U) {
+		/* No model yet, grow as in slow start */
+		conn->ca.cwnd = MIN(cwnd + acked_len, UINT16_MAX);
+		return;
+	}
+
+	switch (bbr->mode) {
+	case TCP_BBR_STARTUP:
+		pacing_gain = BBR_HIGH_GAIN;
+		cwnd_gain = BBR_HIGH_GAIN;
+		break;
+	case TCP_BBR_DRAIN:
+		pacing_gain = BBR_DRAIN_GAIN;
+		cwnd_gain = BBR_HIGH_GAIN;
+		break;
+	default:
+		pacing_gain = tcp_bbr_probe_bw_gain[bbr->cycle_idx];
+		cwnd_gain = BBR_CWND_GAIN;
+		break;
+	}
+
+	conn->ca.pacing_rate = MIN((uint64_t)bbr->btl_bw * pacing_gain / BBR_UNIT,
+				   UINT32_MAX);
+
+	target = MAX(tcp_bbr_bdp(conn, cwnd_gain), min_cwnd);
+
+	if (bbr->mode != TCP_BBR_STARTUP) {
+		cwnd = MIN(cwnd + acked_len, target);
+	} else if (cwnd < target) {
+		cwnd += acked_len;
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, min_cwnd, UINT16_MAX);
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	bool round_end = tcp_bbr_update_model(conn, acked_len);
+
+	tcp_bbr_update_mode(conn, acked_len, round_end);
+	tcp_bbr_set_controls(conn, acked_len);
+	tcp_bbr_log(conn, "pkts_acked");
+}
+
+const struct tcp_ca_ops tcp_ca_bbr = {
+	.name = "bbr",
+	.init = tcp_bbr_init,
+	.fast_retransmit = tcp_bbr_fast_retransmit,
+	.timeout = tcp_bbr_timeout,
+	.dup_ack = tcp_bbr_dup_ack,
+	.pkts_acked = tcp_bbr_pkts_acked,
+};
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+
+#include "tcp_internal.h"
+
+/* Implementation according to RFC9438, in integer arithmetic with windows
+ * in bytes and times in milliseconds.
+ */
+
+/* Multiplicative decrease factor, 0.7 in units of 1/1024 */
+#define CUBIC_BETA       717U
+#define CUBIC_BETA_SCALE 1024U
+
+/* The cubic coefficient C is 0.4 segments/s^3, i.e. the cubic function
+ * grows by one segment per 2.5e9 ms^3.
+ */
+#define CUBIC_MS3_PER_SEG 2500000000LL
+
+/* Bound of the time used in the cubic function, keeping its cube in range */
+#define CUBIC_MAX_T_MS (60LL * MSEC_PER_SEC)
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0U;
+	uint64_t b;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.cubic.epoch_start = 0U;
+	conn->ca.cubic.w_max = 0U;
+	tcp_ca_log(conn, "init");
+}
+
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t flight = conn->ca.cwnd;
+
+	/* An application limited connection does not fill its window */
+	if (conn->unacked_len > 0) {
+		flight = MIN(flight, (uint32_t)conn->unacked_len);
+	}
+
+	if (flight < cubic->w_max) {
+		/* Still below the last maximum, release bandwidth for the
+		 * other flows (fast convergence).
+		 */
+		cubic->w_max = flight * (CUBIC_BETA_SCALE + CUBIC_BETA) /
+			       (2U * CUBIC_BETA_SCALE);
+	} else {
+		cubic->w_max = flight;
+	}
+
+	cubic->epoch_start = 0U;
+	conn->ca.ssthresh = MAX(flight * CUBIC_BETA / CUBIC_BETA_SCALE,
+				conn_mss(conn) * 2U);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = MIN(conn_mss(conn) * 3U + conn->ca.ssthresh,
+				    UINT16_MAX);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+/* For every duplicate ack increment the cwnd by mss */
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), UINT16_MAX);
+	tcp_ca_log(conn, "dup_ack");
+}
+
+/* Window the cubic function reaches at the current time */
+static uint32_t tcp_cubic_target(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	int64_t t;
+	int64_t offset;
+
+	if (cubic->epoch_start == 0U) {
+		/* First increase since the last reduction */
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			cubic->k = cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+					      CUBIC_MS3_PER_SEG / mss);
+			cubic->w_origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->w_origin = cwnd;
+		}
+	}
+
+	t = (int64_t)(uint32_t)(now - cubic->epoch_start) - cubic->k;
+	t = CLAMP(t, -CUBIC_MAX_T_MS, CUBIC_MAX_T_MS);
+
+	/* W_cubic(t) = C * (t - K)^3 + W_max, the product in 1/1000 segment */
+	offset = t * t * t * 1000 / CUBIC_MS3_PER_SEG * mss / 1000;
+
+	return CLAMP((int64_t)cubic->w_origin + offset, 0, UINT16_MAX);
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= acked_len;
+		}
+	} else if (cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(cwnd + MIN(acked_len, mss), UINT16_MAX);
+	} else {
+		/* Never grow by more than half the window per round trip */
+		target = MIN(tcp_cubic_target(conn), cwnd * 3U / 2U);
+
+		/* Window of a Reno flow with the same average throughput,
+		 * growing by 3 * (1 - beta) / (1 + beta) segments per RTT.
+		 */
+		cubic->w_est += DIV_ROUND_UP((uint64_t)MIN(acked_len, cwnd) * mss *
+					     3U * (CUBIC_BETA_SCALE - CUBIC_BETA),
+					     (uint64_t)(CUBIC_BETA_SCALE + CUBIC_BETA) *
+					     cwnd);
+		cubic->w_est = MIN(cubic->w_est, UINT16_MAX);
+
+		if (cubic->w_est > MAX(target, cwnd)) {
+			/* Reno-friendly region */
+			conn->ca.cwnd = cubic->w_est;
+		} else if (target > cwnd) {
+			/* Grow by (target - cwnd) / cwnd per acked segment */
+			conn->ca.cwnd = cwnd +
+				DIV_ROUND_UP((uint64_t)(target - cwnd) *
+					     MIN(acked_len, cwnd), cwnd);
+		}
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_cubic_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
@@ -36,6 +36,8 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
+	TCP_OPT_INFO = 7,
 };
 
 /**
@@ -293,20 +295,23 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @param data		Pointer to the data
  * @param len		Number of bytes
  * @param msg		Data for a vector array operation
+ * @param zerocopy	Reference the data instead of copying it (MSG_ZEROCOPY)
  *
  * @return 0 if ok, < 0 if error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg);
+		  const struct msghdr *msg, bool zerocopy);
 #else
 static inline int net_tcp_queue(struct net_context *context, const void *data,
-				size_t len, const struct msghdr *msg)
+				size_t len, const struct msghdr *msg,
+				bool zerocopy)
 {
 	ARG_UNUSED(context);
 	ARG_UNUSED(data);
 	ARG_UNUSED(len);
 	ARG_UNUSED(msg);
+	ARG_UNUSED(zerocopy);
 
 	return -EPROTONOSUPPORT;
 }
@@ -192,10 +192,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_LISTEN,
@@ -227,34 +223,140 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* TCP header max options size */
+#define NET_TCP_MAX_OPT_SIZE      40
+
+/* As many SACK blocks as fit in the options, behind two NOPs and the
+ * option kind and length.
+ */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool ts_found : 1;
+#endif
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+/* Longest congestion control algorithm name, including the terminator */
+#define TCP_CA_NAME_MAX 16
+
+struct tcp_ca_cubic {
+	uint32_t epoch_start; /* Start of the current epoch (ms), 0 if none */
+	uint32_t k;           /* Time to get back to w_max (ms) */
+	uint32_t w_max;       /* Window before the last reduction */
+	uint32_t w_origin;    /* Window the cubic function plateaus at */
+	uint32_t w_est;       /* Window a Reno flow would have */
+};
+
+enum tcp_bbr_mode {
+	TCP_BBR_STARTUP,
+	TCP_BBR_DRAIN,
+	TCP_BBR_PROBE_BW,
+};
+
+struct tcp_ca_bbr {
+	uint32_t btl_bw;        /* Bottleneck bandwidth estimate (bytes/s) */
+	uint32_t btl_bw_round;  /* Round the estimate was taken in */
+	uint32_t full_bw;       /* Bandwidth seen when the pipe looked full */
+	uint32_t min_rtt;       /* Minimum RTT estimate (ms), 0 if none */
+	uint32_t min_rtt_stamp; /* Time of the minimum RTT sample (ms) */
+	uint32_t round;         /* Number of round trips */
+	uint32_t round_end;     /* Sequence number ending the current round */
+	uint32_t round_start;   /* Start of the current round (ms) */
+	uint32_t round_acked;   /* Bytes acknowledged in the current round */
+	uint8_t full_bw_cnt;    /* Rounds without significant growth */
+	uint8_t mode;           /* enum tcp_bbr_mode */
+	uint8_t cycle_idx;      /* Position in the PROBE_BW gain cycle */
+};
+
+struct tcp_ca {
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+	/* Round trip time sample taken by the acknowledgment being processed
+	 * (ms), 0 if it did not give one.
+	 */
+	uint16_t rtt;
+#if defined(CONFIG_NET_TCP_PACING)
+	uint32_t pacing_rate; /* Bytes/s, 0 to send as fast as allowed */
+#endif
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+		struct tcp_ca_bbr bbr;
+#endif
+		uint8_t unused;
+	};
 };
+
+/* Congestion control algorithm. The callbacks are called with the connection
+ * locked, pkts_acked before the acknowledged data is removed from the send
+ * window.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+extern const struct tcp_ca_ops tcp_ca_cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+extern const struct tcp_ca_ops tcp_ca_bbr;
 #endif
 
-struct tcp;
+void tcp_ca_log(struct tcp *conn, const char *step);
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_next; /* Lookup table bucket link */
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -285,6 +387,9 @@ struct tcp { /* TCP connection */
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+#if defined(CONFIG_NET_TCP_PACING)
+	struct k_work_delayable pacing_timer;
+#endif
 	struct k_work conn_release;
 
 	union {
@@ -304,6 +409,8 @@ struct tcp { /* TCP connection */
 	size_t send_retries;
 	int unacked_len;
 	atomic_t ref_count;
+	uint32_t hash; /* Lookup hash of src and dst */
+	bool hashed; /* Linked in the lookup table */
 	enum tcp_state state;
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
@@ -314,16 +421,36 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+	uint32_t rto;       /* Retransmission timeout (ms) */
+	uint32_t srtt;      /* Smoothed round trip time (ms << 3), 0 if none */
+	uint32_t rttvar;    /* Round trip time variation (ms << 2) */
+	uint32_t rtt_seq;   /* End of the segment being timed */
+	uint32_t rtt_start; /* Transmission time of that segment (ms) */
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_offset;       /* Offset of our timestamp clock */
+	uint32_t ts_recent;       /* Peer timestamp to echo */
+	uint32_t ts_recent_stamp; /* Uptime ts_recent was taken at (ms) */
+#endif
 	uint16_t recv_win_sent;
 	uint16_t recv_win_max;
 	uint16_t recv_win;
 	uint16_t send_win_max;
 	uint16_t send_win;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	uint16_t rto;
+	uint16_t rto_gain; /* RTO factor in 1/512, drawn in [1, 1.5) */
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	const struct tcp_ca_ops *ca_ops;
+	struct tcp_ca ca;
+#endif
+#if defined(CONFIG_NET_TCP_PACING)
+	uint64_t pacing_next; /* Earliest time of the next transmission (us) */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Send data SACKed by the peer, sorted and disjoint */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sacked_cnt;
+	uint32_t sack_last; /* Start of the latest out-of-order segment */
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -338,6 +465,13 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+	bool rtt_pending : 1; /* A segment is being timed */
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1; /* SACK negotiated with the peer */
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool ts_ok : 1; /* Timestamps negotiated with the peer */
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -526,11 +526,17 @@ static uint16_t offset_based_swap8(const uint8_t *data)
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ *
+ * When dst is not NULL the data is copied there as it is summed, dst then having the same
+ * alignment as data modulo 4. The function is inlined in its two users so that the copy
+ * vanishes from calc_chksum().
  */
-uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+static ALWAYS_INLINE uint16_t chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *data,
+					  size_t len)
 {
 	uint64_t sum;
-	uint32_t *p;
+	const uint32_t *p;
+	uint32_t *q;
 	size_t i = 0;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
@@ -547,21 +553,44 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	/* Process up to 3 data elements up front, so the data is aligned further down the line */
 	if ((((uintptr_t)data & 0x01) != 0) && (pending >= 1)) {
 		sum += offset_based_swap8(data);
+		if (dst != NULL) {
+			*dst++ = *data;
+		}
 		data++;
 		pending--;
 	}
 	if ((((uintptr_t)data & 0x02) != 0) && (pending >= sizeof(uint16_t))) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
+		if (dst != NULL) {
+			*((uint16_t *)dst) = *((uint16_t *)data);
+			dst += sizeof(uint16_t);
+		}
 		data += sizeof(uint16_t);
 	}
-	p = (uint32_t *)data;
+	p = (const uint32_t *)data;
+	q = (uint32_t *)dst;
+
+#if defined(CONFIG_NET_CHKSUM_ARCH)
+	if (dst == NULL) {
+		i = pending / sizeof(uint32_t);
+		pending -= i * sizeof(uint32_t);
+		sum += arch_net_chksum32(p, i);
+	}
+#endif
 
 	/* Do loop unrolling for the very large data sets */
 	while (pending >= sizeof(uint32_t) * 4) {
 		uint64_t sum_a = p[i];
 		uint64_t sum_b = p[i + 1];
 
+		if (dst != NULL) {
+			q[i] = p[i];
+			q[i + 1] = p[i + 1];
+			q[i + 2] = p[i + 2];
+			q[i + 3] = p[i + 3];
+		}
+
 		pending -= sizeof(uint32_t) * 4;
 		sum_a += p[i + 2];
 		sum_b += p[i + 3];
@@ -570,16 +599,29 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 	while (pending >= sizeof(uint32_t)) {
 		pending -= sizeof(uint32_t);
+		if (dst != NULL) {
+			q[i] = p[i];
+		}
 		sum = sum + p[i++];
 	}
-	data = (uint8_t *)(p + i);
+	data = (const uint8_t *)(p + i);
+	if (dst != NULL) {
+		dst = (uint8_t *)(q + i);
+	}
 	if (pending >= 2) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
+		if (dst != NULL) {
+			*((uint16_t *)dst) = *((uint16_t *)data);
+			dst += sizeof(uint16_t);
+		}
 		data += sizeof(uint16_t);
 	}
 	if (pending == 1) {
 		sum += offset_based_swap8(data);
+		if (dst != NULL) {
+			*dst = *data;
+		}
 	}
 
 	/* Fold sum into 16-bit word. */
@@ -597,19 +639,55 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+{
+	return chksum_copy(sum_in, NULL, data, len);
+}
+
+uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src, size_t len)
+{
+	if ((((uintptr_t)dst ^ (uintptr_t)src) & 0x03) != 0) {
+		/* The words cannot be stored as they are loaded, sum the copy while it is
+		 * still in the cache.
+		 */
+		memcpy(dst, src, len);
+
+		return calc_chksum(sum_in, dst, len);
+	}
+
+	return chksum_copy(sum_in, dst, src, len);
+}
+
+/* Add the sum of data starting at an odd offset of the checksummed area, whose 16-bit
+ * words straddle the ones of the area.
+ */
+static inline uint16_t chksum_add_at(uint16_t sum, const uint8_t *data, size_t len,
+				     size_t offset)
+{
+	if (offset % 2) {
+		return BSWAP_16(calc_chksum(BSWAP_16(sum), data, len));
+	}
+
+	return calc_chksum(sum, data, len);
+}
+
+/* Checksum up to len bytes from the cursor on, the whole rest of the packet with SIZE_MAX */
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum, size_t len)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
-	size_t len;
+	size_t offset = 0;
+	size_t chunk;
 
 	if (!cur->buf || !cur->pos) {
 		return sum;
 	}
 
-	len = cur->buf->len - (cur->pos - cur->buf->data);
+	while (cur->buf && len > 0) {
+		chunk = MIN(len, cur->buf->len - (cur->pos - cur->buf->data));
 
-	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+		sum = chksum_add_at(sum, cur->pos, chunk, offset);
+		offset += chunk;
+		len -= chunk;
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -617,25 +695,14 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 		}
 
 		cur->pos = cur->buf->data;
-
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
-		}
 	}
 
 	return sum;
 }
 
 #if defined(CONFIG_NET_NATIVE_IP)
-uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
+uint16_t net_calc_chksum_data(struct net_pkt *pkt, uint8_t proto,
+			      size_t hdr_len, uint16_t data_sum)
 {
 	size_t len = 0U;
 	uint16_t sum = 0U;
@@ -672,7 +739,16 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	sum = pkt_calc_chksum(pkt, sum, hdr_len);
+
+	if (hdr_len % 2) {
+		data_sum = BSWAP_16(data_sum);
+	}
+
+	sum += data_sum;
+	if (sum < data_sum) {
+		sum++;
+	}
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
@@ -682,6 +758,11 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 
 	return ~sum;
 }
+
+uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
+{
+	return net_calc_chksum_data(pkt, proto, SIZE_MAX, 0U);
+}
 #endif
 
 #if defined(CONFIG_NET_NATIVE_IPV4)
@@ -386,90 +386,118 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+/* Frees the kernel copy of a user message, iovlen being the number of
+ * vectors it was allocated with.
+ */
+static void msghdr_user_free(struct msghdr *msg_copy, size_t iovlen)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	if (msg_copy->msg_iov) {
+		for (i = 0; i < iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+/* Number of vectors of the kernel copy of a user message to send whose data
+ * was copied, as zero-copy sends reference the data of the caller.
+ */
+static size_t sendmsg_user_iovlen(const struct msghdr *msg_copy, int flags)
+{
+	return (flags & ZSOCK_MSG_ZEROCOPY) ? 0 : msg_copy->msg_iovlen;
+}
+
+/* Makes a kernel copy of a user message to send */
+static int sendmsg_from_user(struct msghdr *msg_copy, const struct msghdr *msg,
+			     int flags)
+{
+	struct iovec iov;
+	size_t i;
+
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
+
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
+
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		goto fail;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
+	/* Clear the pointers in the copy so that if the allocation in the
+	 * next loop fails, we do not try to free non allocated memory
+	 * in fail branch.
+	 */
+	memset(msg_copy->msg_iov, 0, msg_copy->msg_iovlen * sizeof(struct iovec));
+
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		if (flags & ZSOCK_MSG_ZEROCOPY) {
+			K_OOPS(k_usermode_from_copy(&iov, &msg->msg_iov[i],
+						    sizeof(iov)));
+			K_OOPS(K_SYSCALL_MEMORY_READ(iov.iov_base, iov.iov_len));
+			msg_copy->msg_iov[i] = iov;
+			continue;
+		}
+
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
-			errno = ENOMEM;
+		if (!msg_copy->msg_iov[i].iov_base) {
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
-	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
-			errno = ENOMEM;
+	if (msg_copy->msg_namelen > 0) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							    msg_copy->msg_namelen);
+		if (!msg_copy->msg_name) {
 			goto fail;
 		}
 	}
 
-	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
-			errno = ENOMEM;
+	if (msg_copy->msg_controllen > 0) {
+		msg_copy->msg_control = k_usermode_alloc_from_copy(msg->msg_control,
+							   msg_copy->msg_controllen);
+		if (!msg_copy->msg_control) {
 			goto fail;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
+	return 0;
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
-
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
-	}
-
-	k_free(msg_copy.msg_iov);
+fail:
+	msghdr_user_free(msg_copy, sendmsg_user_iovlen(msg_copy, flags));
+	errno = ENOMEM;
 
-	return ret;
+	return -1;
+}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
-	}
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (sendmsg_from_user(&msg_copy, msg, flags) < 0) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
-		}
+	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+				   flags);
 
-		k_free(msg_copy.msg_iov);
-	}
+	msghdr_user_free(&msg_copy, sendmsg_user_iovlen(&msg_copy, flags));
 
-	return -1;
+	return ret;
 }
 #include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
@@ -541,12 +569,13 @@ ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+/* Makes a kernel copy of a user message to receive into, iovlen being set
+ * to the number of vectors it is allocated with.
+ */
+static int recvmsg_from_user(struct msghdr *msg_copy, struct msghdr *msg,
+			     size_t *iovlen)
 {
-	struct msghdr msg_copy;
-	size_t iovlen;
 	size_t i;
-	int ret;
 
 	if (msg == NULL) {
 		errno = EINVAL;
@@ -558,16 +587,16 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 		return -1;
 	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+	*iovlen = msg_copy->msg_iovlen;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       *iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
 		goto fail;
 	}
@@ -576,138 +605,366 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 	 * next loop fails, we do not try to free non allocated memory
 	 * in fail branch.
 	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	memset(msg_copy->msg_iov, 0, *iovlen * sizeof(struct iovec));
 
-	for (i = 0; i < iovlen; i++) {
+	for (i = 0; i < *iovlen; i++) {
 		/* TODO: In practice we do not need to copy the actual data
 		 * in msghdr when receiving data but currently there is no
 		 * ready made function to do just that (unless we want to call
 		 * relevant malloc function here ourselves). So just use
 		 * the copying variant for now.
 		 */
-		msg_copy.msg_iov[i].iov_base =
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
-	if (msg->msg_namelen > 0) {
+	if (msg_copy->msg_namelen > 0) {
 		if (msg->msg_name == NULL) {
 			errno = EINVAL;
 			goto fail;
 		}
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							    msg_copy->msg_namelen);
+		if (msg_copy->msg_name == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	if (msg->msg_controllen > 0) {
+	if (msg_copy->msg_controllen > 0) {
 		if (msg->msg_control == NULL) {
 			errno = EINVAL;
 			goto fail;
 		}
 
-		msg_copy.msg_control =
+		msg_copy->msg_control =
 			k_usermode_alloc_from_copy(msg->msg_control,
-						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
+						   msg_copy->msg_controllen);
+		if (msg_copy->msg_control == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
+	return 0;
+
+fail:
+	msghdr_user_free(msg_copy, *iovlen);
+
+	return -1;
+}
+
+/* Copies what was received in the kernel copy back to the user message */
+static void recvmsg_to_user(struct msghdr *msg, const struct msghdr *msg_copy,
+			    size_t iovlen)
+{
+	size_t i;
+
+	if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_name,
+					  msg_copy->msg_name,
+					  msg_copy->msg_namelen));
+	}
+
+	if (msg->msg_controllen > 0 &&
+	    msg->msg_control != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_control,
+					  msg_copy->msg_control,
+					  msg_copy->msg_controllen));
+
+		msg->msg_controllen = msg_copy->msg_controllen;
+	} else {
+		msg->msg_controllen = 0U;
+	}
+
+	k_usermode_to_copy(&msg->msg_iovlen,
+			   &msg_copy->msg_iovlen,
+			   sizeof(msg->msg_iovlen));
+
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(msg_copy->msg_iovlen <= iovlen);
+
+	for (i = 0; i < iovlen; i++) {
+		if (i < msg_copy->msg_iovlen) {
+			K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_len));
+			K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
+						  &msg_copy->msg_iov[i].iov_len,
+						  sizeof(msg->msg_iov[i].iov_len)));
+		} else {
+			/* Clear out those vectors that we could not populate */
+			msg->msg_iov[i].iov_len = 0;
+		}
+	}
+
+	k_usermode_to_copy(&msg->msg_flags,
+			   &msg_copy->msg_flags,
+			   sizeof(msg->msg_flags));
+}
+
+ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	struct msghdr msg_copy;
+	size_t iovlen;
+	int ret;
+
+	if (recvmsg_from_user(&msg_copy, msg, &iovlen) < 0) {
+		return -1;
+	}
+
 	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
 
 	/* Do not copy anything back if there was an error or nothing was
 	 * received.
 	 */
 	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
-		}
+		recvmsg_to_user(msg, &msg_copy, iovlen);
+	}
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+	/* Note that we need to free according to original iovlen */
+	msghdr_user_free(&msg_copy, iovlen);
 
-			msg->msg_controllen = msg_copy.msg_controllen;
-		} else {
-			msg->msg_controllen = 0U;
-		}
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+	int ret = 0;
 
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
 
-		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
+	if (vtable->sendmmsg == NULL && vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (vtable->sendmmsg != NULL) {
+		ret = vtable->sendmmsg(obj, msgvec, vlen, flags);
+	} else {
+		for (i = 0; i < vlen; i++) {
+			ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+			if (ret < 0) {
+				break;
 			}
+
+			msgvec[i].msg_len = ret;
 		}
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+		ret = i > 0 ? (int)i : ret;
 	}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	k_mutex_unlock(lock);
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		sock_obj_core_update_send_stats(sock, msgvec[i].msg_len);
 	}
 
-	k_free(msg_copy.msg_iov);
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Largest batch copied from user mode, as on Linux */
+#define SENDMMSG_USER_VLEN_MAX 1024
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	unsigned int copied;
+	unsigned int i;
+	int ret;
+
+	vlen = MIN(vlen, SENDMMSG_USER_VLEN_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
+	}
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec,
+						 vlen * sizeof(struct mmsghdr));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (copied = 0; copied < vlen; copied++) {
+		if (sendmsg_from_user(&msgvec_copy[copied].msg_hdr,
+				      &msgvec[copied].msg_hdr, flags) < 0) {
+			break;
+		}
+	}
+
+	/* Send what could be copied, the error being reported otherwise */
+	ret = copied > 0 ? z_impl_zsock_sendmmsg(sock, msgvec_copy, copied, flags) : -1;
+
+	for (i = 0; i < copied; i++) {
+		if (ret > 0 && i < (unsigned int)ret) {
+			K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len,
+						  &msgvec_copy[i].msg_len,
+						  sizeof(msgvec[i].msg_len)));
+		}
+
+		msghdr_user_free(&msgvec_copy[i].msg_hdr,
+				 sendmsg_user_iovlen(&msgvec_copy[i].msg_hdr, flags));
+	}
+
+	k_free(msgvec_copy);
 
 	return ret;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, struct timespec *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	struct k_mutex *lock;
+	unsigned int count = 0U;
+	unsigned int i;
+	void *obj;
+	int ret = 0;
+
+	if (timeout != NULL) {
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= NSEC_PER_SEC) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		end = sys_timepoint_calc(K_MSEC((int64_t)timeout->tv_sec * MSEC_PER_SEC +
+						timeout->tv_nsec / NSEC_PER_MSEC));
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	while (count < vlen) {
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr,
+				      flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count++].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		if (timeout != NULL && sys_timepoint_expired(end)) {
+			break;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	for (i = 0; i < count; i++) {
+		sock_obj_core_update_recv_stats(sock, msgvec[i].msg_len);
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
+	/* An error after the first message is left for the next call */
+	return count > 0 ? (int)count : ret;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Largest batch received from user mode, bounding the stack used to track
+ * the vectors of the kernel copies.
+ */
+#define RECVMMSG_USER_VLEN_MAX 16
+
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					struct timespec *timeout)
+{
+	size_t iovlen[RECVMMSG_USER_VLEN_MAX];
+	struct mmsghdr *msgvec_copy;
+	struct timespec timeout_copy;
+	unsigned int copied;
+	unsigned int i;
+	int ret;
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, timeout,
+					    sizeof(timeout_copy)));
+	}
+
+	vlen = MIN(vlen, RECVMMSG_USER_VLEN_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags,
+					     timeout != NULL ? &timeout_copy : NULL);
+	}
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec,
+						 vlen * sizeof(struct mmsghdr));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (copied = 0; copied < vlen; copied++) {
+		if (recvmsg_from_user(&msgvec_copy[copied].msg_hdr,
+				      &msgvec[copied].msg_hdr,
+				      &iovlen[copied]) < 0) {
+			break;
+		}
+	}
+
+	ret = copied > 0 ? z_impl_zsock_recvmmsg(sock, msgvec_copy, copied, flags,
+						 timeout != NULL ? &timeout_copy : NULL) : -1;
+
+	for (i = 0; i < copied; i++) {
+		if (ret > 0 && i < (unsigned int)ret) {
+			if (msgvec_copy[i].msg_len > 0) {
+				recvmsg_to_user(&msgvec[i].msg_hdr,
+						&msgvec_copy[i].msg_hdr, iovlen[i]);
 			}
+
+			K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len,
+						  &msgvec_copy[i].msg_len,
+						  sizeof(msgvec[i].msg_len)));
 		}
 
-		k_free(msg_copy.msg_iov);
+		msghdr_user_free(&msgvec_copy[i].msg_hdr, iovlen[i]);
 	}
 
-	return -1;
+	k_free(msgvec_copy);
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 /* As this is limited function, we don't follow POSIX signature, with
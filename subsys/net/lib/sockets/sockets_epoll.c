@@ -0,0 +1,574 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_epoll, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/socket_epoll.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "sockets_internal.h"
+
+/* An epoll instance keeps its sockets in an interest list. The net_context
+ * of each socket calls back the instance whenever the socket may have become
+ * ready, which queues the socket on the ready list of the instance and
+ * raises its signal. Waiting only checks the sockets of the ready list with
+ * a non-blocking poll, then drops those found not ready: level-triggered
+ * sockets which are ready stay on the list to be checked again by the next
+ * wait, while edge-triggered ones wait for the next callback.
+ */
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+
+int zvfs_poll_internal(struct zvfs_pollfd *fds, int nfds, k_timeout_t timeout);
+
+/* Events checked with poll, the others are always reported */
+#define EPOLL_POLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT)
+#define EPOLL_REPORT_EVENTS (EPOLL_POLL_EVENTS | ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+
+struct epoll_item {
+	/* Registered with the net_context of the socket */
+	struct net_context_watcher watcher;
+	/* Node in the interest list */
+	sys_dnode_t node;
+	/* Node in the ready list */
+	sys_dnode_t rdnode;
+	struct epoll *ep;
+	struct net_context *ctx;
+	struct zsock_epoll_event event;
+	int fd;
+	/* Cleared once a one-shot socket was reported */
+	bool armed;
+	/* The following are protected by the rdlock of the instance */
+	/* On the ready list, or being checked by a wait */
+	bool queued;
+	/* Called back while queued */
+	bool notified;
+	/* The socket was closed */
+	bool released;
+};
+
+struct epoll {
+	/* Serializes the waits and the changes of the interest list */
+	struct k_mutex lock;
+	/* Protects the ready list, taken by the net_context callbacks */
+	struct k_spinlock rdlock;
+	/* Raised while the ready list is not empty */
+	struct k_poll_signal signal;
+	sys_dlist_t items;
+	sys_dlist_t rdlist;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(epoll_slab, sizeof(struct epoll),
+			 CONFIG_NET_SOCKETS_EPOLL_MAX, 8);
+K_MEM_SLAB_DEFINE_STATIC(epoll_item_slab, sizeof(struct epoll_item),
+			 CONFIG_NET_SOCKETS_EPOLL_MAX_ITEMS, 8);
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+/* Called with the rdlock held */
+static void epoll_item_queue(struct epoll *ep, struct epoll_item *item)
+{
+	if (item->queued) {
+		item->notified = true;
+	} else {
+		item->queued = true;
+		sys_dlist_append(&ep->rdlist, &item->rdnode);
+	}
+
+	k_poll_signal_raise(&ep->signal, 0);
+}
+
+static void epoll_item_cb(struct net_context_watcher *watcher, bool released)
+{
+	struct epoll_item *item = CONTAINER_OF(watcher, struct epoll_item, watcher);
+	struct epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->rdlock);
+
+	/* A closed socket is queued for the next wait to drop it */
+	if (released) {
+		item->released = true;
+	}
+
+	epoll_item_queue(ep, item);
+
+	k_spin_unlock(&ep->rdlock, key);
+}
+
+static bool epoll_item_released(struct epoll *ep, struct epoll_item *item)
+{
+	k_spinlock_key_t key;
+	bool released;
+
+	key = k_spin_lock(&ep->rdlock);
+	released = item->released;
+	k_spin_unlock(&ep->rdlock, key);
+
+	return released;
+}
+
+/* Called with the lock of the instance held */
+static void epoll_item_remove(struct epoll *ep, struct epoll_item *item)
+{
+	k_spinlock_key_t key;
+
+	/* The context may have been reused once released */
+	if (!epoll_item_released(ep, item)) {
+		net_context_unwatch(item->ctx, &item->watcher);
+	}
+
+	key = k_spin_lock(&ep->rdlock);
+
+	if (item->queued) {
+		sys_dlist_remove(&item->rdnode);
+	}
+
+	k_spin_unlock(&ep->rdlock, key);
+
+	sys_dlist_remove(&item->node);
+	k_mem_slab_free(&epoll_item_slab, item);
+}
+
+static struct epoll_item *epoll_item_find(struct epoll *ep, int fd)
+{
+	struct epoll_item *item;
+	struct epoll_item *next;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, node) {
+		if (item->fd != fd) {
+			continue;
+		}
+
+		/* The descriptor was closed, and possibly reused since */
+		if (epoll_item_released(ep, item)) {
+			epoll_item_remove(ep, item);
+			continue;
+		}
+
+		return item;
+	}
+
+	return NULL;
+}
+
+static uint32_t epoll_item_poll(struct epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->event.events & EPOLL_POLL_EVENTS,
+	};
+
+	if (zvfs_poll_internal(&pfd, 1, K_NO_WAIT) < 0) {
+		return 0;
+	}
+
+	return pfd.revents & EPOLL_REPORT_EVENTS;
+}
+
+/* Check the queued sockets, called with the lock of the instance held */
+static int epoll_collect(struct epoll *ep, struct zsock_epoll_event *events,
+			 int maxevents)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	sys_dlist_t txlist;
+	uint32_t revents;
+	bool requeue;
+	int count = 0;
+
+	sys_dlist_init(&txlist);
+
+	/* Callbacks happening while the sockets are checked queue them again */
+	key = k_spin_lock(&ep->rdlock);
+
+	while ((node = sys_dlist_get(&ep->rdlist)) != NULL) {
+		item = CONTAINER_OF(node, struct epoll_item, rdnode);
+		item->notified = false;
+		sys_dlist_append(&txlist, node);
+	}
+
+	k_spin_unlock(&ep->rdlock, key);
+
+	while ((node = sys_dlist_get(&txlist)) != NULL) {
+		item = CONTAINER_OF(node, struct epoll_item, rdnode);
+
+		if (count == maxevents) {
+			/* Left for the next wait */
+			key = k_spin_lock(&ep->rdlock);
+			sys_dlist_append(&ep->rdlist, node);
+			k_spin_unlock(&ep->rdlock, key);
+			continue;
+		}
+
+		if (epoll_item_released(ep, item)) {
+			key = k_spin_lock(&ep->rdlock);
+			item->queued = false;
+			k_spin_unlock(&ep->rdlock, key);
+
+			epoll_item_remove(ep, item);
+			continue;
+		}
+
+		revents = item->armed ? epoll_item_poll(item) : 0;
+		if (revents != 0) {
+			events[count].events = revents;
+			events[count].data = item->event.data;
+			count++;
+
+			if (item->event.events & ZSOCK_EPOLLONESHOT) {
+				item->armed = false;
+			}
+		}
+
+		requeue = revents != 0 &&
+			  !(item->event.events & (ZSOCK_EPOLLET | ZSOCK_EPOLLONESHOT));
+
+		key = k_spin_lock(&ep->rdlock);
+
+		if (requeue || item->notified) {
+			sys_dlist_append(&ep->rdlist, node);
+		} else {
+			item->queued = false;
+		}
+
+		k_spin_unlock(&ep->rdlock, key);
+	}
+
+	key = k_spin_lock(&ep->rdlock);
+
+	if (sys_dlist_is_empty(&ep->rdlist)) {
+		k_poll_signal_reset(&ep->signal);
+	}
+
+	k_spin_unlock(&ep->rdlock, key);
+
+	return count;
+}
+
+static int epoll_close_op(void *obj)
+{
+	struct epoll *ep = obj;
+	struct epoll_item *item;
+	struct epoll_item *next;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, node) {
+		epoll_item_remove(ep, item);
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	k_mem_slab_free(&epoll_slab, ep);
+
+	return 0;
+}
+
+static int epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	struct epoll *ep = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zvfs_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zvfs_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		if (*pev == pev_end) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		(*pev)->obj = &ep->signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		return 0;
+	}
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zvfs_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zvfs_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		/* Queued sockets may turn out not ready, like a spurious
+		 * wakeup, epoll_wait() then returns 0.
+		 */
+		if ((*pev)->state != K_POLL_STATE_NOT_READY) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+
+		(*pev)++;
+
+		return 0;
+	}
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.close = epoll_close_op,
+	.ioctl = epoll_ioctl_op,
+};
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct epoll *ep;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (k_mem_slab_alloc(&epoll_slab, (void **)&ep, K_NO_WAIT) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		k_mem_slab_free(&epoll_slab, ep);
+		return -1;
+	}
+
+	memset(ep, 0, sizeof(*ep));
+	k_mutex_init(&ep->lock);
+	k_poll_signal_init(&ep->signal);
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->rdlist);
+
+	zvfs_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <zephyr/syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static int epoll_add(struct epoll *ep, int fd,
+		     const struct zsock_epoll_event *event)
+{
+	struct net_context *ctx;
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	int ret;
+
+	/* Only native sockets report their readiness changes */
+	ctx = zvfs_get_fd_obj(fd, (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			      EPERM);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (epoll_item_find(ep, fd) != NULL) {
+		errno = EEXIST;
+		return -1;
+	}
+
+	if (k_mem_slab_alloc(&epoll_item_slab, (void **)&item, K_NO_WAIT) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	*item = (struct epoll_item){
+		.watcher.cb = epoll_item_cb,
+		.ep = ep,
+		.ctx = ctx,
+		.event = *event,
+		.fd = fd,
+		.armed = true,
+	};
+
+	ret = net_context_watch(ctx, &item->watcher);
+	if (ret < 0) {
+		k_mem_slab_free(&epoll_item_slab, item);
+		errno = -ret;
+		return -1;
+	}
+
+	sys_dlist_append(&ep->items, &item->node);
+
+	/* The socket may be ready already */
+	key = k_spin_lock(&ep->rdlock);
+	epoll_item_queue(ep, item);
+	k_spin_unlock(&ep->rdlock, key);
+
+	return 0;
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	struct epoll *ep;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_add(ep, fd, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		item = epoll_item_find(ep, fd);
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		item->event = *event;
+		item->armed = true;
+
+		key = k_spin_lock(&ep->rdlock);
+		epoll_item_queue(ep, item);
+		k_spin_unlock(&ep->rdlock, key);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		item = epoll_item_find(ep, fd);
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		epoll_item_remove(ep, item);
+		break;
+
+	default:
+		errno = EINVAL;
+		ret = -1;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != NULL) {
+		K_OOPS(k_usermode_from_copy(&event_copy, event,
+					    sizeof(event_copy)));
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd,
+				      event != NULL ? &event_copy : NULL);
+}
+#include <zephyr/syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct k_poll_event event;
+	k_timepoint_t end;
+	struct epoll *ep;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &ep->signal);
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	while (true) {
+		ret = epoll_collect(ep, events, maxevents);
+		if (ret != 0 || sys_timepoint_expired(end)) {
+			break;
+		}
+
+		k_mutex_unlock(&ep->lock);
+
+		event.state = K_POLL_STATE_NOT_READY;
+		(void)k_poll(&event, 1, sys_timepoint_timeout(end));
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (maxevents > 0) {
+		K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+						    sizeof(*events)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <zephyr/syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
@@ -75,6 +75,7 @@ static void zsock_flush_queue(struct net_context *ctx)
 
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+	net_context_notify(ctx);
 }
 
 static int zsock_socket_internal(int family, int type, int proto)
@@ -203,6 +204,7 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+		net_context_notify(parent);
 	}
 
 }
@@ -256,6 +258,7 @@ static void zsock_received_cb(struct net_context *ctx,
 unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+	net_context_notify(ctx);
 
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
@@ -593,6 +596,16 @@ out:
 	return -1;
 }
 
+/* Zero-copy sends are refused until the completions are read from the error
+ * queue, waiting for network buffers would not help then.
+ */
+static bool sock_zerocopy_refused(struct net_context *ctx, int flags,
+				  int status)
+{
+	return status == -ENOBUFS && (flags & ZSOCK_MSG_ZEROCOPY) &&
+	       net_context_has_zerocopy_completion(ctx);
+}
+
 ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 			 int flags,
 			 const struct sockaddr *dest_addr, socklen_t addrlen)
@@ -600,6 +613,16 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	k_timeout_t timeout = K_FOREVER;
 	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
 	k_timepoint_t buf_timeout, end;
+	struct iovec iov = {
+		.iov_base = (void *)buf,
+		.iov_len = len,
+	};
+	struct msghdr msg = {
+		.msg_name = (struct sockaddr *)dest_addr,
+		.msg_namelen = addrlen,
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
 	int status;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
@@ -622,7 +645,11 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	}
 
 	while (1) {
-		if (dest_addr) {
+		if (flags & ZSOCK_MSG_ZEROCOPY) {
+			/* Only the message based send passes the flags */
+			status = net_context_sendmsg(ctx, &msg, flags, NULL,
+						     timeout, ctx->user_data);
+		} else if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
 						    addrlen, NULL, timeout,
 						    ctx->user_data);
@@ -631,6 +658,11 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 						  ctx->user_data);
 		}
 
+		if (sock_zerocopy_refused(ctx, flags, status)) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
 		if (status < 0) {
 			status = send_check_and_wait(ctx, status, buf_timeout,
 						     timeout, &retry_timeout);
@@ -669,6 +701,59 @@ ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 
 	while (1) {
 		status = net_context_sendmsg(ctx, msg, flags, NULL, timeout, NULL);
+		if (sock_zerocopy_refused(ctx, flags, status)) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status,
+						     buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+int zsock_sendmmsg_ctx(struct net_context *ctx, struct mmsghdr *msgvec,
+		       unsigned int vlen, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	/* Only the first message is waited for, the count of messages sent
+	 * is returned as soon as one of the next ones cannot be sent.
+	 */
+	while (1) {
+		status = net_context_sendmmsg(ctx, msgvec, vlen, flags, NULL,
+					      timeout, NULL);
+		if (sock_zerocopy_refused(ctx, flags, status)) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
 		if (status < 0) {
 			status = send_check_and_wait(ctx, status,
 						     buf_timeout,
@@ -1475,6 +1560,55 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	return -1;
 }
 
+/* Read the oldest zero-copy send completion, the only error queued */
+static ssize_t zsock_recv_errqueue(struct net_context *ctx, struct msghdr *msg)
+{
+	struct sock_extended_err err = {
+		.ee_origin = SO_EE_ORIGIN_ZEROCOPY,
+	};
+	bool copied;
+	int ret;
+
+	if (!net_context_has_zerocopy_completion(ctx)) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* Keep the completion until it can be read */
+	if (msg->msg_control == NULL ||
+	    msg->msg_controllen < CMSG_SPACE(sizeof(err))) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		msg->msg_controllen = 0U;
+		return 0;
+	}
+
+	ret = net_context_get_zerocopy_completion(ctx, &err.ee_info,
+						  &err.ee_data, &copied);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	if (copied) {
+		err.ee_code = SO_EE_CODE_ZEROCOPY_COPIED;
+	}
+
+	memset(msg->msg_control, 0, msg->msg_controllen);
+
+	if (net_context_get_family(ctx) == AF_INET6) {
+		(void)insert_pktinfo(msg, IPPROTO_IPV6, IPV6_RECVERR, &err,
+				     sizeof(err));
+	} else {
+		(void)insert_pktinfo(msg, IPPROTO_IP, IP_RECVERR, &err,
+				     sizeof(err));
+	}
+
+	update_msg_controllen(msg);
+	msg->msg_flags |= ZSOCK_MSG_ERRQUEUE;
+
+	return 0;
+}
+
 ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 			  int flags)
 {
@@ -1486,6 +1620,10 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 		return -1;
 	}
 
+	if (flags & ZSOCK_MSG_ERRQUEUE) {
+		return zsock_recv_errqueue(ctx, msg);
+	}
+
 	if (msg->msg_iov == NULL) {
 		errno = ENOMEM;
 		return -1;
@@ -1514,6 +1652,21 @@ static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct k_poll_event **pev,
 				  struct k_poll_event *pev_end)
 {
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	/* Zero-copy send completions are reported as errors, whatever the
+	 * requested events.
+	 */
+	if (*pev == pev_end) {
+		return -ENOMEM;
+	}
+
+	(*pev)->obj = &ctx->zerocopy.signal;
+	(*pev)->type = K_POLL_TYPE_SIGNAL;
+	(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+	(*pev)->state = K_POLL_STATE_NOT_READY;
+	(*pev)++;
+#endif
+
 	if (pfd->events & ZSOCK_POLLIN) {
 		if (*pev == pev_end) {
 			return -ENOMEM;
@@ -1553,7 +1706,8 @@ static int zsock_poll_prepare_ctx(struct net_context *ctx,
 	/* If socket is already in EOF or error, it can be reported
 	 * immediately, so we tell poll() to short-circuit wait.
 	 */
-	if (sock_is_eof(ctx) || sock_is_error(ctx)) {
+	if (sock_is_eof(ctx) || sock_is_error(ctx) ||
+	    net_context_has_zerocopy_completion(ctx)) {
 		return -EALREADY;
 	}
 
@@ -1566,6 +1720,10 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 {
 	ARG_UNUSED(ctx);
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+		(*pev)++;
+	}
+
 	if (pfd->events & ZSOCK_POLLIN) {
 		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
 			pfd->revents |= ZSOCK_POLLIN;
@@ -1587,7 +1745,7 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 		}
 	}
 
-	if (sock_is_error(ctx)) {
+	if (sock_is_error(ctx) || net_context_has_zerocopy_completion(ctx)) {
 		pfd->revents |= ZSOCK_POLLERR;
 	}
 
@@ -1770,6 +1928,22 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     optval, optlen);
+
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -1799,6 +1973,31 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 
 			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx,
+							 TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
+		case TCP_INFO:
+			ret = net_tcp_get_option(ctx, TCP_OPT_INFO,
+						 optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 
 		break;
@@ -2301,6 +2500,22 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     optval, optlen);
+
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2330,6 +2545,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx,
+							 TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -2756,6 +2986,12 @@ static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 	return zsock_sendmsg_ctx(obj, msg, flags);
 }
 
+static int sock_sendmmsg_vmeth(void *obj, struct mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg_ctx(obj, msgvec, vlen, flags);
+}
+
 static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
 {
 	return zsock_recvmsg_ctx(obj, msg, flags);
@@ -2811,6 +3047,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
+	.sendmmsg = sock_sendmmsg_vmeth,
 	.recvmsg = sock_recvmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
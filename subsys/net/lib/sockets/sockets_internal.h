@@ -71,6 +71,9 @@ struct socket_op_vtable {
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
 	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
+	/* Optional, zsock_sendmmsg() falls back to sendmsg for each message */
+	int (*sendmmsg)(void *obj, struct mmsghdr *msgvec, unsigned int vlen,
+			int flags);
 	int (*getpeername)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/zvfs/eventfd.h>
 
 static int init_socket_service(void);
@@ -170,10 +171,96 @@ static int trigger_work(struct zsock_pollfd *pev)
 	return call_work(pev, event);
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+/* Ready sockets handled per wakeup */
+#define EPOLL_EVENTS 8
+
+/* Add the sockets of the global array to a new epoll instance. Returns -1
+ * if one of them cannot be added, the sockets are then polled.
+ */
+static int epoll_setup(int count)
+{
+	struct zsock_epoll_event ev;
+	int epfd;
+
+	epfd = zsock_epoll_create(0);
+	if (epfd < 0) {
+		NET_DBG("epoll_create failed (%d), polling sockets", -errno);
+		return -1;
+	}
+
+	for (int i = 1; i < (count + 1); i++) {
+		if (ctx.events[i].fd < 0) {
+			continue;
+		}
+
+		/* Level-triggered, like poll */
+		ev.events = ctx.events[i].events;
+		ev.data.u32 = i;
+
+		if (zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, ctx.events[i].fd,
+				    &ev) < 0) {
+			NET_DBG("Cannot add fd %d to epoll (%d), polling sockets",
+				ctx.events[i].fd, -errno);
+			(void)zsock_close(epfd);
+			return -1;
+		}
+	}
+
+	return epfd;
+}
+
+/* Wait for the restart event or for ready sockets, and service the latter.
+ * Returns 1 on restart event, 0 when sockets were serviced.
+ */
+static int epoll_service(int epfd)
+{
+	struct zsock_epoll_event evs[EPOLL_EVENTS];
+	struct zsock_pollfd fds[] = {
+		ctx.events[0],
+		{ .fd = epfd, .events = ZSOCK_POLLIN },
+	};
+	int ret, i;
+
+	ret = zsock_poll(fds, ARRAY_SIZE(fds), -1);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	if (fds[0].revents) {
+		return 1;
+	}
+
+	ret = zsock_epoll_wait(epfd, evs, ARRAY_SIZE(evs), 0);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	for (int j = 0; j < ret; j++) {
+		i = evs[j].data.u32;
+
+		if (ctx.events[i].fd < 0) {
+			continue;
+		}
+
+		ctx.events[i].revents = evs[j].events;
+
+		if (trigger_work(&ctx.events[i]) < 0) {
+			NET_DBG("Triggering work failed");
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 static void socket_service_thread(void)
 {
 	int ret, i, fd, count = 0;
 	zvfs_eventfd_t value;
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	int epfd = -1;
+#endif
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
 	if (ret == 0) {
@@ -232,6 +319,28 @@ restart:
 
 	k_mutex_unlock(&lock);
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	if (epfd >= 0) {
+		(void)zsock_close(epfd);
+	}
+
+	epfd = epoll_setup(count);
+
+	while (epfd >= 0) {
+		ret = epoll_service(epfd);
+		if (ret < 0) {
+			NET_ERR("epoll failed (%d)", ret);
+			goto out;
+		}
+
+		if (ret > 0) {
+			zvfs_eventfd_read(ctx.events[0].fd, &value);
+			NET_DBG("Received restart event.");
+			goto restart;
+		}
+	}
+#endif
+
 	while (true) {
 		ret = zsock_poll(ctx.events, count + 1, -1);
 		if (ret < 0) {
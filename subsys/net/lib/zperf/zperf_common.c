@@ -110,7 +110,8 @@ int zperf_get_ipv4_addr(char *host, struct in_addr *addr)
 }
 
 int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, uint8_t tos,
-			      int priority, int tcp_nodelay, int proto)
+			      int priority, int tcp_nodelay,
+			      const char *tcp_congestion, int proto)
 {
 	socklen_t addrlen = peer_addr->sa_family == AF_INET6 ?
 			    sizeof(struct sockaddr_in6) :
@@ -200,6 +201,16 @@ int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, uint8_t tos,
 		goto error;
 	}
 
+	if (proto == IPPROTO_TCP && tcp_congestion != NULL &&
+	    tcp_congestion[0] != '\0' &&
+	    zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+			     tcp_congestion, strlen(tcp_congestion)) != 0) {
+		NET_WARN("Failed to set IPPROTO_TCP - TCP_CONGESTION socket option "
+			 "to \"%s\".", tcp_congestion);
+		ret = -errno;
+		goto error;
+	}
+
 	ret = zsock_connect(sock, peer_addr, addrlen);
 	if (ret < 0) {
 		NET_ERR("Connect failed (%d)", errno);
@@ -882,6 +882,45 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'm': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -m option\n");
+				return -ENOEXEC;
+			}
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_MAX_BATCH) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.options.udp_batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'c':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -c option\n");
+				return -ENOEXEC;
+			}
+			i++;
+			if (i >= argc) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-c <congestion control algorithm>\n");
+				return -ENOEXEC;
+			}
+			(void)memset(param.options.tcp_congestion, 0x0,
+				     sizeof(param.options.tcp_congestion));
+			strncpy(param.options.tcp_congestion, argv[i],
+				sizeof(param.options.tcp_congestion) - 1);
+
+			opt_cnt += 2;
+			break;
+
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		case 'p':
 			param.options.priority = parse_arg(&i, argc, argv);
@@ -1115,6 +1154,45 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'm': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -m option\n");
+				return -ENOEXEC;
+			}
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_MAX_BATCH) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.options.udp_batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'c':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -c option\n");
+				return -ENOEXEC;
+			}
+			i++;
+			if (i >= argc) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-c <congestion control algorithm>\n");
+				return -ENOEXEC;
+			}
+			(void)memset(param.options.tcp_congestion, 0x0,
+				     sizeof(param.options.tcp_congestion));
+			strncpy(param.options.tcp_congestion, argv[i],
+				sizeof(param.options.tcp_congestion) - 1);
+
+			opt_cnt += 2;
+			break;
+
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		case 'p':
 			param.options.priority = parse_arg(&i, argc, argv);
@@ -1473,6 +1551,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-c algo: Congestion control algorithm (e.g. reno, cubic, bbr)\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1493,6 +1572,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-c algo: Congestion control algorithm (e.g. reno, cubic, bbr)\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1542,6 +1622,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-m num: Send num datagrams per call with sendmmsg()\n"
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
@@ -1563,6 +1644,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-m num: Send num datagrams per call with sendmmsg()\n"
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
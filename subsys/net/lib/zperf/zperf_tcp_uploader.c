@@ -134,7 +134,7 @@ int zperf_tcp_upload(const struct zperf_upload_params *param,
 
 	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
 					 param->options.priority, param->options.tcp_nodelay,
-					 IPPROTO_TCP);
+					 param->options.tcp_congestion, IPPROTO_TCP);
 	if (sock < 0) {
 		return sock;
 	}
@@ -160,7 +160,7 @@ static void tcp_upload_async_work(struct k_work *work)
 
 	sock = zperf_prepare_upload_sock(&param.peer_addr, param.options.tos,
 					 param.options.priority, param.options.tcp_nodelay,
-					 IPPROTO_TCP);
+					 param.options.tcp_congestion, IPPROTO_TCP);
 
 	if (sock < 0) {
 		upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
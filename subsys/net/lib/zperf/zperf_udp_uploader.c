@@ -20,6 +20,14 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
+/* Headers of the datagrams sent in a batch, which share the payload */
+static struct {
+	struct zperf_udp_datagram datagram;
+	struct zperf_client_hdr_v1 hdr;
+} __packed batch_hdrs[CONFIG_NET_ZPERF_MAX_BATCH];
+static struct iovec batch_iov[CONFIG_NET_ZPERF_MAX_BATCH][2];
+static struct mmsghdr batch_msgs[CONFIG_NET_ZPERF_MAX_BATCH];
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -138,6 +146,56 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
+static void udp_fill_header(uint8_t *data, uint32_t id, uint32_t secs,
+			    uint32_t usecs, int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)data;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(data + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+/* Sends count datagrams from the given id with a single call, returning the
+ * number of datagrams sent.
+ */
+static int udp_send_batch(int sock, uint32_t id, uint32_t count,
+			  uint32_t secs, uint32_t usecs, int port,
+			  uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	size_t hdr_len = MIN(packet_size, sizeof(batch_hdrs[0]));
+
+	for (uint32_t i = 0; i < count; i++) {
+		udp_fill_header((uint8_t *)&batch_hdrs[i], id + i, secs, usecs,
+				port, rate_in_kbps, packet_size);
+
+		batch_iov[i][0].iov_base = &batch_hdrs[i];
+		batch_iov[i][0].iov_len = hdr_len;
+		batch_iov[i][1].iov_base = sample_packet + hdr_len;
+		batch_iov[i][1].iov_len = packet_size - hdr_len;
+
+		batch_msgs[i].msg_hdr = (struct msghdr) {
+			.msg_iov = batch_iov[i],
+			.msg_iovlen = ARRAY_SIZE(batch_iov[i]),
+		};
+	}
+
+	return zsock_sendmmsg(sock, batch_msgs, count, 0);
+}
+
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
@@ -145,7 +203,8 @@ static int udp_upload(int sock, int port,
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
-	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
+	uint32_t batch = CLAMP(param->options.udp_batch, 1U, CONFIG_NET_ZPERF_MAX_BATCH);
+	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps) * batch;
 	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
@@ -177,8 +236,6 @@ static int udp_upload(int sock, int port,
 	(void)memset(sample_packet, 'z', sizeof(sample_packet));
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint64_t usecs64;
 		uint32_t secs, usecs;
 		int64_t loop_time;
@@ -209,30 +266,29 @@ static int udp_upload(int sock, int port,
 		secs = usecs64 / USEC_PER_SEC;
 		usecs = usecs64 - (uint64_t)secs * USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
+		if (param->options.udp_batch > 0) {
+			/* Send the batch of packets */
+			ret = udp_send_batch(sock, nb_packets, batch, secs, usecs,
+					     port, rate_in_kbps, packet_size);
+			if (ret < 0) {
+				NET_ERR("Failed to send the packets (%d)", errno);
+				return -errno;
+			}
 
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
-		if (ret < 0) {
-			NET_ERR("Failed to send the packet (%d)", errno);
-			return -errno;
+			nb_packets += ret;
 		} else {
-			nb_packets++;
+			/* Fill the packet header */
+			udp_fill_header(sample_packet, nb_packets, secs, usecs,
+					port, rate_in_kbps, packet_size);
+
+			/* Send the packet */
+			ret = zsock_send(sock, sample_packet, packet_size, 0);
+			if (ret < 0) {
+				NET_ERR("Failed to send the packet (%d)", errno);
+				return -errno;
+			} else {
+				nb_packets++;
+			}
 		}
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
@@ -305,7 +361,8 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 	}
 
 	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
-					 param->options.priority, 0, IPPROTO_UDP);
+					 param->options.priority, 0, NULL,
+					 IPPROTO_UDP);
 	if (sock < 0) {
 		return sock;
 	}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __SETTINGS_ZMS_H_
+#define __SETTINGS_ZMS_H_
+
+#include <zephyr/fs/zms.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* In the ZMS backend, each setting is stored in three ZMS entries:
+ *	1. setting's name
+ *	2. setting's value
+ *	3. node of the list of all settings, used to load them
+ *
+ * The ZMS entry IDs are derived from a hash of the setting's name, so that
+ * a setting is found without reading the names of the other settings:
+ *
+ *	bit 31: always set
+ *	bits 30..(collision bits + 2): hash of the name
+ *	bits (collision bits + 1)..2: collision number
+ *	bits 1..0: entry type
+ *
+ * Settings whose names have the same hash use consecutive collision numbers.
+ * The list node holds the name IDs of the previous and next settings. The
+ * entry at ZMS_LL_HEAD_ID holds the name ID of the first setting.
+ *
+ * A setting is linked in the list before its name is written and its name is
+ * deleted before it is unlinked, so that an interrupted save or delete leaves
+ * at most a listed setting without name, which is cleaned up on load.
+ */
+#define ZMS_SETTINGS_ID_BASE BIT(31)
+#define ZMS_DATA_ID_OFFSET 1
+#define ZMS_LL_NODE_ID_OFFSET 2
+#define ZMS_LL_HEAD_ID (ZMS_SETTINGS_ID_BASE | 3)
+
+#define ZMS_COLLISIONS_SHIFT 2
+#define ZMS_COLLISIONS_MASK                                                                       \
+	GENMASK(CONFIG_SETTINGS_ZMS_MAX_COLLISIONS_BITS + ZMS_COLLISIONS_SHIFT - 1,               \
+		ZMS_COLLISIONS_SHIFT)
+#define ZMS_HASH_MASK GENMASK(30, CONFIG_SETTINGS_ZMS_MAX_COLLISIONS_BITS + ZMS_COLLISIONS_SHIFT)
+#define ZMS_MAX_COLLISIONS BIT(CONFIG_SETTINGS_ZMS_MAX_COLLISIONS_BITS)
+
+struct settings_zms_ll_node {
+	uint32_t prev;
+	uint32_t next;
+};
+
+struct settings_zms {
+	struct settings_store cf_store;
+	struct zms_fs cf_zms;
+	const struct device *flash_dev;
+	/* name ID of the first setting, 0 if there is none */
+	uint32_t ll_head;
+	/* largest collision number in use, known once all settings are loaded */
+	uint8_t max_collision;
+};
+
+/* register zms to be a source of settings */
+int settings_zms_src(struct settings_zms *cf);
+
+/* register zms to be the destination of settings */
+int settings_zms_dst(struct settings_zms *cf);
+
+/* Initialize a zms backend. */
+int settings_zms_backend_init(struct settings_zms *cf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SETTINGS_ZMS_H_ */
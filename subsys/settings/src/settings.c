@@ -25,6 +25,138 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_LOOKUP_INDEX)
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SETTINGS_LOOKUP_INDEX_SIZE),
+	     "CONFIG_SETTINGS_LOOKUP_INDEX_SIZE must be a power of 2");
+
+#define SETTINGS_INDEX_MASK (CONFIG_SETTINGS_LOOKUP_INDEX_SIZE - 1)
+#define SETTINGS_INDEX_HASH_INIT 2166136261U
+#define SETTINGS_INDEX_HASH_PRIME 16777619U
+
+/* Open addressing table of the handlers, indexed by a FNV-1a hash of their
+ * name. Deregistered dynamic handlers leave a tombstone behind so that the
+ * probe sequences of the other handlers are preserved.
+ */
+static const struct settings_handler_static *
+settings_index[CONFIG_SETTINGS_LOOKUP_INDEX_SIZE];
+static const struct settings_handler_static settings_index_removed;
+static size_t settings_index_used;
+static bool settings_index_ready;
+
+static inline uint32_t settings_index_hash(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)c) * SETTINGS_INDEX_HASH_PRIME;
+}
+
+static const struct settings_handler_static *
+settings_index_find(const char *name, size_t len, uint32_t hash)
+{
+	const struct settings_handler_static *ch;
+
+	for (uint32_t i = hash & SETTINGS_INDEX_MASK; settings_index[i] != NULL;
+	     i = (i + 1) & SETTINGS_INDEX_MASK) {
+		ch = settings_index[i];
+		if ((ch != &settings_index_removed) &&
+		    (strncmp(ch->name, name, len) == 0) &&
+		    (ch->name[len] == '\0')) {
+			return ch;
+		}
+	}
+
+	return NULL;
+}
+
+static void settings_index_add(const struct settings_handler_static *handler)
+{
+	uint32_t hash = SETTINGS_INDEX_HASH_INIT;
+	uint32_t i;
+
+	if (!settings_index_ready) {
+		return;
+	}
+
+	for (const char *c = handler->name; *c != '\0'; c++) {
+		hash = settings_index_hash(hash, *c);
+	}
+
+	for (i = hash & SETTINGS_INDEX_MASK;
+	     (settings_index[i] != NULL) &&
+	     (settings_index[i] != &settings_index_removed);
+	     i = (i + 1) & SETTINGS_INDEX_MASK) {
+	}
+
+	if (settings_index[i] == NULL) {
+		/* Keep a free entry to end the probe sequences */
+		if (settings_index_used == SETTINGS_INDEX_MASK) {
+			LOG_WRN("Lookup index full, handlers are looked up linearly");
+			settings_index_ready = false;
+			return;
+		}
+
+		settings_index_used++;
+	}
+
+	settings_index[i] = handler;
+}
+
+#if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
+static void settings_index_remove(const struct settings_handler_static *handler)
+{
+	for (uint32_t i = 0; i < CONFIG_SETTINGS_LOOKUP_INDEX_SIZE; i++) {
+		if (settings_index[i] == handler) {
+			settings_index[i] = &settings_index_removed;
+			return;
+		}
+	}
+}
+#endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+
+static void settings_index_init(void)
+{
+	memset(settings_index, 0, sizeof(settings_index));
+	settings_index_used = 0;
+	settings_index_ready = true;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_index_add(ch);
+	}
+}
+
+/* Look up the handler of each subtree of the name, from the shortest to the
+ * longest, hashing the name only once.
+ */
+static struct settings_handler_static *
+settings_index_parse_and_lookup(const char *name, const char **next)
+{
+	const struct settings_handler_static *bestmatch = NULL;
+	const struct settings_handler_static *ch;
+	uint32_t hash = SETTINGS_INDEX_HASH_INIT;
+	size_t len = 0;
+
+	while (true) {
+		if ((name[len] == SETTINGS_NAME_SEPARATOR) ||
+		    (name[len] == SETTINGS_NAME_END) || (name[len] == '\0')) {
+			ch = settings_index_find(name, len, hash);
+			if (ch != NULL) {
+				bestmatch = ch;
+				if (next) {
+					*next = (name[len] == SETTINGS_NAME_SEPARATOR) ?
+						&name[len + 1] : NULL;
+				}
+			}
+		}
+
+		if ((name[len] == SETTINGS_NAME_END) || (name[len] == '\0')) {
+			break;
+		}
+
+		hash = settings_index_hash(hash, name[len]);
+		len++;
+	}
+
+	return (struct settings_handler_static *)bestmatch;
+}
+#endif /* CONFIG_SETTINGS_LOOKUP_INDEX */
 
 void settings_store_init(void);
 
@@ -33,6 +165,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_LOOKUP_INDEX)
+	settings_index_init();
+#endif /* CONFIG_SETTINGS_LOOKUP_INDEX */
 	settings_store_init();
 }
 
@@ -59,6 +194,9 @@ int settings_register_with_cprio(struct settings_handler *handler, int cprio)
 
 	handler->cprio = cprio;
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_LOOKUP_INDEX)
+	settings_index_add((struct settings_handler_static *)handler);
+#endif /* CONFIG_SETTINGS_LOOKUP_INDEX */
 
 end:
 	k_mutex_unlock(&settings_lock);
@@ -69,6 +207,23 @@ int settings_register(struct settings_handler *handler)
 {
 	return settings_register_with_cprio(handler, 0);
 }
+
+bool settings_deregister(struct settings_handler *handler)
+{
+	bool found;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	found = sys_slist_find_and_remove(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_LOOKUP_INDEX)
+	if (found) {
+		settings_index_remove((struct settings_handler_static *)handler);
+	}
+#endif /* CONFIG_SETTINGS_LOOKUP_INDEX */
+
+	k_mutex_unlock(&settings_lock);
+	return found;
+}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
 int settings_name_steq(const char *name, const char *key, const char **next)
@@ -153,6 +308,13 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_LOOKUP_INDEX)
+	if (settings_index_ready) {
+		return (name != NULL) ?
+			settings_index_parse_and_lookup(name, next) : NULL;
+	}
+#endif /* CONFIG_SETTINGS_LOOKUP_INDEX */
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/settings/settings.h>
+#include "settings/settings_zms.h"
+#include <zephyr/sys/crc.h>
+#include "settings_priv.h"
+#include <zephyr/storage/flash_map.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+#if DT_HAS_CHOSEN(zephyr_settings_partition)
+#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
+#else
+#define SETTINGS_PARTITION FIXED_PARTITION_ID(storage_partition)
+#endif
+
+#define ZMS_NAME_ID(hash, collision) \
+	(ZMS_SETTINGS_ID_BASE | (hash) | ((collision) << ZMS_COLLISIONS_SHIFT))
+#define ZMS_COLLISION(name_id) (((name_id) & ZMS_COLLISIONS_MASK) >> ZMS_COLLISIONS_SHIFT)
+
+struct settings_zms_read_fn_arg {
+	struct zms_fs *fs;
+	uint32_t id;
+};
+
+static int settings_zms_load(struct settings_store *cs,
+			     const struct settings_load_arg *arg);
+static int settings_zms_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len);
+static void *settings_zms_storage_get(struct settings_store *cs);
+
+static struct settings_store_itf settings_zms_itf = {
+	.csi_load = settings_zms_load,
+	.csi_save = settings_zms_save,
+	.csi_storage_get = settings_zms_storage_get
+};
+
+static ssize_t settings_zms_read_fn(void *back_end, void *data, size_t len)
+{
+	struct settings_zms_read_fn_arg *rd_fn_arg;
+	ssize_t rc;
+
+	rd_fn_arg = (struct settings_zms_read_fn_arg *)back_end;
+
+	rc = zms_read(rd_fn_arg->fs, rd_fn_arg->id, data, len);
+	if (rc > (ssize_t)len) {
+		/* zms_read signals that not all bytes were read
+		 * align read len to what was requested
+		 */
+		rc = len;
+	}
+	return rc;
+}
+
+int settings_zms_src(struct settings_zms *cf)
+{
+	cf->cf_store.cs_itf = &settings_zms_itf;
+	settings_src_register(&cf->cf_store);
+
+	return 0;
+}
+
+int settings_zms_dst(struct settings_zms *cf)
+{
+	cf->cf_store.cs_itf = &settings_zms_itf;
+	settings_dst_register(&cf->cf_store);
+
+	return 0;
+}
+
+static uint32_t settings_zms_hash(const char *name)
+{
+	return crc32_ieee((const uint8_t *)name, strlen(name)) & ZMS_HASH_MASK;
+}
+
+static int settings_zms_read_node(struct settings_zms *cf, uint32_t name_id,
+				  struct settings_zms_ll_node *node)
+{
+	ssize_t rc;
+
+	rc = zms_read(&cf->cf_zms, name_id + ZMS_LL_NODE_ID_OFFSET, node, sizeof(*node));
+	if (rc < 0) {
+		return rc;
+	}
+
+	return rc == sizeof(*node) ? 0 : -EINVAL;
+}
+
+static int settings_zms_write_node(struct settings_zms *cf, uint32_t name_id,
+				   const struct settings_zms_ll_node *node)
+{
+	ssize_t rc;
+
+	rc = zms_write(&cf->cf_zms, name_id + ZMS_LL_NODE_ID_OFFSET, node, sizeof(*node));
+
+	return rc < 0 ? rc : 0;
+}
+
+static int settings_zms_write_head(struct settings_zms *cf, uint32_t name_id)
+{
+	ssize_t rc;
+
+	rc = zms_write(&cf->cf_zms, ZMS_LL_HEAD_ID, &name_id, sizeof(name_id));
+	if (rc < 0) {
+		return rc;
+	}
+
+	cf->ll_head = name_id;
+	return 0;
+}
+
+/* Add a setting at the head of the list. */
+static int settings_zms_link(struct settings_zms *cf, uint32_t name_id)
+{
+	struct settings_zms_ll_node node = {
+		.prev = 0,
+		.next = cf->ll_head,
+	};
+	int rc;
+
+	rc = settings_zms_write_node(cf, name_id, &node);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (node.next != 0) {
+		rc = settings_zms_read_node(cf, node.next, &node);
+		if (rc < 0) {
+			return rc;
+		}
+
+		node.prev = name_id;
+		rc = settings_zms_write_node(cf, cf->ll_head, &node);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return settings_zms_write_head(cf, name_id);
+}
+
+/* Remove a setting from the list and delete its node. A node left by an
+ * interrupted link is not in the list and is only deleted.
+ */
+static int settings_zms_unlink(struct settings_zms *cf, uint32_t name_id)
+{
+	struct settings_zms_ll_node node, other;
+	uint32_t prev = 0;
+	int rc;
+
+	rc = settings_zms_read_node(cf, name_id, &node);
+	if (rc == -ENOENT) {
+		return 0;
+	}
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (cf->ll_head == name_id) {
+		rc = settings_zms_write_head(cf, node.next);
+		if (rc < 0) {
+			return rc;
+		}
+	} else {
+		if (node.prev == 0) {
+			goto out;
+		}
+
+		rc = settings_zms_read_node(cf, node.prev, &other);
+		if (rc < 0 || other.next != name_id) {
+			goto out;
+		}
+
+		other.next = node.next;
+		rc = settings_zms_write_node(cf, node.prev, &other);
+		if (rc < 0) {
+			return rc;
+		}
+		prev = node.prev;
+	}
+
+	if (node.next != 0) {
+		rc = settings_zms_read_node(cf, node.next, &other);
+		if (rc == 0 && other.prev == name_id) {
+			other.prev = prev;
+			rc = settings_zms_write_node(cf, node.next, &other);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+	}
+
+out:
+	return zms_delete(&cf->cf_zms, name_id + ZMS_LL_NODE_ID_OFFSET);
+}
+
+static int settings_zms_delete(struct settings_zms *cf, uint32_t name_id)
+{
+	int rc;
+
+	/* The name goes first: a listed setting without name is cleaned up on
+	 * load, while an unlisted one with a name would never be loaded.
+	 */
+	rc = zms_delete(&cf->cf_zms, name_id);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = settings_zms_unlink(cf, name_id);
+	if (rc < 0) {
+		return rc;
+	}
+
+	return zms_delete(&cf->cf_zms, name_id + ZMS_DATA_ID_OFFSET);
+}
+
+static int settings_zms_load(struct settings_store *cs,
+			     const struct settings_load_arg *arg)
+{
+	int ret = 0;
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+	struct settings_zms_read_fn_arg read_fn_arg;
+	struct settings_zms_ll_node node;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint32_t name_id = cf->ll_head;
+	uint8_t max_collision = 0;
+	ssize_t rc1, rc2;
+
+	while (name_id != 0) {
+		ret = settings_zms_read_node(cf, name_id, &node);
+		if (ret < 0) {
+			LOG_ERR("Settings list broken at %x (err %d)", name_id, ret);
+			return ret;
+		}
+
+		rc1 = zms_read(&cf->cf_zms, name_id, &name, sizeof(name) - 1);
+		rc2 = zms_get_data_length(&cf->cf_zms, name_id + ZMS_DATA_ID_OFFSET);
+
+		if ((rc1 <= 0) || (rc2 <= 0)) {
+			/* Settings item is not stored correctly in the ZMS,
+			 * save or delete was interrupted. Clean the dirty
+			 * entries.
+			 */
+			zms_delete(&cf->cf_zms, name_id);
+			ret = settings_zms_unlink(cf, name_id);
+			if (ret < 0) {
+				return ret;
+			}
+			zms_delete(&cf->cf_zms, name_id + ZMS_DATA_ID_OFFSET);
+			name_id = node.next;
+			continue;
+		}
+
+		max_collision = MAX(max_collision, ZMS_COLLISION(name_id));
+
+		/* Found a name, this might not include a trailing \0 */
+		name[MIN(rc1, sizeof(name) - 1)] = '\0';
+
+		/* Skip reading the value of names out of the subtree */
+		if (arg->subtree && !settings_name_steq(name, arg->subtree, NULL)) {
+			name_id = node.next;
+			continue;
+		}
+
+		read_fn_arg.fs = &cf->cf_zms;
+		read_fn_arg.id = name_id + ZMS_DATA_ID_OFFSET;
+
+		ret = settings_call_set_handler(
+			name, rc2,
+			settings_zms_read_fn, &read_fn_arg,
+			(void *)arg);
+		if (ret) {
+			return ret;
+		}
+
+		name_id = node.next;
+	}
+
+	/* All collision numbers in use are known once all settings are seen */
+	if (!arg->subtree) {
+		cf->max_collision = max_collision;
+	}
+
+	return 0;
+}
+
+static int settings_zms_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len)
+{
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint32_t hash, id, name_id = 0, write_name_id = 0;
+	bool delete;
+	ssize_t rc;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	/* Find out if we are doing a delete */
+	delete = ((value == NULL) || (val_len == 0));
+
+	hash = settings_zms_hash(name);
+
+	for (uint32_t i = 0; i < ZMS_MAX_COLLISIONS; i++) {
+		id = ZMS_NAME_ID(hash, i);
+
+		if (i > cf->max_collision) {
+			/* Collision numbers above are not in use */
+			if (write_name_id == 0) {
+				write_name_id = id;
+			}
+			break;
+		}
+
+		rc = zms_read(&cf->cf_zms, id, &rdname, sizeof(rdname) - 1);
+		if (rc < 0) {
+			/* Error or entry not found */
+			if (rc == -ENOENT && write_name_id == 0) {
+				write_name_id = id;
+			}
+			continue;
+		}
+
+		rdname[MIN(rc, sizeof(rdname) - 1)] = '\0';
+
+		if (strcmp(name, rdname) == 0) {
+			name_id = id;
+			break;
+		}
+	}
+
+	if (delete) {
+		if (name_id == 0) {
+			return 0;
+		}
+
+		rc = settings_zms_delete(cf, name_id);
+		return rc < 0 ? rc : 0;
+	}
+
+	if (name_id != 0) {
+		/* Existing setting, only the value changes */
+		rc = zms_write(&cf->cf_zms, name_id + ZMS_DATA_ID_OFFSET, value, val_len);
+		return rc < 0 ? rc : 0;
+	}
+
+	/* No free IDs left. */
+	if (write_name_id == 0) {
+		return -ENOMEM;
+	}
+
+	cf->max_collision = MAX(cf->max_collision, ZMS_COLLISION(write_name_id));
+
+	/* Drop what an interrupted save or delete may have left in this slot */
+	rc = settings_zms_unlink(cf, write_name_id);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* write the value */
+	rc = zms_write(&cf->cf_zms, write_name_id + ZMS_DATA_ID_OFFSET, value, val_len);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = settings_zms_link(cf, write_name_id);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* write the name */
+	rc = zms_write(&cf->cf_zms, write_name_id, name, strlen(name));
+	if (rc < 0) {
+		return rc;
+	}
+
+	return 0;
+}
+
+/* Initialize the zms backend. */
+int settings_zms_backend_init(struct settings_zms *cf)
+{
+	ssize_t rc;
+	uint32_t ll_head;
+
+	cf->cf_zms.flash_device = cf->flash_dev;
+	if (cf->cf_zms.flash_device == NULL) {
+		return -ENODEV;
+	}
+
+	rc = zms_mount(&cf->cf_zms);
+	if (rc) {
+		return rc;
+	}
+
+	rc = zms_read(&cf->cf_zms, ZMS_LL_HEAD_ID, &ll_head, sizeof(ll_head));
+	if (rc == sizeof(ll_head)) {
+		cf->ll_head = ll_head;
+	} else {
+		cf->ll_head = 0;
+	}
+
+	/* Unknown until all settings are loaded */
+	cf->max_collision = ZMS_MAX_COLLISIONS - 1;
+
+	LOG_DBG("Initialized");
+	return 0;
+}
+
+int settings_backend_init(void)
+{
+	static struct settings_zms default_settings_zms;
+	int rc;
+	uint32_t cnt = 0;
+	size_t zms_sector_size, zms_size = 0;
+	const struct flash_area *fa;
+	struct flash_sector hw_flash_sector;
+	uint32_t sector_cnt = 1;
+
+	rc = flash_area_open(SETTINGS_PARTITION, &fa);
+	if (rc) {
+		return rc;
+	}
+
+	rc = flash_area_get_sectors(SETTINGS_PARTITION, &sector_cnt,
+				    &hw_flash_sector);
+	if (rc != 0 && rc != -ENOMEM) {
+		return rc;
+	}
+
+	zms_sector_size = CONFIG_SETTINGS_ZMS_SECTOR_SIZE_MULT *
+			  hw_flash_sector.fs_size;
+
+	while (cnt < CONFIG_SETTINGS_ZMS_SECTOR_COUNT) {
+		zms_size += zms_sector_size;
+		if (zms_size > fa->fa_size) {
+			break;
+		}
+		cnt++;
+	}
+
+	/* define the zms file system using the page_info */
+	default_settings_zms.cf_zms.sector_size = zms_sector_size;
+	default_settings_zms.cf_zms.sector_count = cnt;
+	default_settings_zms.cf_zms.offset = fa->fa_off;
+	default_settings_zms.flash_dev = fa->fa_dev;
+
+	rc = settings_zms_backend_init(&default_settings_zms);
+	if (rc) {
+		return rc;
+	}
+
+	rc = settings_zms_src(&default_settings_zms);
+
+	if (rc) {
+		return rc;
+	}
+
+	rc = settings_zms_dst(&default_settings_zms);
+
+	return rc;
+}
+
+static void *settings_zms_storage_get(struct settings_store *cs)
+{
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+
+	return &cf->cf_zms;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark comparing the allocation and free costs
+ * of a sys_heap with and without its slab caches enabled, under the same
+ * pseudo-random churn of mostly small blocks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/tc_util.h>
+
+#define HEAP_SZ CONFIG_BENCHMARK_HEAP_SIZE
+
+static void *heapmem[HEAP_SZ / sizeof(void *)];
+static void *scratchmem[HEAP_SZ / 2 / sizeof(void *)];
+
+static void *bench_alloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void bench_free(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+static void run(bool slab, int target_percent)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result r;
+	struct sys_heap_slab_stats stats;
+
+	sys_heap_init(&heap, heapmem, HEAP_SZ);
+	if (slab) {
+		sys_heap_slab_enable(&heap);
+	}
+
+	sys_heap_stress(bench_alloc, bench_free, &heap, HEAP_SZ,
+			CONFIG_BENCHMARK_NUM_OPERATIONS,
+			scratchmem, sizeof(scratchmem),
+			target_percent, &r);
+
+	printk("%s heap, %d%% target fill\n", slab ? "Slab" : "Plain",
+	       target_percent);
+	printk("    Alloc   : %7llu cycles\n", r.alloc_cycles / r.total_allocs);
+	printk("    Free    : %7llu cycles\n", r.free_cycles / r.total_frees);
+	printk("    Success : %7u / %u allocations\n",
+	       r.successful_allocs, r.total_allocs);
+
+	for (int i = 0; slab && (i < CONFIG_SYS_HEAP_SLAB_CLASSES); i++) {
+		uint32_t total;
+
+		sys_heap_slab_stats_get(&heap, i, &stats);
+		total = stats.hits + stats.misses;
+		printk("    Class %4zu: %3u%% hits (%u allocations)\n",
+		       stats.block_size,
+		       (total == 0U) ? 0U : (100U * stats.hits / total), total);
+	}
+}
+
+int main(void)
+{
+	static const int targets[] = { 50, 100 };
+
+	printk("Heap slab benchmark: %d byte heaps, %d operations\n",
+	       HEAP_SZ, CONFIG_BENCHMARK_NUM_OPERATIONS);
+
+	for (int i = 0; i < ARRAY_SIZE(targets); i++) {
+		run(false, targets[i]);
+		run(true, targets[i]);
+		printk("------------------------------------\n");
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/random/random.h>
+#include <zephyr/tc_util.h>
+
+#include "net_private.h"
+
+/* This benchmark measures the Internet checksum over buffer sizes and
+ * alignments: the sum alone, a plain copy, and the copy and sum in a single
+ * pass. The copies are made to the same alignment as the source, which the
+ * word loop requires, and then to a misaligned destination.
+ */
+
+#define MAX_SIZE 1500
+
+static const size_t sizes[] = { 20, 64, 256, 576, MAX_SIZE };
+
+static uint8_t src_buf[MAX_SIZE + 8] __aligned(4);
+static uint8_t dst_buf[MAX_SIZE + 8] __aligned(4);
+
+/* Keeps the compiler from dropping the sums */
+static volatile uint16_t sink;
+
+enum bench_op {
+	BENCH_SUM,
+	BENCH_MEMCPY,
+	BENCH_SUM_COPY,
+	BENCH_SUM_COPY_MISALIGNED,
+};
+
+static uint32_t run(enum bench_op op, size_t align, size_t size)
+{
+	const uint8_t *src = src_buf + align;
+	uint64_t cycles = 0U;
+	uint32_t start;
+	uint16_t sum = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = k_cycle_get_32();
+
+		switch (op) {
+		case BENCH_SUM:
+			sum = calc_chksum(sum, src, size);
+			break;
+		case BENCH_MEMCPY:
+			memcpy(dst_buf + align, src, size);
+			break;
+		case BENCH_SUM_COPY:
+			sum = calc_chksum_copy(sum, dst_buf + align, src, size);
+			break;
+		case BENCH_SUM_COPY_MISALIGNED:
+			sum = calc_chksum_copy(sum, dst_buf + align + 1, src, size);
+			break;
+		}
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	sink = sum;
+
+	return (uint32_t)(cycles / CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+/* Megabytes per second of size bytes processed in the given cycles */
+static uint32_t rate(size_t size, uint32_t cycles)
+{
+	uint64_t ns = MAX(k_cyc_to_ns_floor64(cycles), 1U);
+
+	return (uint32_t)((uint64_t)size * NSEC_PER_SEC / ns / 1000000U);
+}
+
+static bool check(size_t align, size_t size)
+{
+	uint16_t sum = calc_chksum(0U, src_buf + align, size);
+
+	memset(dst_buf, 0, sizeof(dst_buf));
+
+	if (calc_chksum_copy(0U, dst_buf + align, src_buf + align, size) != sum ||
+	    memcmp(dst_buf + align, src_buf + align, size) != 0) {
+		printk("Copy and sum of %zu bytes at alignment %zu failed\n",
+		       size, align);
+		return false;
+	}
+
+	if (calc_chksum_copy(0U, dst_buf + align + 1, src_buf + align, size) != sum ||
+	    memcmp(dst_buf + align + 1, src_buf + align, size) != 0) {
+		printk("Misaligned copy and sum of %zu bytes at alignment %zu failed\n",
+		       size, align);
+		return false;
+	}
+
+	return true;
+}
+
+int main(void)
+{
+	uint32_t sum;
+	uint32_t copy;
+	uint32_t sum_copy;
+	uint32_t sum_copy_mis;
+
+	printk("Internet checksum benchmark: %s word sum\n",
+	       IS_ENABLED(CONFIG_NET_CHKSUM_ARCH) ? "architecture" : "generic");
+
+	sys_rand_get(src_buf, sizeof(src_buf));
+
+	printk("size align   sum (MB/s)  memcpy (MB/s)  copy+sum (MB/s)  misaligned (MB/s)\n");
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		for (size_t align = 0; align < sizeof(uint32_t); align++) {
+			if (!check(align, sizes[i])) {
+				goto fail;
+			}
+
+			sum = run(BENCH_SUM, align, sizes[i]);
+			copy = run(BENCH_MEMCPY, align, sizes[i]);
+			sum_copy = run(BENCH_SUM_COPY, align, sizes[i]);
+			sum_copy_mis = run(BENCH_SUM_COPY_MISALIGNED, align, sizes[i]);
+
+			printk("%4zu %5zu %6u (%4u) %7u (%4u) %9u (%4u) %10u (%4u)\n",
+			       sizes[i], align,
+			       sum, rate(sizes[i], sum),
+			       copy, rate(sizes[i], copy),
+			       sum_copy, rate(sizes[i], sum_copy),
+			       sum_copy_mis, rate(sizes[i], sum_copy_mis));
+		}
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+
+fail:
+	TC_END_REPORT(TC_FAIL);
+
+	return 0;
+}
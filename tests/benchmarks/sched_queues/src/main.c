@@ -84,6 +84,13 @@ static void start_threads(unsigned int num_threads)
 		k_thread_create(&test_thread[i], test_stack, TEST_STACK_SIZE,
 				test_entry, (void *)(uintptr_t)i, NULL, NULL,
 				i / bucket_size, 0, K_NO_WAIT);
+#ifdef CONFIG_SCHED_DEADLINE
+		/* Scatter the deadlines within each priority so that the
+		 * ready queue has to sort threads of equal priority.
+		 */
+		k_thread_deadline_set(&test_thread[i],
+				      ((i * 7919U) % bucket_size + 1) * 1000);
+#endif /* CONFIG_SCHED_DEADLINE */
 	}
 }
 
@@ -218,9 +225,10 @@ int main(void)
 
 	freq = timing_freq_get_mhz();
 
-	printk("Time Measurements for %s sched queues\n",
+	printk("Time Measurements for %s sched queues%s\n",
 	       IS_ENABLED(CONFIG_SCHED_DUMB) ? "dumb" :
-	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
+	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq",
+	       IS_ENABLED(CONFIG_SCHED_DEADLINE) ? " with deadlines" : "");
 	printk("Timing results: Clock frequency: %u MHz\n", freq);
 
 	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
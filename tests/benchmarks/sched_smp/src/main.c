@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/tc_util.h>
+
+/* This is an SMP scheduler benchmark measuring cross-CPU wakeup and
+ * context switch cost.  Pairs of equal priority threads ping-pong a
+ * pair of semaphores:
+ *
+ * 1. The ping thread stamps the time and gives the pong semaphore
+ * 2. The pong thread wakes, takes it and gives the ping semaphore
+ * 3. The ping thread wakes, takes it and stamps the round trip
+ *
+ * Every round trip is thus two wakeups and two context switches.
+ * The number of pairs exceeds the number of CPUs, so all CPUs stay
+ * busy and wakeups regularly have to be serviced by other CPUs.
+ */
+
+#define NUM_PAIRS   (CONFIG_MP_MAX_NUM_CPUS * CONFIG_BENCHMARK_PAIRS_PER_CPU)
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define THREAD_PRIO K_PRIO_PREEMPT(2)
+
+struct pair {
+	struct k_sem ping_sem;
+	struct k_sem pong_sem;
+	struct k_thread ping_thread;
+	struct k_thread pong_thread;
+	uint64_t cycles;
+	uint32_t round_trips;
+	uint32_t migrations;
+};
+
+static struct pair pairs[NUM_PAIRS];
+
+static K_THREAD_STACK_ARRAY_DEFINE(ping_stacks, NUM_PAIRS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(pong_stacks, NUM_PAIRS, STACK_SIZE);
+
+static volatile bool stop;
+
+static int curr_cpu(void)
+{
+	unsigned int key = arch_irq_lock();
+	int ret = arch_curr_cpu()->id;
+
+	arch_irq_unlock(key);
+	return ret;
+}
+
+static void ping_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!stop) {
+		int cpu = curr_cpu();
+		uint32_t start = k_cycle_get_32();
+
+		k_sem_give(&p->pong_sem);
+		k_sem_take(&p->ping_sem, K_FOREVER);
+
+		p->cycles += k_cycle_get_32() - start;
+		p->round_trips++;
+		if (curr_cpu() != cpu) {
+			p->migrations++;
+		}
+	}
+}
+
+static void pong_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&p->pong_sem, K_FOREVER);
+		k_sem_give(&p->ping_sem);
+	}
+}
+
+int main(void)
+{
+	uint64_t total = 0;
+	int i;
+
+	printk("SMP wakeup benchmark: %u CPUs, %d pairs\n",
+	       arch_num_cpus(), NUM_PAIRS);
+
+	for (i = 0; i < NUM_PAIRS; i++) {
+		k_sem_init(&pairs[i].ping_sem, 0, 1);
+		k_sem_init(&pairs[i].pong_sem, 0, 1);
+
+		k_thread_create(&pairs[i].pong_thread, pong_stacks[i],
+				STACK_SIZE, pong_fn, &pairs[i], NULL, NULL,
+				THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&pairs[i].ping_thread, ping_stacks[i],
+				STACK_SIZE, ping_fn, &pairs[i], NULL, NULL,
+				THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+	stop = true;
+
+	for (i = 0; i < NUM_PAIRS; i++) {
+		k_thread_join(&pairs[i].ping_thread, K_FOREVER);
+		k_thread_abort(&pairs[i].pong_thread);
+	}
+
+	for (i = 0; i < NUM_PAIRS; i++) {
+		struct pair *p = &pairs[i];
+		uint32_t avg = (p->round_trips == 0U) ? 0U
+			       : (uint32_t)(p->cycles / p->round_trips);
+
+		printk("pair %2d: round trips %8u migrated %8u avg %7u cycles (%7u nsec)\n",
+		       i, p->round_trips, p->migrations, avg,
+		       (uint32_t)k_cyc_to_ns_floor64(avg));
+		total += p->round_trips;
+	}
+
+	printk("total: %llu round trips, %llu round trips/s\n", total,
+	       total * MSEC_PER_SEC / CONFIG_BENCHMARK_DURATION_MS);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+
+/* This benchmark measures the boot time cost of settings_load():
+ *
+ * 1. It erases the settings partition and saves CONFIG_BENCHMARK_NUM_KEYS
+ *    settings "bench/kNNNN", timing the saves
+ * 2. It loads all the settings back, checking that the handler sees each
+ *    of them
+ * 3. It loads the subtree of a single setting
+ */
+
+#if DT_HAS_CHOSEN(zephyr_settings_partition)
+#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
+#else
+#define SETTINGS_PARTITION FIXED_PARTITION_ID(storage_partition)
+#endif
+
+#define KEY_FMT "bench/k%04u"
+#define KEY_LEN sizeof("bench/k0000")
+
+static unsigned int loaded;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+
+	ARG_UNUSED(name);
+
+	if (len != sizeof(val) || read_cb(cb_arg, &val, sizeof(val)) != len) {
+		return -EINVAL;
+	}
+
+	loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static void report(const char *what, uint64_t cycles, unsigned int count)
+{
+	printk("%-24s %9u cycles (%9u nsec) per operation\n", what,
+	       (uint32_t)(cycles / count),
+	       (uint32_t)(k_cyc_to_ns_floor64(cycles) / count));
+}
+
+static int erase_partition(void)
+{
+	const struct flash_area *fa;
+	int ret;
+
+	ret = flash_area_open(SETTINGS_PARTITION, &fa);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = flash_area_flatten(fa, 0, fa->fa_size);
+	flash_area_close(fa);
+
+	return ret;
+}
+
+int main(void)
+{
+	char key[KEY_LEN];
+	uint64_t cycles = 0U;
+	uint32_t start;
+	uint32_t val;
+	int ret;
+
+	printk("Settings load benchmark: %u settings\n",
+	       CONFIG_BENCHMARK_NUM_KEYS);
+
+	ret = erase_partition();
+	if (ret < 0) {
+		printk("Cannot erase the settings partition: %d\n", ret);
+		goto fail;
+	}
+
+	ret = settings_subsys_init();
+	if (ret < 0) {
+		printk("Cannot initialize settings: %d\n", ret);
+		goto fail;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_KEYS; i++) {
+		snprintf(key, sizeof(key), KEY_FMT, i);
+		val = i;
+
+		start = k_cycle_get_32();
+		ret = settings_save_one(key, &val, sizeof(val));
+		cycles += k_cycle_get_32() - start;
+
+		if (ret < 0) {
+			printk("Save of %s failed: %d\n", key, ret);
+			goto fail;
+		}
+	}
+
+	report("settings_save_one()", cycles, CONFIG_BENCHMARK_NUM_KEYS);
+
+	loaded = 0U;
+	start = k_cycle_get_32();
+	ret = settings_load();
+	cycles = k_cycle_get_32() - start;
+
+	if (ret < 0 || loaded != CONFIG_BENCHMARK_NUM_KEYS) {
+		printk("Load failed: %d, %u settings loaded\n", ret, loaded);
+		goto fail;
+	}
+
+	report("settings_load()", cycles, 1U);
+
+	snprintf(key, sizeof(key), KEY_FMT, CONFIG_BENCHMARK_NUM_KEYS / 2U);
+
+	loaded = 0U;
+	start = k_cycle_get_32();
+	ret = settings_load_subtree(key);
+	cycles = k_cycle_get_32() - start;
+
+	if (ret < 0 || loaded != 1U) {
+		printk("Load of %s failed: %d, %u settings loaded\n", key, ret,
+		       loaded);
+		goto fail;
+	}
+
+	report("settings_load_subtree()", cycles, 1U);
+
+	TC_END_REPORT(TC_PASS);
+	return 0;
+
+fail:
+	TC_END_REPORT(TC_FAIL);
+	return 0;
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "tcp.h"
+#include "tcp_private.h"
+
+/* This benchmark measures the TCP input rate of established connections
+ * against the number of connections.  The device listens on a port of a
+ * dummy interface and the benchmark plays the remote peer:
+ *
+ * 1. It opens connections from successive source ports, sending a SYN,
+ *    picking the SYN-ACK up from the dummy interface and sending an ACK
+ * 2. It feeds pure ACKs to the established connections, round robin,
+ *    timing their input
+ *
+ * The RX and TX traffic classes are disabled, so segments are processed,
+ * and any replies sent, synchronously from net_recv_data().
+ */
+
+#define MY_PORT   4242
+#define PEER_PORT 10000
+#define PEER_ISS  1000U
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static const unsigned int num_conns[] = {
+	1, 10, 100, CONFIG_BENCHMARK_NUM_CONNS
+};
+
+static struct net_if *iface;
+
+/* Sequence number of the SYN-ACK received on each connection */
+static uint32_t syn_ack_seq[CONFIG_BENCHMARK_NUM_CONNS];
+static K_SEM_DEFINE(syn_ack_sem, 0, 1);
+
+static atomic_t accepted;
+static atomic_t resets;
+
+static uint8_t mac_addr[sizeof(struct net_eth_addr)] = {
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	0x00, 0x00, 0x5E, 0x00, 0x53, 0x01
+};
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	unsigned int idx;
+
+	ARG_UNUSED(dev);
+
+	if (NET_IPV4_HDR(pkt)->proto != IPPROTO_TCP) {
+		return 0;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ip_opts_len(pkt)) < 0 ||
+	    net_pkt_read(pkt, &th, sizeof(th)) < 0) {
+		return -EINVAL;
+	}
+
+	idx = ntohs(th_dport(&th)) - PEER_PORT;
+
+	if (th_flags(&th) & RST) {
+		atomic_inc(&resets);
+	} else if ((th_flags(&th) & (SYN | ACK)) == (SYN | ACK) &&
+		   idx < ARRAY_SIZE(syn_ack_seq)) {
+		syn_ack_seq[idx] = th_seq(&th);
+		k_sem_give(&syn_ack_sem);
+	}
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(tcp_bench, "tcp_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static struct net_pkt *peer_segment(unsigned int idx, uint8_t flags,
+				    uint32_t seq, uint32_t ack)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct tcphdr), AF_INET,
+					IPPROTO_TCP, K_NO_WAIT);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) < 0) {
+		goto fail;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (th == NULL) {
+		goto fail;
+	}
+
+	memset(th, 0, sizeof(*th));
+	th->th_sport = htons(PEER_PORT + idx);
+	th->th_dport = htons(MY_PORT);
+	th->th_off = 5U;
+	th->th_flags = flags;
+	th->th_win = htons(NET_IPV4_MTU);
+	th->th_seq = htonl(seq);
+	th->th_ack = htonl(ack);
+
+	if (net_pkt_set_data(pkt, &tcp_access) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv4_finalize(pkt, IPPROTO_TCP) < 0) {
+		goto fail;
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static int peer_input(struct net_pkt *pkt)
+{
+	int ret;
+
+	if (pkt == NULL) {
+		return -ENOMEM;
+	}
+
+	ret = net_recv_data(iface, pkt);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static int peer_connect(unsigned int idx)
+{
+	int ret;
+
+	ret = peer_input(peer_segment(idx, SYN, PEER_ISS, 0U));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (k_sem_take(&syn_ack_sem, K_MSEC(100)) != 0) {
+		return -ETIMEDOUT;
+	}
+
+	return peer_input(peer_segment(idx, ACK, PEER_ISS + 1U,
+				       syn_ack_seq[idx] + 1U));
+}
+
+static void accept_cb(struct net_context *ctx, struct sockaddr *addr,
+		      socklen_t addrlen, int status, void *user_data)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addrlen);
+	ARG_UNUSED(user_data);
+
+	if (status == 0) {
+		/* Keep the connection for the whole benchmark */
+		net_context_ref(ctx);
+		atomic_inc(&accepted);
+	}
+}
+
+static int listen_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(MY_PORT),
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+	struct net_context *ctx;
+	int ret;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_context_listen(ctx, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return net_context_accept(ctx, accept_cb, K_NO_WAIT, NULL);
+}
+
+/**
+ * Feed CONFIG_BENCHMARK_NUM_SEGMENTS pure ACKs, round robin, to the first
+ * @a count connections and report the input rate.
+ */
+static int measure(unsigned int count)
+{
+	uint64_t cycles = 0U;
+	uint64_t ns;
+	unsigned int idx;
+	struct net_pkt *pkt;
+	uint32_t start;
+	int ret;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_SEGMENTS; i++) {
+		idx = i % count;
+		pkt = peer_segment(idx, ACK, PEER_ISS + 1U,
+				   syn_ack_seq[idx] + 1U);
+
+		start = k_cycle_get_32();
+		ret = peer_input(pkt);
+		cycles += k_cycle_get_32() - start;
+
+		if (ret < 0) {
+			printk("Input of segment %u failed: %d\n", i, ret);
+			return ret;
+		}
+	}
+
+	ns = MAX(k_cyc_to_ns_floor64(cycles), 1U);
+
+	printk("%4u connections: %7u cycles (%7u nsec) per segment, %8llu segments/s\n",
+	       count, (uint32_t)(cycles / CONFIG_BENCHMARK_NUM_SEGMENTS),
+	       (uint32_t)(ns / CONFIG_BENCHMARK_NUM_SEGMENTS),
+	       (uint64_t)CONFIG_BENCHMARK_NUM_SEGMENTS * NSEC_PER_SEC / ns);
+
+	return 0;
+}
+
+int main(void)
+{
+	unsigned int established = 0U;
+	int ret;
+
+	printk("TCP connection lookup benchmark: %u lookup buckets\n",
+	       (unsigned int)BIT(CONFIG_NET_TCP_CONN_HASH_BITS));
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (iface == NULL ||
+	    net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot set up the network interface\n");
+		goto fail;
+	}
+
+	ret = listen_setup();
+	if (ret < 0) {
+		printk("Cannot listen: %d\n", ret);
+		goto fail;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(num_conns); i++) {
+		if (num_conns[i] <= established ||
+		    num_conns[i] > CONFIG_BENCHMARK_NUM_CONNS) {
+			continue;
+		}
+
+		for (; established < num_conns[i]; established++) {
+			ret = peer_connect(established);
+			if (ret < 0) {
+				printk("Connection %u failed: %d\n", established,
+				       ret);
+				goto fail;
+			}
+		}
+
+		if (atomic_get(&accepted) != established) {
+			printk("Only %ld of %u connections accepted\n",
+			       (long)atomic_get(&accepted), established);
+			goto fail;
+		}
+
+		if (measure(established) < 0) {
+			goto fail;
+		}
+	}
+
+	if (atomic_get(&resets) != 0) {
+		printk("%ld connections reset\n", (long)atomic_get(&resets));
+		goto fail;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+
+fail:
+	TC_END_REPORT(TC_FAIL);
+
+	return 0;
+}
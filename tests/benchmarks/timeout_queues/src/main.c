@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that will measure the length of time required
+ * to add timeouts to, and abort them from, the kernel timeout queue while it
+ * holds a varying number of pending timeouts. The expiries are spread
+ * pseudo-randomly over a range far larger than the duration of the test (the
+ * system clock runs at 1 tick per second) so that none of them fire.
+ *
+ * It also measures kicking pending timeouts, watchdog style, by pushing each
+ * of them out by a fixed period, both with an abort followed by an add and
+ * with an in-place update.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+#define MIN_EXPIRY 1000U
+#define MAX_EXPIRY 1000000U
+#define KICK_PERIOD (2U * MAX_EXPIRY)
+
+static struct _timeout timeouts[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+static const unsigned int num_timeouts[] = {
+	10, 100, CONFIG_BENCHMARK_NUM_TIMEOUTS
+};
+
+struct stats {
+	uint64_t minimum;
+	uint64_t maximum;
+	uint64_t total;
+	uint64_t count;
+};
+
+static struct stats add_stats;
+static struct stats abort_stats;
+static struct stats next_stats;
+static struct stats kick_stats;
+static struct stats update_stats;
+
+static uint32_t lcg_state = 1U;
+
+static uint32_t next_expiry(void)
+{
+	lcg_state = lcg_state * 1103515245U + 12345U;
+
+	return MIN_EXPIRY + (lcg_state >> 8) % (MAX_EXPIRY - MIN_EXPIRY);
+}
+
+static void timeout_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	printk("Unexpected timeout expiry\n");
+}
+
+static void stats_reset(struct stats *s)
+{
+	s->minimum = UINT64_MAX;
+	s->maximum = 0ULL;
+	s->total = 0ULL;
+	s->count = 0ULL;
+}
+
+static void stats_add(struct stats *s, timing_t *start, timing_t *finish)
+{
+	uint64_t cycles = timing_cycles_get(start, finish);
+
+	s->minimum = MIN(s->minimum, cycles);
+	s->maximum = MAX(s->maximum, cycles);
+	s->total += cycles;
+	s->count++;
+}
+
+static void stats_report(const struct stats *s, const char *str)
+{
+	uint64_t average = s->total / s->count;
+
+	printk("%s\n", str);
+	printk("    Minimum : %7llu cycles (%7u nsec)\n",
+	       s->minimum, (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n",
+	       s->maximum, (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n",
+	       average, (uint32_t)timing_cycles_to_ns(average));
+}
+
+/**
+ * Fill the timeout queue with @a count timeouts, sample the next expiry
+ * lookup at the peak and then abort them all, in a different order than
+ * they were added in.
+ */
+static void test_add_abort(unsigned int count)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < count; i++) {
+		z_init_timeout(&timeouts[i]);
+
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], timeout_handler,
+			      K_TICKS(next_expiry()));
+		finish = timing_counter_get();
+
+		stats_add(&add_stats, &start, &finish);
+	}
+
+	start = timing_counter_get();
+	(void)z_get_next_timeout_expiry();
+	finish = timing_counter_get();
+
+	stats_add(&next_stats, &start, &finish);
+
+	/* Abort the odd entries first, then the even ones */
+
+	for (i = 1; i < count; i += 2) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[i]);
+		finish = timing_counter_get();
+
+		stats_add(&abort_stats, &start, &finish);
+	}
+
+	for (i = 0; i < count; i += 2) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[i]);
+		finish = timing_counter_get();
+
+		stats_add(&abort_stats, &start, &finish);
+	}
+}
+
+/**
+ * Fill the timeout queue with @a count timeouts and kick each of them a few
+ * times, first by aborting and re-adding it and then by updating it in place.
+ */
+static void test_kick(unsigned int count)
+{
+	unsigned int i;
+	unsigned int j;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < count; i++) {
+		z_init_timeout(&timeouts[i]);
+		z_add_timeout(&timeouts[i], timeout_handler,
+			      K_TICKS(next_expiry()));
+	}
+
+	for (j = 0; j < 4; j++) {
+		for (i = 0; i < count; i++) {
+			start = timing_counter_get();
+			z_abort_timeout(&timeouts[i]);
+			z_add_timeout(&timeouts[i], timeout_handler,
+				      K_TICKS((j + 1U) * KICK_PERIOD + i));
+			finish = timing_counter_get();
+
+			stats_add(&kick_stats, &start, &finish);
+		}
+
+		for (i = 0; i < count; i++) {
+			start = timing_counter_get();
+			(void)z_update_timeout(&timeouts[i], timeout_handler,
+					       K_TICKS((j + 1U) * KICK_PERIOD + i));
+			finish = timing_counter_get();
+
+			stats_add(&update_stats, &start, &finish);
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+}
+
+int main(void)
+{
+	unsigned int i;
+	unsigned int j;
+	char str[80];
+
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dlist");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (i = 0; i < ARRAY_SIZE(num_timeouts); i++) {
+		stats_reset(&add_stats);
+		stats_reset(&abort_stats);
+		stats_reset(&next_stats);
+		stats_reset(&kick_stats);
+		stats_reset(&update_stats);
+
+		for (j = 0; j < CONFIG_BENCHMARK_NUM_ITERATIONS; j++) {
+			test_add_abort(num_timeouts[i]);
+			test_kick(num_timeouts[i]);
+		}
+
+		snprintk(str, sizeof(str), "Add timeout (%u pending)",
+			 num_timeouts[i]);
+		stats_report(&add_stats, str);
+
+		snprintk(str, sizeof(str), "Abort timeout (%u pending)",
+			 num_timeouts[i]);
+		stats_report(&abort_stats, str);
+
+		snprintk(str, sizeof(str), "Next expiry (%u pending)",
+			 num_timeouts[i]);
+		stats_report(&next_stats, str);
+
+		snprintk(str, sizeof(str), "Kick timeout, abort + add (%u pending)",
+			 num_timeouts[i]);
+		stats_report(&kick_stats, str);
+
+		snprintk(str, sizeof(str), "Kick timeout, update (%u pending)",
+			 num_timeouts[i]);
+		stats_report(&update_stats, str);
+
+		printk("------------------------------------\n");
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
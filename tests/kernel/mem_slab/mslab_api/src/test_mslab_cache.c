@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include "test_mslab.h"
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+
+#define CACHE_BLK_NUM (2 * CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE)
+
+K_MEM_SLAB_DEFINE_STATIC(cache_mslab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+
+static void check_used(struct k_mem_slab *slab, uint32_t used)
+{
+	struct sys_memory_stats stats;
+
+	zassert_equal(k_mem_slab_num_used_get(slab), used);
+	zassert_equal(k_mem_slab_num_free_get(slab), CACHE_BLK_NUM - used);
+
+	zassert_ok(k_mem_slab_runtime_stats_get(slab, &stats));
+	zassert_equal(stats.allocated_bytes, used * BLK_SIZE);
+	zassert_equal(stats.free_bytes, (CACHE_BLK_NUM - used) * BLK_SIZE);
+
+#ifdef CONFIG_OBJ_CORE_STATS_MEM_SLAB
+	struct k_mem_slab_info info;
+
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(slab), &info, sizeof(info)));
+	zassert_equal(info.num_used, used);
+#endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+}
+
+/**
+ * @addtogroup kernel_memory_slab_tests
+ * @{
+ */
+
+/**
+ * @brief Verify block accounting with per-CPU slab caches
+ *
+ * @details Allocate and free all blocks of a slab a few times, so
+ * blocks move back and forth between the CPU cache and the slab's free
+ * list in batches. Blocks held in the cache must be reported as free,
+ * and all of them must be allocatable until the slab runs dry.
+ *
+ * @see k_mem_slab_alloc(), k_mem_slab_free(),
+ * k_mem_slab_runtime_stats_get()
+ */
+ZTEST(mslab_api, test_mslab_cache)
+{
+	void *block[CACHE_BLK_NUM], *block_fail;
+
+	for (int lap = 0; lap < 3; lap++) {
+		for (int i = 0; i < CACHE_BLK_NUM; i++) {
+			zassert_ok(k_mem_slab_alloc(&cache_mslab, &block[i],
+						    K_NO_WAIT));
+			check_used(&cache_mslab, i + 1);
+		}
+
+		zassert_equal(k_mem_slab_alloc(&cache_mslab, &block_fail,
+					       K_NO_WAIT), -ENOMEM);
+		zassert_equal(k_mem_slab_alloc(&cache_mslab, &block_fail,
+					       K_MSEC(10)), -EAGAIN);
+
+		for (int i = 0; i < CACHE_BLK_NUM; i++) {
+			k_mem_slab_free(&cache_mslab, block[i]);
+			check_used(&cache_mslab, CACHE_BLK_NUM - 1 - i);
+		}
+
+		zassert_ok(k_mem_slab_alloc(&cache_mslab, &block[0], K_NO_WAIT));
+		check_used(&cache_mslab, 1);
+		k_mem_slab_free(&cache_mslab, block[0]);
+		check_used(&cache_mslab, 0);
+	}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	zassert_equal(k_mem_slab_max_used_get(&cache_mslab), CACHE_BLK_NUM);
+	zassert_ok(k_mem_slab_runtime_stats_reset_max(&cache_mslab));
+	zassert_equal(k_mem_slab_max_used_get(&cache_mslab), 0);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+/**
+ * @}
+ */
+
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_LOCKLESS
+
+#define LOCKLESS_LEN 4
+#define STRESS_MSGS 1000
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+K_THREAD_STACK_DECLARE(tstack1, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_thread tdata1;
+
+K_MSGQ_DEFINE_LOCKLESS(lockless_msgq, MSG_SIZE, LOCKLESS_LEN);
+
+static char __aligned(sizeof(atomic_t))
+	lbuffer[K_MSGQ_LOCKLESS_BUF_SIZE(MSG_SIZE, LOCKLESS_LEN)];
+static struct k_msgq stack_msgq;
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = POINTER_TO_UINT(p2);
+	int expected = POINTER_TO_INT(p3);
+
+	zassert_equal(k_msgq_put(p1, &msg, TIMEOUT), expected);
+}
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg;
+
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_msgq_get(p1, &msg, TIMEOUT), 0);
+	zassert_equal(msg, POINTER_TO_UINT(p2));
+}
+
+static void stress_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < STRESS_MSGS; i++) {
+		zassert_equal(k_msgq_put(p1, &i, K_FOREVER), 0);
+	}
+}
+
+static void isr_put(const void *param)
+{
+	uint32_t msg = MSG1;
+
+	zassert_equal(k_msgq_put((struct k_msgq *)param, &msg, K_NO_WAIT), 0);
+}
+
+static void fill(struct k_msgq *q)
+{
+	for (uint32_t i = 0; i < LOCKLESS_LEN; i++) {
+		zassert_equal(k_msgq_put(q, &i, K_NO_WAIT), 0);
+	}
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test lock-free message queue initialization
+ * @see k_msgq_init_lockless()
+ */
+ZTEST(msgq_api, test_msgq_lockless_init)
+{
+	zassert_equal(k_msgq_init_lockless(&stack_msgq, lbuffer, MSG_SIZE, 3),
+		      -EINVAL);
+	zassert_equal(k_msgq_init_lockless(&stack_msgq, lbuffer + 1, MSG_SIZE,
+					   2), -EINVAL);
+	zassert_equal(k_msgq_init_lockless(&stack_msgq, lbuffer, MSG_SIZE,
+					   LOCKLESS_LEN), 0);
+	zassert_equal(k_msgq_num_free_get(&stack_msgq), LOCKLESS_LEN);
+}
+
+/**
+ * @brief Test lock-free message queue put, get and peek without blocking
+ * @see k_msgq_put(), k_msgq_get(), k_msgq_peek_at(), k_msgq_get_attrs()
+ */
+ZTEST(msgq_api, test_msgq_lockless_put_get)
+{
+	struct k_msgq_attrs attrs;
+	uint32_t msg = MSG0;
+
+	zassert_equal(k_msgq_init_lockless(&stack_msgq, lbuffer, MSG_SIZE,
+					   LOCKLESS_LEN), 0);
+
+	/* go around the ring a few times */
+	for (int lap = 0; lap < 3; lap++) {
+		fill(&stack_msgq);
+
+		zassert_equal(k_msgq_put(&stack_msgq, &msg, K_NO_WAIT), -ENOMSG);
+		zassert_equal(k_msgq_num_used_get(&stack_msgq), LOCKLESS_LEN);
+		k_msgq_get_attrs(&stack_msgq, &attrs);
+		zassert_equal(attrs.used_msgs, LOCKLESS_LEN);
+
+		zassert_equal(k_msgq_peek_at(&stack_msgq, &msg, 2), 0);
+		zassert_equal(msg, 2);
+		zassert_equal(k_msgq_peek_at(&stack_msgq, &msg, LOCKLESS_LEN),
+			      -ENOMSG);
+
+		for (uint32_t i = 0; i < LOCKLESS_LEN; i++) {
+			zassert_equal(k_msgq_peek(&stack_msgq, &msg), 0);
+			zassert_equal(msg, i);
+			zassert_equal(k_msgq_get(&stack_msgq, &msg, K_NO_WAIT), 0);
+			zassert_equal(msg, i);
+		}
+
+		zassert_equal(k_msgq_get(&stack_msgq, &msg, K_NO_WAIT), -ENOMSG);
+		zassert_equal(k_msgq_peek(&stack_msgq, &msg), -ENOMSG);
+		zassert_equal(k_msgq_num_free_get(&stack_msgq), LOCKLESS_LEN);
+	}
+}
+
+/**
+ * @brief Test putting to a lock-free message queue from an ISR
+ * @see k_msgq_put()
+ */
+ZTEST(msgq_api, test_msgq_lockless_isr)
+{
+	uint32_t msg;
+
+	irq_offload(isr_put, &lockless_msgq);
+
+	zassert_equal(k_msgq_get(&lockless_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(msg, MSG1);
+}
+
+/**
+ * @brief Test a blocked get woken up by a lock-free put
+ * @see k_msgq_get(), k_msgq_put()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockless_pend_get)
+{
+	uint32_t msg = MSG0;
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_entry, &lockless_msgq,
+			UINT_TO_POINTER(MSG0), NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_put(&lockless_msgq, &msg, K_NO_WAIT), 0);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&lockless_msgq), 0);
+}
+
+/**
+ * @brief Test blocked gets woken up one at a time by lock-free puts
+ *
+ * @details Two threads block getting from an empty queue. Each put wakes
+ * up a single one of them, the second put waking the thread left blocked
+ * even though the first one did not run yet.
+ *
+ * @see k_msgq_get(), k_msgq_put()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockless_pend_get_many)
+{
+	uint32_t msg = MSG0;
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_entry, &lockless_msgq,
+			UINT_TO_POINTER(MSG0), NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_thread_create(&tdata1, tstack1, STACK_SIZE, get_entry, &lockless_msgq,
+			UINT_TO_POINTER(MSG0), NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/* The cooperative test thread puts both before the getters run */
+	zassert_equal(k_msgq_put(&lockless_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_put(&lockless_msgq, &msg, K_NO_WAIT), 0);
+
+	k_thread_join(&tdata, K_FOREVER);
+	k_thread_join(&tdata1, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&lockless_msgq), 0);
+}
+
+/**
+ * @brief Test a blocked put woken up by a lock-free get
+ * @see k_msgq_get(), k_msgq_put()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockless_pend_put)
+{
+	uint32_t msg;
+
+	fill(&lockless_msgq);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_entry, &lockless_msgq,
+			UINT_TO_POINTER(MSG1), INT_TO_POINTER(0),
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	for (uint32_t i = 0; i < LOCKLESS_LEN; i++) {
+		zassert_equal(k_msgq_get(&lockless_msgq, &msg, K_NO_WAIT), 0);
+		zassert_equal(msg, i);
+	}
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_get(&lockless_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(msg, MSG1);
+}
+
+/**
+ * @brief Test purging a lock-free message queue with a blocked put
+ * @see k_msgq_purge(), k_msgq_put()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockless_purge)
+{
+	uint32_t msg;
+
+	fill(&lockless_msgq);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_entry, &lockless_msgq,
+			UINT_TO_POINTER(MSG1), INT_TO_POINTER(-ENOMSG),
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	k_msgq_purge(&lockless_msgq);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_get(&lockless_msgq, &msg, K_NO_WAIT), -ENOMSG);
+	fill(&lockless_msgq);
+	k_msgq_purge(&lockless_msgq);
+}
+
+/**
+ * @brief Test a lock-free message queue with a producer outrunning it
+ * @see k_msgq_get(), k_msgq_put()
+ */
+ZTEST(msgq_api, test_msgq_lockless_stress)
+{
+	uint32_t msg;
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, stress_entry,
+			&lockless_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+
+	for (uint32_t i = 0; i < STRESS_MSGS; i++) {
+		zassert_equal(k_msgq_get(&lockless_msgq, &msg, K_FOREVER), 0);
+		zassert_equal(msg, i);
+	}
+	k_thread_join(&tdata, K_FOREVER);
+}
+
+/**
+ * @}
+ */
+
+#endif /* CONFIG_MSGQ_LOCKLESS */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe claim / finish and I/O vector APIs
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#define PIPE_SIZE 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static unsigned char claim_buf[PIPE_SIZE];
+static struct k_pipe claim_pipe;
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static const unsigned char pattern[] = "0123456789abcdef";
+
+static void claim_pipe_reset(void)
+{
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	unsigned char buf[PIPE_SIZE / 2];
+	size_t bytes_read;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_get(p1, buf, sizeof(buf), &bytes_read,
+				 sizeof(buf), K_FOREVER), 0);
+	zassert_mem_equal(buf, pattern, sizeof(buf));
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	size_t bytes_written;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_put(p1, pattern, PIPE_SIZE / 2, &bytes_written,
+				 PIPE_SIZE / 2, K_FOREVER), 0);
+}
+
+/**
+ * @brief Test writing and reading a pipe buffer in place
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+ZTEST(pipe_api, test_pipe_claim_finish)
+{
+	unsigned char *data;
+	unsigned char *other;
+	size_t claimed;
+	size_t len;
+
+	claim_pipe_reset();
+
+	/* Claims stop at the end of the buffer, go around it a few times */
+	for (int i = 0; i < 6; i++) {
+		claimed = k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE);
+		zassert_equal(claimed, PIPE_SIZE - claim_pipe.write_index);
+		zassert_equal(k_pipe_put_claim(&claim_pipe, &other, 1), 0,
+			      "second put claim should fail");
+
+		len = MIN(claimed, 3);
+		memcpy(data, pattern, len);
+		zassert_ok(k_pipe_put_finish(&claim_pipe, len));
+		zassert_equal(k_pipe_read_avail(&claim_pipe), len);
+
+		claimed = k_pipe_get_claim(&claim_pipe, &data, PIPE_SIZE);
+		zassert_equal(claimed, len);
+		zassert_equal(k_pipe_get_claim(&claim_pipe, &other, 1), 0,
+			      "second get claim should fail");
+		zassert_mem_equal(data, pattern, claimed);
+		zassert_ok(k_pipe_get_finish(&claim_pipe, claimed));
+	}
+
+	claimed = k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE);
+	zassert_equal(claimed, PIPE_SIZE - claim_pipe.write_index);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, claimed + 1), -EINVAL);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 0));
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 1), 0);
+}
+
+/**
+ * @brief Test writers and readers blocked by claims
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_waiters)
+{
+	unsigned char buf[PIPE_SIZE];
+	unsigned char *data;
+	size_t bytes_read;
+	size_t claimed;
+
+	claim_pipe_reset();
+
+	/* A reader waiting on an empty pipe is served on put finish */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, reader_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(10);
+
+	claimed = k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE);
+	zassert_equal(claimed, PIPE_SIZE);
+	memcpy(data, pattern, claimed);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, claimed));
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	zassert_equal(k_pipe_read_avail(&claim_pipe), PIPE_SIZE / 2);
+
+	/* A writer blocked on a full pipe refills it on get finish */
+	claimed = k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE);
+	zassert_equal(claimed, PIPE_SIZE / 2);
+	memcpy(data, &pattern[PIPE_SIZE], claimed);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, claimed));
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, writer_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(10);
+
+	claimed = k_pipe_get_claim(&claim_pipe, &data, PIPE_SIZE);
+	zassert_equal(claimed, PIPE_SIZE / 2);
+	zassert_mem_equal(data, &pattern[PIPE_SIZE / 2], claimed);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, claimed));
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	zassert_ok(k_pipe_get(&claim_pipe, buf, sizeof(buf), &bytes_read,
+			      sizeof(buf), K_NO_WAIT));
+	zassert_mem_equal(buf, &pattern[PIPE_SIZE], PIPE_SIZE / 2);
+	zassert_mem_equal(&buf[PIPE_SIZE / 2], pattern, PIPE_SIZE / 2);
+}
+
+/**
+ * @brief Test that waiting threads do not overtake claimed data
+ *
+ * @see k_pipe_get_claim(), k_pipe_get_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_order)
+{
+	unsigned char buf[PIPE_SIZE];
+	unsigned char *data;
+	size_t bytes_written;
+	size_t bytes_read;
+	size_t claimed;
+
+	claim_pipe_reset();
+
+	/* A blocked writer is not read from while buffered data is claimed */
+	zassert_ok(k_pipe_put(&claim_pipe, &pattern[PIPE_SIZE], PIPE_SIZE,
+			      &bytes_written, PIPE_SIZE, K_NO_WAIT));
+
+	claimed = k_pipe_get_claim(&claim_pipe, &data, PIPE_SIZE / 2);
+	zassert_equal(claimed, PIPE_SIZE / 2);
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, writer_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_equal(k_pipe_get(&claim_pipe, buf, sizeof(buf), &bytes_read, 1,
+				 K_NO_WAIT), -EIO, "claimed data overtaken");
+
+	zassert_mem_equal(data, &pattern[PIPE_SIZE], claimed);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, claimed));
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	zassert_ok(k_pipe_get(&claim_pipe, buf, sizeof(buf), &bytes_read,
+			      sizeof(buf), K_NO_WAIT));
+	zassert_mem_equal(buf, &pattern[PIPE_SIZE + PIPE_SIZE / 2],
+			  PIPE_SIZE / 2);
+	zassert_mem_equal(&buf[PIPE_SIZE / 2], pattern, PIPE_SIZE / 2);
+
+	/* A waiting reader is not written to while buffered data is claimed */
+	zassert_ok(k_pipe_put(&claim_pipe, pattern, PIPE_SIZE / 2,
+			      &bytes_written, PIPE_SIZE / 2, K_NO_WAIT));
+
+	claimed = k_pipe_get_claim(&claim_pipe, &data, PIPE_SIZE);
+	zassert_equal(claimed, PIPE_SIZE / 2);
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, reader_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_ok(k_pipe_put(&claim_pipe, &pattern[PIPE_SIZE / 2],
+			      PIPE_SIZE / 2, &bytes_written, PIPE_SIZE / 2,
+			      K_NO_WAIT));
+
+	/* Releasing the claim unconsumed serves the reader in order */
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 0));
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	zassert_ok(k_pipe_get(&claim_pipe, buf, sizeof(buf), &bytes_read,
+			      PIPE_SIZE / 2, K_NO_WAIT));
+	zassert_equal(bytes_read, PIPE_SIZE / 2);
+	zassert_mem_equal(buf, &pattern[PIPE_SIZE / 2], PIPE_SIZE / 2);
+}
+
+/**
+ * @brief Test writing and reading a pipe with I/O vectors
+ *
+ * @see k_pipe_put_iov(), k_pipe_get_iov()
+ */
+ZTEST(pipe_api, test_pipe_iov)
+{
+	unsigned char buf[PIPE_SIZE + 1];
+	size_t bytes_written;
+	size_t bytes_read;
+	const struct k_pipe_put_iovec put_iov[] = {
+		{ .data = &pattern[0], .len = 3 },
+		{ .data = &pattern[3], .len = 0 },
+		{ .data = &pattern[3], .len = 6 },
+	};
+	const struct k_pipe_iovec get_iov[] = {
+		{ .data = &buf[0], .len = 5 },
+		{ .data = &buf[5], .len = 4 },
+	};
+
+	claim_pipe_reset();
+
+	zassert_equal(k_pipe_put_iov(&claim_pipe, put_iov,
+				     ARRAY_SIZE(put_iov), &bytes_written, 9),
+		      -EIO);
+	zassert_ok(k_pipe_put_iov(&claim_pipe, put_iov, ARRAY_SIZE(put_iov),
+				  &bytes_written, 0));
+	zassert_equal(bytes_written, PIPE_SIZE);
+
+	zassert_equal(k_pipe_get_iov(&claim_pipe, get_iov, ARRAY_SIZE(get_iov),
+				     &bytes_read, 9), -EIO);
+	zassert_ok(k_pipe_get_iov(&claim_pipe, get_iov, ARRAY_SIZE(get_iov),
+				  &bytes_read, 1));
+	zassert_equal(bytes_read, PIPE_SIZE);
+	zassert_mem_equal(buf, pattern, PIPE_SIZE);
+
+	zassert_equal(k_pipe_put_iov(&claim_pipe, put_iov, ARRAY_SIZE(put_iov),
+				     &bytes_written, 10), -EINVAL);
+}
+
+/**
+ * @}
+ */
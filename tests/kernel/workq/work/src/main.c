@@ -1175,6 +1175,55 @@ ZTEST(work_1cpu, test_1cpu_basic_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+/* Single CPU test that delayed work kicked repeatedly before it
+ * expires, watchdog style, only runs once after the last kick.
+ */
+ZTEST(work_1cpu, test_1cpu_kick_reschedule)
+{
+	int rc;
+	uint32_t sched_ms;
+	uint32_t max_ms = k_ticks_to_ms_ceil32(1U
+				+ k_ms_to_ticks_ceil32(DELAY_MS));
+	uint32_t elapsed_ms;
+	struct k_work *wp = &dwork.work; /* whitebox testing */
+
+	/* Reset state and use non-blocking handler */
+	reset_counters();
+	k_work_init_delayable(&dwork, counter_handler);
+
+	rc = k_work_schedule_for_queue(&coophi_queue, &dwork,
+				       K_MSEC(DELAY_MS));
+	zassert_equal(rc, 1);
+
+	/* Kick it several times, each before the previous delay ends. */
+	for (int i = 0; i < 4; i++) {
+		k_sleep(K_MSEC(DELAY_MS / 2));
+		zassert_equal(k_work_busy_get(wp), K_WORK_DELAYED);
+		zassert_equal(coophi_counter(), 0);
+
+		k_sleep(K_TICKS(1));
+		sched_ms = k_uptime_get_32();
+		rc = k_work_reschedule_for_queue(&coophi_queue, &dwork,
+						  K_MSEC(DELAY_MS));
+		zassert_equal(rc, 1);
+	}
+
+	/* Wait for completion */
+	rc = k_sem_take(&sync_sem, K_FOREVER);
+	zassert_equal(rc, 0);
+
+	/* Make sure it ran once and is now idle */
+	zassert_equal(coophi_counter(), 1);
+	zassert_equal(k_work_busy_get(wp), 0);
+
+	/* Check that the delay counts from the last kick. */
+	elapsed_ms = last_handle_ms - sched_ms;
+	zassert_true(elapsed_ms >= DELAY_MS,
+		     "short %u < %u\n", elapsed_ms, DELAY_MS);
+	zassert_true(elapsed_ms <= max_ms,
+		     "long %u > %u\n", elapsed_ms, max_ms);
+}
+
 /* Single CPU test that delayed work can be immediately queued by
  * reschedule API.
  */
@@ -42,9 +42,12 @@
 #define SMALL_HEAP_SZ MIN(BIG_HEAP_SZ, 2048)
 
 /* With enabling SYS_HEAP_RUNTIME_STATS, the size of struct z_heap
- * will increase 16 bytes on 64 bit CPU.
+ * will increase 16 bytes on 64 bit CPU.  The slab caches need another
+ * 120 bytes of heap on top of that.
  */
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && defined(CONFIG_SYS_HEAP_SLAB)
+#define SOLO_FREE_HEADER_HEAP_SZ (200)
+#elif defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
 #define SOLO_FREE_HEADER_HEAP_SZ (80)
 #else
 #define SOLO_FREE_HEADER_HEAP_SZ (64)
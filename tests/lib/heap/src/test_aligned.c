@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/sys_heap.h>
+
+#define ALIGNED_HEAP_SZ 2048
+#define DMA_ALIGN       64
+
+extern void *heapmem[];
+extern void *scratchmem[];
+
+static void *aligned_testalloc(void *arg, size_t bytes)
+{
+	void *ret = sys_heap_aligned_alloc(arg, DMA_ALIGN, bytes);
+
+	if (ret != NULL) {
+		zassert_true(IS_ALIGNED(ret, DMA_ALIGN), "misaligned block");
+		memset(ret, 0xa5, bytes);
+	}
+	zassert_true(sys_heap_validate(arg), "invalid heap");
+	return ret;
+}
+
+static void aligned_testfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+	zassert_true(sys_heap_validate(arg), "invalid heap");
+}
+
+static void fill_pattern(uint8_t *p, size_t bytes)
+{
+	for (size_t i = 0; i < bytes; i++) {
+		p[i] = (uint8_t)(i ^ 0x5a);
+	}
+}
+
+static bool check_pattern(const uint8_t *p, size_t bytes)
+{
+	for (size_t i = 0; i < bytes; i++) {
+		if (p[i] != (uint8_t)(i ^ 0x5a)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Aligned blocks freed and allocated again are placed where they were,
+ * rather than carved out of the remaining free space.
+ */
+ZTEST(lib_heap, test_aligned_reuse)
+{
+	struct sys_heap heap;
+	void *p1, *p2, *p3;
+
+	sys_heap_init(&heap, heapmem, ALIGNED_HEAP_SZ);
+
+	p1 = sys_heap_aligned_alloc(&heap, DMA_ALIGN, DMA_ALIGN);
+	p2 = sys_heap_aligned_alloc(&heap, DMA_ALIGN, DMA_ALIGN);
+	zassert_not_null(p1);
+	zassert_not_null(p2);
+	zassert_true(IS_ALIGNED(p1, DMA_ALIGN) && IS_ALIGNED(p2, DMA_ALIGN));
+
+	for (int i = 0; i < 4; i++) {
+		sys_heap_free(&heap, p1);
+		zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+		p3 = sys_heap_aligned_alloc(&heap, DMA_ALIGN, DMA_ALIGN);
+		zassert_equal(p3, p1, "freed block was not reused");
+		zassert_true(sys_heap_validate(&heap), "invalid heap");
+	}
+
+	sys_heap_free(&heap, p1);
+	sys_heap_free(&heap, p2);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+}
+
+/* Reallocations that need a different alignment, or more room than the
+ * right neighbor provides, move within the free neighbors when they fit
+ * there.
+ */
+ZTEST(lib_heap, test_aligned_realloc)
+{
+	struct sys_heap heap;
+	uint8_t *p1, *p2, *p3, *guard;
+
+	sys_heap_init(&heap, heapmem, ALIGNED_HEAP_SZ);
+
+	/* Realign into the free space on the right.  Blocks are carved
+	 * out of an empty heap from low to high addresses, so keep
+	 * allocating until one isn't aligned already.
+	 */
+	do {
+		p1 = sys_heap_alloc(&heap, 40);
+		zassert_not_null(p1);
+	} while (IS_ALIGNED(p1, DMA_ALIGN));
+	fill_pattern(p1, 40);
+
+	p2 = sys_heap_aligned_realloc(&heap, p1, DMA_ALIGN, 40);
+	zassert_not_null(p2);
+	zassert_true(IS_ALIGNED(p2, DMA_ALIGN));
+	zassert_true(p2 > p1 && p2 < p1 + DMA_ALIGN, "block was not realigned in place");
+	zassert_true(check_pattern(p2, 40), "data changed");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	/* Grow into the free space on the left */
+	p1 = sys_heap_aligned_alloc(&heap, DMA_ALIGN, 4 * DMA_ALIGN);
+	p3 = sys_heap_aligned_alloc(&heap, DMA_ALIGN, DMA_ALIGN);
+	guard = sys_heap_aligned_alloc(&heap, DMA_ALIGN, 8);
+	zassert_not_null(p1);
+	zassert_not_null(p3);
+	zassert_not_null(guard);
+	fill_pattern(p3, DMA_ALIGN);
+	sys_heap_free(&heap, p1);
+
+	p2 = sys_heap_aligned_realloc(&heap, p3, DMA_ALIGN, 3 * DMA_ALIGN);
+	zassert_not_null(p2);
+	zassert_true(IS_ALIGNED(p2, DMA_ALIGN));
+	zassert_true(p2 < p3, "block did not grow to the left");
+	zassert_true(check_pattern(p2, DMA_ALIGN), "data changed");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	sys_heap_free(&heap, p2);
+	sys_heap_free(&heap, guard);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+}
+
+ZTEST(lib_heap, test_aligned_stress)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	uint32_t failed;
+
+	sys_heap_init(&heap, heapmem, ALIGNED_HEAP_SZ);
+	sys_heap_stress(aligned_testalloc, aligned_testfree, &heap,
+			ALIGNED_HEAP_SZ, 2 * ALIGNED_HEAP_SZ,
+			scratchmem, ALIGNED_HEAP_SZ / 2,
+			100, &result);
+
+	failed = result.total_allocs - result.successful_allocs;
+	TC_PRINT("aligned allocs: %u/%u, avg free bytes on failure: %u\n",
+		 result.successful_allocs, result.total_allocs,
+		 (failed == 0U) ? 0U :
+		 (uint32_t)(result.accumulated_failed_free_bytes / failed));
+
+	zassert_true(result.successful_allocs > 0);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/sys_heap.h>
+
+#ifdef CONFIG_SYS_HEAP_SLAB
+
+#define SLAB_HEAP_SZ 2048
+#define SLAB_BLOCKS  (SLAB_HEAP_SZ / 8)
+
+extern void *heapmem[];
+extern void *scratchmem[];
+
+static void *slab_testalloc(void *arg, size_t bytes)
+{
+	void *ret = sys_heap_alloc(arg, bytes);
+
+	if (ret != NULL) {
+		memset(ret, 0xa5, bytes);
+	}
+	zassert_true(sys_heap_validate(arg), "invalid heap");
+	return ret;
+}
+
+static void slab_testfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+	zassert_true(sys_heap_validate(arg), "invalid heap");
+}
+
+/* Freed blocks are handed out again by the next allocation of the
+ * same size class, with the request rounded up to the class size.
+ */
+ZTEST(lib_heap, test_slab_reuse)
+{
+	struct sys_heap heap;
+	struct sys_heap_slab_stats stats;
+	void *p1, *p2;
+
+	sys_heap_init(&heap, heapmem, SLAB_HEAP_SZ);
+	sys_heap_slab_enable(&heap);
+
+	p1 = sys_heap_alloc(&heap, CONFIG_SYS_HEAP_SLAB_MIN_SIZE + 1);
+	zassert_not_null(p1);
+	zassert_true(sys_heap_usable_size(&heap, p1) >=
+		     2 * CONFIG_SYS_HEAP_SLAB_MIN_SIZE);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	sys_heap_free(&heap, p1);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	p2 = sys_heap_alloc(&heap, 2 * CONFIG_SYS_HEAP_SLAB_MIN_SIZE);
+	zassert_equal(p1, p2, "freed block was not reused");
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	zassert_ok(sys_heap_slab_stats_get(&heap, 1, &stats));
+	zassert_equal(stats.block_size, 2 * CONFIG_SYS_HEAP_SLAB_MIN_SIZE);
+	zassert_equal(stats.hits, 1);
+	zassert_equal(stats.misses, 1);
+	zassert_equal(stats.cached, CONFIG_SYS_HEAP_SLAB_REFILL - 1);
+	zassert_equal(sys_heap_slab_stats_get(&heap, CONFIG_SYS_HEAP_SLAB_CLASSES,
+					      &stats), -EINVAL);
+#else
+	ARG_UNUSED(stats);
+#endif
+
+	sys_heap_free(&heap, p2);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+}
+
+/* Cached blocks go back to the heap before an allocation fails */
+ZTEST(lib_heap, test_slab_reclaim)
+{
+	struct sys_heap heap;
+	void *blocks[SLAB_BLOCKS];
+	size_t big_sz = SLAB_HEAP_SZ;
+	void *big;
+	int n;
+
+	sys_heap_init(&heap, heapmem, SLAB_HEAP_SZ);
+	sys_heap_slab_enable(&heap);
+
+	/* Find the largest block an empty heap can provide */
+	while ((big = sys_heap_alloc(&heap, big_sz)) == NULL) {
+		big_sz -= 8;
+	}
+	sys_heap_free(&heap, big);
+
+	for (n = 0; n < SLAB_BLOCKS; n++) {
+		blocks[n] = sys_heap_alloc(&heap, CONFIG_SYS_HEAP_SLAB_MIN_SIZE << (n & 1));
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n < SLAB_BLOCKS, "heap was not filled");
+
+	for (int i = 0; i < n; i++) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	big = sys_heap_alloc(&heap, big_sz);
+	zassert_not_null(big, "cached blocks were not reclaimed");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	sys_heap_free(&heap, big);
+}
+
+ZTEST(lib_heap, test_slab_stress)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+
+	sys_heap_init(&heap, heapmem, SLAB_HEAP_SZ);
+	sys_heap_slab_enable(&heap);
+	sys_heap_stress(slab_testalloc, slab_testfree, &heap,
+			SLAB_HEAP_SZ, 2 * SLAB_HEAP_SZ,
+			scratchmem, SLAB_HEAP_SZ / 2,
+			100, &result);
+
+	zassert_true(result.successful_allocs > 0);
+}
+
+#endif /* CONFIG_SYS_HEAP_SLAB */
@@ -1283,4 +1283,65 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+static uint16_t chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint16_t tmp;
+
+	for (size_t i = 0; i < len; i++) {
+		tmp = (i % 2) ? data[i] : data[i] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+#define CHKSUM_TEST_PKT_DATA_SIZE 600
+
+ZTEST(net_pkt_test_suite, test_net_pkt_write_chksum)
+{
+	/* Odd sizes, so that the 16-bit words straddle both the writes
+	 * and the buffers of the packet.
+	 */
+	static const size_t chunks[] = { 1, 7, 130, 13, 256, 193 };
+	static uint8_t data[CHKSUM_TEST_PKT_DATA_SIZE];
+	static uint8_t read_back[CHKSUM_TEST_PKT_DATA_SIZE];
+	struct net_pkt *pkt;
+	uint16_t sum = 0U;
+	size_t offset = 0;
+	int ret;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = sys_rand8_get();
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, sizeof(data), AF_UNSPEC, 0,
+					K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+	zassert_true(pkt->buffer->frags != NULL, "Only one buffer?");
+
+	for (size_t i = 0; i < ARRAY_SIZE(chunks); i++) {
+		ret = net_pkt_write_chksum(pkt, data + offset, chunks[i],
+					   offset, &sum);
+		zassert_equal(ret, 0, "Pkt write failed");
+		offset += chunks[i];
+	}
+
+	zassert_equal(offset, sizeof(data), "Wrong chunk sizes");
+	zassert_equal(sum, chksum_ref(0U, data, sizeof(data)),
+		      "Wrong sum of the written data");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_read(pkt, read_back, sizeof(data));
+	zassert_equal(ret, 0, "Pkt read failed");
+
+	zassert_mem_equal(read_back, data, sizeof(data), "Data differ");
+
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define CLIENT_PORT 9898
+#define SERVER_PORT 4242
+
+#define EPOLL_DATA 0x1234
+
+/* On QEMU, waits take +10ms from the requested time. */
+#define FUZZ 10
+
+static int c_sock;
+static int s_sock;
+static int epfd;
+
+static void send_small(void)
+{
+	ssize_t len;
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(void)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+static void add_server(uint32_t events)
+{
+	struct zsock_epoll_event ev = {
+		.events = events,
+		.data.u32 = EPOLL_DATA,
+	};
+	int res;
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+}
+
+static int wait_server(int timeout)
+{
+	struct zsock_epoll_event ev[2];
+	int res;
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), timeout);
+	zassert_true(res >= 0, "epoll_wait failed (%d)", errno);
+
+	if (res > 0) {
+		zassert_equal(res, 1, "");
+		zassert_equal(ev[0].events, ZSOCK_EPOLLIN, "");
+		zassert_equal(ev[0].data.u32, EPOLL_DATA, "");
+	}
+
+	return res;
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_equal(zsock_close(epfd), 0, "close failed");
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_equal(zsock_close(c_sock), 0, "close failed");
+	zassert_equal(zsock_close(s_sock), 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_level_triggered)
+{
+	uint32_t tstamp;
+
+	add_server(ZSOCK_EPOLLIN);
+
+	/* Wait non-ready socket with timeout of 0 */
+	tstamp = k_uptime_get_32();
+	zassert_equal(wait_server(0), 0, "");
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+
+	/* Wait non-ready socket with timeout of 30 */
+	tstamp = k_uptime_get_32();
+	zassert_equal(wait_server(30), 0, "");
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+
+	send_small();
+
+	tstamp = k_uptime_get_32();
+	zassert_equal(wait_server(30), 1, "");
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+
+	/* Still reported until the data is read */
+	zassert_equal(wait_server(0), 1, "");
+
+	recv_small();
+
+	zassert_equal(wait_server(0), 0, "");
+}
+
+ZTEST(net_socket_epoll, test_edge_triggered)
+{
+	add_server(ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	send_small();
+
+	zassert_equal(wait_server(30), 1, "");
+
+	/* Not reported again without new data */
+	zassert_equal(wait_server(0), 0, "");
+
+	send_small();
+
+	zassert_equal(wait_server(30), 1, "");
+
+	recv_small();
+	recv_small();
+
+	zassert_equal(wait_server(0), 0, "");
+}
+
+ZTEST(net_socket_epoll, test_oneshot)
+{
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT,
+		.data.u32 = EPOLL_DATA,
+	};
+	int res;
+
+	add_server(ev.events);
+
+	send_small();
+
+	zassert_equal(wait_server(30), 1, "");
+
+	send_small();
+
+	/* Disabled until re-armed */
+	zassert_equal(wait_server(0), 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	zassert_equal(wait_server(0), 1, "");
+
+	recv_small();
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_poll_epoll_fd)
+{
+	struct zsock_pollfd pollfd = {
+		.fd = epfd,
+		.events = ZSOCK_POLLIN,
+	};
+	int res;
+
+	add_server(ZSOCK_EPOLLIN);
+	zassert_equal(wait_server(0), 0, "");
+
+	res = zsock_poll(&pollfd, 1, 0);
+	zassert_equal(res, 0, "");
+
+	send_small();
+
+	res = zsock_poll(&pollfd, 1, 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(pollfd.revents, ZSOCK_POLLIN, "");
+
+	zassert_equal(wait_server(0), 1, "");
+
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_ctl)
+{
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN,
+	};
+	struct sockaddr_in6 addr;
+	int sock;
+	int res;
+
+	add_server(ZSOCK_EPOLLIN);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, c_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	/* Only native sockets are supported */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EPERM, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	/* A closed socket leaves the interest set */
+	prepare_sock_udp_v6(MY_IPV6_ADDR, 0, &sock, &addr);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, sock, &ev);
+	zassert_equal(res, 0, "");
+
+	zassert_equal(zsock_close(sock), 0, "close failed");
+	zassert_equal(wait_server(0), 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+}
+
+ZTEST(net_socket_epoll, test_tcp_accept)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN,
+		.data.fd = -1,
+	};
+	int c_sock_tcp;
+	int s_sock_tcp;
+	int new_sock;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock_tcp, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock_tcp, &s_addr);
+
+	res = zsock_bind(s_sock_tcp, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+	res = zsock_listen(s_sock_tcp, 0);
+	zassert_equal(res, 0, "");
+
+	ev.data.fd = s_sock_tcp;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock_tcp, &ev);
+	zassert_equal(res, 0, "");
+
+	res = zsock_connect(c_sock_tcp, (const struct sockaddr *)&s_addr,
+			    sizeof(s_addr));
+	zassert_equal(res, 0, "");
+
+	memset(&ev, 0, sizeof(ev));
+	res = zsock_epoll_wait(epfd, &ev, 1, 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(ev.events, ZSOCK_EPOLLIN, "");
+	zassert_equal(ev.data.fd, s_sock_tcp, "");
+
+	new_sock = zsock_accept(s_sock_tcp, NULL, NULL);
+	zassert_true(new_sock >= 0, "");
+
+	res = zsock_epoll_wait(epfd, &ev, 1, 0);
+	zassert_equal(res, 0, "");
+
+	/* Send space is reported once connected */
+	ev.events = ZSOCK_EPOLLOUT | ZSOCK_EPOLLET;
+	ev.data.fd = c_sock_tcp;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, c_sock_tcp, &ev);
+	zassert_equal(res, 0, "");
+
+	memset(&ev, 0, sizeof(ev));
+	res = zsock_epoll_wait(epfd, &ev, 1, 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(ev.events, ZSOCK_EPOLLOUT, "");
+	zassert_equal(ev.data.fd, c_sock_tcp, "");
+
+	k_msleep(10);
+
+	res = zsock_close(c_sock_tcp);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock_tcp);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, setup, before, after, teardown);
@@ -2531,6 +2531,177 @@ ZTEST(net_socket_udp, test_37_ipv6_src_addr_select)
 				       &my_addr3, &dest);
 }
 
+ZTEST_USER(net_socket_udp, test_38_v4_sendmmsg_recvmmsg)
+{
+	static const char *const data[] = { TEST_STR_SMALL, TEST_STR2, "zephyr" };
+	static ZTEST_BMEM char bufs[ARRAY_SIZE(data) + 1][sizeof(TEST_STR2)];
+	static ZTEST_BMEM struct iovec iov[ARRAY_SIZE(data) + 1];
+	static ZTEST_BMEM struct mmsghdr msgs[ARRAY_SIZE(data) + 1];
+	struct timespec timeout = { .tv_sec = 0, .tv_nsec = NSEC_PER_SEC };
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int ret;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	ret = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			 sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		iov[i].iov_base = (void *)data[i];
+		iov[i].iov_len = strlen(data[i]);
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	ret = zsock_sendmmsg(client_sock, msgs, ARRAY_SIZE(data), 0);
+	zassert_equal(ret, ARRAY_SIZE(data), "sendmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]),
+			      "unexpected sent bytes");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Only the first datagram is waited for, the others being queued */
+	ret = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs),
+			     ZSOCK_MSG_WAITFORONE, NULL);
+	zassert_equal(ret, ARRAY_SIZE(data), "recvmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]),
+			      "unexpected received bytes");
+		zassert_mem_equal(bufs[i], data[i], strlen(data[i]),
+				  "wrong data");
+	}
+
+	ret = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs),
+			     ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(ret, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	ret = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), 0, &timeout);
+	zassert_equal(ret, -1, "recvmmsg should fail");
+	zassert_equal(errno, EINVAL, "unexpected errno (%d)", errno);
+
+	ret = zsock_close(client_sock);
+	zassert_equal(ret, 0, "close failed");
+	ret = zsock_close(server_sock);
+	zassert_equal(ret, 0, "close failed");
+}
+
+ZTEST_USER(net_socket_udp, test_39_v4_zerocopy)
+{
+	static ZTEST_BMEM char data[] = TEST_STR_SMALL;
+	static ZTEST_BMEM char buf[sizeof(TEST_STR_SMALL)];
+	static ZTEST_BMEM union {
+		struct cmsghdr hdr;
+		unsigned char buf[CMSG_SPACE(sizeof(struct sock_extended_err))];
+	} cmsgbuf;
+	struct sock_extended_err *err;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct zsock_pollfd pfd;
+	struct cmsghdr *cmsg;
+	struct iovec iov;
+	struct msghdr msg;
+	int client_sock;
+	int server_sock;
+	int opt = 1;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_ZEROCOPY);
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	ret = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			 sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = zsock_setsockopt(client_sock, SOL_SOCKET, SO_ZEROCOPY, &opt,
+			       sizeof(opt));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", -errno);
+
+	/* Only the sends with the flag are counted */
+	ret = zsock_sendto(client_sock, data, strlen(data), 0,
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, strlen(data), "send failed (%d)", -errno);
+
+	for (int i = 0; i < 2; i++) {
+		ret = zsock_sendto(client_sock, data, strlen(data),
+				   ZSOCK_MSG_ZEROCOPY,
+				   (struct sockaddr *)&server_addr,
+				   sizeof(server_addr));
+		zassert_equal(ret, strlen(data), "send failed (%d)", -errno);
+	}
+
+	/* The data is referenced until the datagrams are read */
+	for (int i = 0; i < 3; i++) {
+		ret = zsock_recv(server_sock, buf, sizeof(buf), 0);
+		zassert_equal(ret, strlen(data), "recv failed (%d)", -errno);
+		zassert_mem_equal(buf, data, strlen(data), "wrong data");
+	}
+
+	pfd.fd = client_sock;
+	pfd.events = ZSOCK_POLLIN;
+	pfd.revents = 0;
+
+	ret = zsock_poll(&pfd, 1, 0);
+	zassert_equal(ret, 1, "poll failed (%d)", -errno);
+	zassert_true(pfd.revents & ZSOCK_POLLERR, "no completion reported");
+
+	memset(&cmsgbuf, 0, sizeof(cmsgbuf));
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = buf;
+	iov.iov_len = sizeof(buf);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	ret = zsock_recvmsg(client_sock, &msg, ZSOCK_MSG_ERRQUEUE);
+	zassert_equal(ret, 0, "recvmsg failed (%d)", -errno);
+	zassert_true(msg.msg_flags & ZSOCK_MSG_ERRQUEUE, "not an error");
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no control message");
+	zassert_equal(cmsg->cmsg_level, IPPROTO_IP, "wrong level");
+	zassert_equal(cmsg->cmsg_type, IP_RECVERR, "wrong type");
+
+	/* Both sends complete in a single range */
+	err = (struct sock_extended_err *)CMSG_DATA(cmsg);
+	zassert_equal(err->ee_origin, SO_EE_ORIGIN_ZEROCOPY, "wrong origin");
+	zassert_equal(err->ee_code, 0, "data was copied");
+	zassert_equal(err->ee_info, 0, "wrong first send");
+	zassert_equal(err->ee_data, 1, "wrong last send");
+
+	ret = zsock_recvmsg(client_sock, &msg, ZSOCK_MSG_ERRQUEUE);
+	zassert_equal(ret, -1, "recvmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	ret = zsock_close(client_sock);
+	zassert_equal(ret, 0, "close failed");
+	ret = zsock_close(server_sock);
+	zassert_equal(ret, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
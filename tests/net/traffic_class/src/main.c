@@ -1053,6 +1053,70 @@ ZTEST(net_traffic_class, test_mix_all_2)
 	test_traffic_class_recv_data_mix_all_2();
 }
 
+#define FLOW_PKT_COUNT 16
+
+static uint8_t flow_next_seq;
+static bool flow_failed;
+
+static void flow_recv_cb(struct net_context *context,
+			 struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 union net_proto_header *proto_hdr,
+			 int status,
+			 void *user_data)
+{
+	uint8_t seq;
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ip_opts_len(pkt) + sizeof(struct net_udp_hdr)) ||
+	    net_pkt_read_u8(pkt, &seq)) {
+		flow_failed = true;
+	} else if (seq != flow_next_seq) {
+		DBG("Received seq %d, expecting %d\n", seq, flow_next_seq);
+		flow_failed = true;
+	}
+
+	flow_next_seq++;
+	k_sem_give(&wait_data);
+
+	net_pkt_unref(pkt);
+}
+
+/* The packets of a flow received through traffic class 0 must be processed
+ * in order, whether or not the class is spread over several queues.
+ */
+ZTEST(net_traffic_class, test_rx_flow_order)
+{
+	struct net_context *ctx = net_ctxs_rx[0].ctx;
+	uint8_t seq;
+	int ret;
+
+	flow_next_seq = 0U;
+	flow_failed = false;
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	ret = net_context_recv(ctx, flow_recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Context recv UDP setup failed (%d)", ret);
+
+	start_receiving = true;
+
+	for (seq = 0U; seq < FLOW_PKT_COUNT; seq++) {
+		ret = net_context_sendto(ctx, &seq, sizeof(seq),
+					 (struct sockaddr *)&dst_addr6,
+					 sizeof(struct sockaddr_in6),
+					 NULL, K_NO_WAIT, NULL);
+		zassert_true(ret > 0, "Send UDP pkt failed");
+	}
+
+	for (seq = 0U; seq < FLOW_PKT_COUNT; seq++) {
+		zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Timeout");
+	}
+
+	zassert_false(flow_failed, "Packets of a flow received out of order");
+}
+
 static void run_before(void *dummy)
 {
 	ARG_UNUSED(dummy);
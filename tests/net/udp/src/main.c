@@ -671,4 +671,69 @@ ZTEST(udp_fn_tests, test_udp)
 	zassert_false(test_failed, "udp tests failed");
 }
 
+#define NUM_PORT_HANDLERS 24
+
+/* Handlers bound to many ports share the buckets of the port lookup
+ * table. Check that packets still reach the handler of their port, or
+ * the handler bound to no port if there is none.
+ */
+ZTEST(udp_fn_tests, test_udp_port_chains)
+{
+	static struct ud uds[NUM_PORT_HANDLERS + 1];
+	struct net_conn_handle *handles[NUM_PORT_HANDLERS + 1];
+	struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+	struct in_addr in4addr_peer = { { { 192, 0, 2, 9 } } };
+	struct ud *wildcard = &uds[NUM_PORT_HANDLERS];
+	struct net_if *iface;
+	int ret;
+	int i;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(net_if_ipv4_addr_add(iface, &in4addr_my,
+					      NET_ADDR_MANUAL, 0));
+
+	k_sem_init(&recv_lock, 0, UINT_MAX);
+
+	for (i = 0; i < NUM_PORT_HANDLERS; i++) {
+		uds[i].local_port = 5000 + i * 7;
+		uds[i].test = "port chain";
+
+		ret = net_udp_register(AF_INET, NULL, NULL, 0,
+				       uds[i].local_port, NULL, test_ok,
+				       &uds[i], &handles[i]);
+		zassert_ok(ret, "UDP register port %u failed (%d)",
+			   uds[i].local_port, ret);
+	}
+
+	wildcard->test = "wildcard";
+	ret = net_udp_register(AF_INET, NULL, NULL, 0, 0, NULL, test_ok,
+			       wildcard, &handles[NUM_PORT_HANDLERS]);
+	zassert_ok(ret, "UDP register wildcard failed (%d)", ret);
+
+	for (i = 0; i < NUM_PORT_HANDLERS; i++) {
+		zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+					       1234, uds[i].local_port, &uds[i],
+					       false));
+	}
+
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       1234, 4999, wildcard, false));
+
+	/* Unregistering a handler leaves the others of its chain in place */
+	zassert_ok(net_udp_unregister(handles[1]));
+
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       1234, uds[1].local_port, wildcard, false));
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       1234, uds[0].local_port, &uds[0], false));
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       1234, uds[2].local_port, &uds[2], false));
+
+	for (i = 0; i <= NUM_PORT_HANDLERS; i++) {
+		if (i != 1) {
+			zassert_ok(net_udp_unregister(handles[i]));
+		}
+	}
+}
+
 ZTEST_SUITE(udp_fn_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/ext2.h>
+#include "utils.h"
+#include "../../common/test_fs_util.h"
+
+#ifdef CONFIG_EXT2_BLOCK_CACHE
+
+#define FILE_BLOCKS 8
+
+static void remount(struct fs_mount_t *mp)
+{
+	int ret;
+
+	ret = fs_unmount(mp);
+	zassert_equal(ret, 0, "Unmount failed (ret=%d)", ret);
+
+	mp->flags = FS_MOUNT_FLAG_NO_FORMAT;
+	ret = fs_mount(mp);
+	zassert_equal(ret, 0, "Mount failed (ret=%d)", ret);
+}
+
+ZTEST(ext2tests, test_block_cache)
+{
+	int64_t ret = 0;
+	struct fs_file_t file;
+	struct fs_dirent entry;
+	struct fs_statvfs sbuf;
+	struct ext2_block_cache_stats stats;
+	struct fs_mount_t *mp = &testfs_mnt;
+	static const char *file_path = "/sml/file";
+	uint32_t misses;
+
+	ret = fs_mkfs(FS_EXT2, (uintptr_t)mp->storage_dev, NULL, 0);
+	zassert_equal(ret, 0, "Failed to mkfs");
+
+	mp->flags = FS_MOUNT_FLAG_NO_FORMAT;
+	ret = fs_mount(mp);
+	zassert_equal(ret, 0, "Mount failed (ret=%d)", ret);
+
+	ret = fs_statvfs(mp->mnt_point, &sbuf);
+	zassert_equal(ret, 0, "Expected success (ret=%d)", ret);
+
+	uint32_t bsize = sbuf.f_bsize;
+	uint32_t bytes_to_write = bsize * FILE_BLOCKS;
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, file_path, FS_O_RDWR | FS_O_CREATE);
+	zassert_equal(ret, 0, "File open failed (ret=%d)", ret);
+
+	ret = testfs_write_incrementing(&file, 0, bytes_to_write);
+	zassert_equal(ret, bytes_to_write, "Different number of bytes written %ld (expected %ld)",
+			ret, bytes_to_write);
+
+	/* Dirty blocks reach the storage with the sync */
+	ret = fs_sync(&file);
+	zassert_equal(ret, 0, "File sync failed (ret=%d)", ret);
+
+	ext2_block_cache_stats_get(&stats);
+	zassert_true(stats.writebacks > 0, "No block written back");
+
+	ret = fs_close(&file);
+	zassert_equal(ret, 0, "File close failed (ret=%d)", ret);
+
+	/* Start with an empty cache */
+	remount(mp);
+
+	/* Repeated lookups are served from the cache */
+	ret = fs_stat(file_path, &entry);
+	zassert_equal(ret, 0, "File stat failed (ret=%d)", ret);
+	ext2_block_cache_stats_get(&stats);
+	misses = stats.misses;
+
+	ret = fs_stat(file_path, &entry);
+	zassert_equal(ret, 0, "File stat failed (ret=%d)", ret);
+	ext2_block_cache_stats_get(&stats);
+	zassert_equal(stats.misses, misses, "Lookup missed the cache");
+	zassert_true(stats.hits > 0, "No cache hit");
+
+	/* Sequential read is served from blocks read ahead */
+	fs_file_t_init(&file);
+	ret = fs_open(&file, file_path, FS_O_READ);
+	zassert_equal(ret, 0, "File open failed (ret=%d)", ret);
+
+	ret = testfs_verify_incrementing(&file, 0, bytes_to_write);
+	zassert_equal(ret, bytes_to_write, "Different number of bytes read %ld (expected %ld)",
+			ret, bytes_to_write);
+
+	ret = fs_close(&file);
+	zassert_equal(ret, 0, "File close failed (ret=%d)", ret);
+
+	ext2_block_cache_stats_get(&stats);
+	if (CONFIG_EXT2_BLOCK_CACHE_READAHEAD > 0) {
+		zassert_true(stats.readahead > 0, "No block read ahead");
+	}
+
+	ret = fs_unmount(mp);
+	zassert_equal(ret, 0, "Unmount failed (ret=%d)", ret);
+}
+
+#endif /* CONFIG_EXT2_BLOCK_CACHE */
@@ -21,6 +21,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/drivers/flash.h>
+#include <zephyr/drivers/flash/flash_simulator.h>
 #include <zephyr/fs/nvs.h>
 #include <zephyr/stats/stats.h>
 #include <zephyr/storage/flash_map.h>
@@ -153,6 +154,17 @@ static int flash_sim_write_calls_find(struct stats_hdr *hdr, void *arg,
 	return 0;
 }
 
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
 static int flash_sim_max_write_calls_find(struct stats_hdr *hdr, void *arg,
 					  const char *name, uint16_t off)
 {
@@ -350,6 +362,15 @@ ZTEST_F(nvs, test_nvs_gc_3sectors)
 	int err;
 
 	const uint16_t max_id = 10;
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+	/* The snapshot of a 64 entries lookup cache takes the room of 7
+	 * writes in the sectors opened by GC.
+	 */
+	const uint16_t max_writes = 51 - 7;
+	const uint16_t max_writes_2 = 51 - 7 + 18;
+	const uint16_t max_writes_3 = 51 - 7 + 18 + 18;
+	const uint16_t max_writes_4 = 51 - 7 + 18 + 18 + 18;
+#else
 	/* 50th write will trigger 1st GC. */
 	const uint16_t max_writes = 51;
 	/* 75th write will trigger 2st GC. */
@@ -358,6 +379,10 @@ ZTEST_F(nvs, test_nvs_gc_3sectors)
 	const uint16_t max_writes_3 = 51 + 25 + 25;
 	/* 125th write will trigger 4st GC. */
 	const uint16_t max_writes_4 = 51 + 25 + 25 + 25;
+#endif
+
+	/* Background GC moves entries before the sectors are full */
+	Z_TEST_SKIP_IFDEF(CONFIG_NVS_GC_BACKGROUND);
 
 	fixture->fs.sector_count = 3;
 
@@ -959,3 +984,267 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 
 #endif
 }
+
+/*
+ * Test that the NVS lookup cache restored from a snapshot at mount matches the
+ * cache built by the writes, and that the mount reads less than when the cache
+ * is rebuilt from all the sectors.
+ */
+ZTEST_F(nvs, test_nvs_cache_snapshot)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE_SNAPSHOT
+	int err;
+	bool found = false;
+	uint16_t data, read_data;
+	uint32_t sector, reads, snapshot_reads;
+	uint32_t *flash_read_stat;
+	size_t snapshot_offset = 0;
+	size_t flash_size;
+	uint8_t *flash_mem;
+	struct nvs_ate ate;
+	static uint32_t cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Close a few sectors, then write some more ids in the active one */
+
+	for (data = 0; (fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 3; data++) {
+		err = nvs_write(&fixture->fs, data % CONFIG_NVS_LOOKUP_CACHE_SIZE,
+				&data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	for (int i = 0; i < 4; i++, data++) {
+		err = nvs_write(&fixture->fs, data % CONFIG_NVS_LOOKUP_CACHE_SIZE,
+				&data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Verify that a snapshot was written in the active sector */
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (uint32_t offset = (fixture->fs.ate_wra & ADDR_OFFS_MASK) + sizeof(ate);
+	     offset < fixture->fs.sector_size; offset += sizeof(ate)) {
+		err = flash_read(flash_dev,
+				 fixture->fs.offset + sector * fixture->fs.sector_size + offset,
+				 &ate, sizeof(ate));
+		zassert_true(err == 0, "flash_read failed: %d", err);
+		if (!found && (ate.id == 0xFFFF) &&
+		    (ate.len == sizeof(cache) + sizeof(uint32_t))) {
+			/* The newest snapshot of the sector is the one restored */
+			snapshot_offset = fixture->fs.offset +
+					  sector * fixture->fs.sector_size + ate.offset;
+			found = true;
+		}
+	}
+	zassert_true(found, "no lookup cache snapshot in the active sector");
+
+	/* Remount and verify that the cache is restored */
+
+	memcpy(cache, fixture->fs.lookup_cache, sizeof(cache));
+	memset(fixture->fs.lookup_cache, 0xAA, sizeof(fixture->fs.lookup_cache));
+
+	stats_walk(fixture->sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+	reads = *flash_read_stat;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	snapshot_reads = *flash_read_stat - reads;
+
+	zassert_mem_equal(cache, fixture->fs.lookup_cache, sizeof(cache),
+			  "lookup cache not restored from the snapshot");
+
+	/* Corrupt the snapshot and remount: the cache must be rebuilt from all
+	 * the sectors.
+	 */
+
+	flash_mem = flash_simulator_get_memory(flash_dev, &flash_size);
+	zassert_true(snapshot_offset < flash_size, "snapshot outside of the flash");
+	flash_mem[snapshot_offset] ^= 0xFF;
+
+	memset(fixture->fs.lookup_cache, 0xAA, sizeof(fixture->fs.lookup_cache));
+	reads = *flash_read_stat;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	TC_PRINT("Mount flash reads: %u from the snapshot, %u with a full scan\n",
+		 snapshot_reads, *flash_read_stat - reads);
+
+	zassert_mem_equal(cache, fixture->fs.lookup_cache, sizeof(cache),
+			  "lookup cache not rebuilt");
+	zassert_true(snapshot_reads < *flash_read_stat - reads,
+		     "mount from the snapshot does not read less than a full scan");
+
+	for (uint16_t i = 1; i <= CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		err = nvs_read(&fixture->fs, (data - i) % CONFIG_NVS_LOOKUP_CACHE_SIZE,
+			       &read_data, sizeof(read_data));
+		zassert_equal(err, sizeof(read_data), "nvs_read call failure: %d", err);
+		zassert_equal(read_data, (uint16_t)(data - i), "incorrect data read");
+	}
+#endif
+}
+
+/*
+ * Test that the background GC moves the valid entries and erases the oldest sector before the
+ * active sector is full, so that the writes switching sectors do not erase and no write waits
+ * for an erase.
+ */
+ZTEST_F(nvs, test_nvs_gc_background)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	ssize_t len;
+	uint32_t data;
+	uint32_t read_data;
+	uint32_t erases;
+	uint32_t sector;
+	uint32_t switches = 0;
+	uint32_t *flash_erase_stat;
+	const uint16_t static_ids = 4;
+	const uint16_t hot_id = static_ids;
+	struct nvs_gc_stats stats;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Entries that are never rewritten have to be moved by each GC */
+	for (data = 0; data < static_ids; data++) {
+		len = nvs_write(&fixture->fs, data, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "nvs_write failed: %d", len);
+	}
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (data = 0; switches < 2 * fixture->fs.sector_count; data++) {
+		erases = *flash_erase_stat;
+		len = nvs_write(&fixture->fs, hot_id, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "nvs_write failed: %d", len);
+		zassert_equal(*flash_erase_stat, erases, "erase in the write path");
+
+		if ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+			switches++;
+		}
+
+		/* Let the background GC complete */
+		while (k_work_busy_get(&fixture->fs.gc_work)) {
+			k_msleep(1);
+		}
+	}
+
+	err = nvs_gc_stats_get(&fixture->fs, &stats);
+	zassert_true(err == 0, "nvs_gc_stats_get call failure: %d", err);
+	zassert_true(stats.bytes_moved > 0, "no entry moved by the GC");
+
+	TC_PRINT("GC moved %u bytes, longest write %u us\n", stats.bytes_moved,
+		 stats.max_stall_us);
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	zassert_true(stats.max_stall_us < CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+		     "a write waited for an erase");
+#endif
+
+	for (int i = 0; i < 2; i++) {
+		for (uint16_t id = 0; id < static_ids; id++) {
+			len = nvs_read(&fixture->fs, id, &read_data, sizeof(read_data));
+			zassert_true(len == sizeof(read_data), "nvs_read failed: %d", len);
+			zassert_equal(read_data, id, "incorrect data read");
+		}
+
+		len = nvs_read(&fixture->fs, hot_id, &read_data, sizeof(read_data));
+		zassert_true(len == sizeof(read_data), "nvs_read failed: %d", len);
+		zassert_equal(read_data, data - 1, "incorrect data read");
+
+		err = nvs_mount(&fixture->fs);
+		zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	}
+#endif
+}
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+#define GC_BG_READER_STACK_SIZE 1024
+
+static K_THREAD_STACK_DEFINE(gc_bg_reader_stack, GC_BG_READER_STACK_SIZE);
+static struct k_thread gc_bg_reader_thread;
+static atomic_t gc_bg_reader_stop;
+static uint32_t gc_bg_reader_reads;
+static uint32_t gc_bg_reader_errors;
+
+static void gc_bg_reader(void *p1, void *p2, void *p3)
+{
+	struct nvs_fs *fs = p1;
+	uint16_t static_ids = POINTER_TO_UINT(p2);
+	uint32_t read_data;
+	ssize_t len;
+
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&gc_bg_reader_stop)) {
+		for (uint16_t id = 0; id < static_ids; id++) {
+			len = nvs_read(fs, id, &read_data, sizeof(read_data));
+			if ((len != sizeof(read_data)) || (read_data != id)) {
+				gc_bg_reader_errors++;
+			}
+			gc_bg_reader_reads++;
+		}
+		k_usleep(50);
+	}
+}
+#endif
+
+/*
+ * Test that the entries read while the background GC moves them are always found with their
+ * last value.
+ */
+ZTEST_F(nvs, test_nvs_gc_background_read)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	ssize_t len;
+	uint32_t data;
+	uint32_t sector;
+	uint32_t switches = 0;
+	const uint16_t static_ids = 4;
+	const uint16_t hot_id = static_ids;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (data = 0; data < static_ids; data++) {
+		len = nvs_write(&fixture->fs, data, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "nvs_write failed: %d", len);
+	}
+
+	atomic_set(&gc_bg_reader_stop, 0);
+	gc_bg_reader_reads = 0;
+	gc_bg_reader_errors = 0;
+	k_thread_create(&gc_bg_reader_thread, gc_bg_reader_stack,
+			K_THREAD_STACK_SIZEOF(gc_bg_reader_stack), gc_bg_reader, &fixture->fs,
+			UINT_TO_POINTER(static_ids), NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (data = 0; switches < 2 * fixture->fs.sector_count; data++) {
+		len = nvs_write(&fixture->fs, hot_id, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "nvs_write failed: %d", len);
+
+		if ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+			switches++;
+		}
+
+		/* Let the reader and the background GC run */
+		k_msleep(1);
+	}
+
+	atomic_set(&gc_bg_reader_stop, 1);
+	err = k_thread_join(&gc_bg_reader_thread, K_FOREVER);
+	zassert_true(err == 0, "k_thread_join failed: %d", err);
+
+	TC_PRINT("%u reads during the background GC\n", gc_bg_reader_reads);
+
+	zassert_true(gc_bg_reader_reads > 0, "no read during the background GC");
+	zassert_equal(gc_bg_reader_errors, 0, "%u reads failed", gc_bg_reader_errors);
+#endif
+}
@@ -20,6 +20,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/drivers/flash.h>
+#include <zephyr/drivers/flash/flash_simulator.h>
 #include <zephyr/fs/zms.h>
 #include <zephyr/stats/stats.h>
 #include <zephyr/storage/flash_map.h>
@@ -148,6 +149,28 @@ static int flash_sim_write_calls_find(struct stats_hdr *hdr, void *arg, const ch
 	return 0;
 }
 
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg, const char *name,
+				     uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **)arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static int flash_sim_erase_calls_find(struct stats_hdr *hdr, void *arg, const char *name,
+				      uint16_t off)
+{
+	if (!strcmp(name, "flash_erase_calls")) {
+		uint32_t **flash_erase_stat = (uint32_t **)arg;
+		*flash_erase_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
 static int flash_sim_max_write_calls_find(struct stats_hdr *hdr, void *arg, const char *name,
 					  uint16_t off)
 {
@@ -322,6 +345,16 @@ ZTEST_F(zms, test_zms_gc_3sectors)
 {
 	int err;
 	const uint16_t max_id = 10;
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+	/* The 512 bytes snapshot of a 64 entries lookup cache takes room in
+	 * the sectors opened by GC, so fewer writes fit in them and more
+	 * entries are copied by each GC.
+	 */
+	const uint16_t max_writes = 30;
+	const uint16_t max_writes_2 = 30 + 8;
+	const uint16_t max_writes_3 = 30 + 8 + 7;
+	const uint16_t max_writes_4 = 30 + 8 + 7 + 6;
+#else
 	/* 41st write will trigger 1st GC. */
 	const uint16_t max_writes = 41;
 	/* 61st write will trigger 2nd GC. */
@@ -330,6 +363,10 @@ ZTEST_F(zms, test_zms_gc_3sectors)
 	const uint16_t max_writes_3 = 41 + 20 + 20;
 	/* 101st write will trigger 4th GC. */
 	const uint16_t max_writes_4 = 41 + 20 + 20 + 20;
+#endif
+
+	/* Background GC moves entries before the sectors are full */
+	Z_TEST_SKIP_IFDEF(CONFIG_ZMS_GC_BACKGROUND);
 
 	fixture->fs.sector_count = 3;
 
@@ -887,3 +924,283 @@ ZTEST_F(zms, test_zms_cache_hash_quality)
 
 #endif
 }
+
+/*
+ * Test that the ZMS lookup cache restored from a snapshot at mount matches the cache
+ * built by the writes, and that the mount reads less than when the cache is rebuilt
+ * from all the sectors.
+ */
+ZTEST_F(zms, test_zms_cache_snapshot)
+{
+#ifdef CONFIG_ZMS_LOOKUP_CACHE_SNAPSHOT
+	int err;
+	bool found = false;
+	uint32_t data;
+	uint32_t read_data;
+	uint32_t start;
+	uint32_t cycles;
+	uint32_t reads;
+	uint32_t snapshot_reads;
+	uint32_t *flash_read_stat;
+	uint64_t sector;
+	size_t snapshot_offset = 0;
+	size_t flash_size;
+	uint8_t *flash_mem;
+	struct zms_ate ate;
+	static uint64_t cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	/* Close a few sectors, then write some more IDs in the active one */
+
+	for (data = 0; (fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 3; data++) {
+		err = zms_write(&fixture->fs, data % CONFIG_ZMS_LOOKUP_CACHE_SIZE, &data,
+				sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	for (int i = 0; i < 4; i++, data++) {
+		err = zms_write(&fixture->fs, data % CONFIG_ZMS_LOOKUP_CACHE_SIZE, &data,
+				sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	/* Verify that a snapshot was written in the active sector */
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (uint32_t offset = SECTOR_OFFSET(fixture->fs.ate_wra) + fixture->fs.ate_size;
+	     offset < fixture->fs.sector_size; offset += fixture->fs.ate_size) {
+		err = flash_read(flash_dev,
+				 fixture->fs.offset + sector * fixture->fs.sector_size + offset,
+				 &ate, sizeof(ate));
+		zassert_true(err == 0, "flash_read failed: %d", err);
+		if (!found && (ate.id == ZMS_HEAD_ID) && (ate.len == sizeof(cache))) {
+			/* The newest snapshot of the sector is the one restored */
+			snapshot_offset = fixture->fs.offset + sector * fixture->fs.sector_size +
+					  ate.offset;
+			found = true;
+		}
+	}
+	zassert_true(found, "no lookup cache snapshot in the active sector");
+
+	/* Remount and verify that the cache is restored */
+
+	memcpy(cache, fixture->fs.lookup_cache, sizeof(cache));
+	memset(fixture->fs.lookup_cache, 0xAA, sizeof(fixture->fs.lookup_cache));
+
+	stats_walk(fixture->sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+	reads = *flash_read_stat;
+
+	start = k_cycle_get_32();
+	err = zms_mount(&fixture->fs);
+	cycles = k_cycle_get_32() - start;
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	snapshot_reads = *flash_read_stat - reads;
+
+	TC_PRINT("Mount from the snapshot: %u cycles, %u flash reads\n", cycles, snapshot_reads);
+
+	zassert_mem_equal(cache, fixture->fs.lookup_cache, sizeof(cache),
+			  "lookup cache not restored from the snapshot");
+
+	/* Corrupt the snapshot and remount: the cache must be rebuilt from all the sectors */
+
+	flash_mem = flash_simulator_get_memory(flash_dev, &flash_size);
+	zassert_true(snapshot_offset < flash_size, "snapshot outside of the flash");
+	flash_mem[snapshot_offset] ^= 0xFF;
+
+	memset(fixture->fs.lookup_cache, 0xAA, sizeof(fixture->fs.lookup_cache));
+	reads = *flash_read_stat;
+
+	start = k_cycle_get_32();
+	err = zms_mount(&fixture->fs);
+	cycles = k_cycle_get_32() - start;
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	TC_PRINT("Mount with a full scan: %u cycles, %u flash reads\n", cycles,
+		 *flash_read_stat - reads);
+
+	zassert_mem_equal(cache, fixture->fs.lookup_cache, sizeof(cache),
+			  "lookup cache not rebuilt");
+	zassert_true(snapshot_reads < *flash_read_stat - reads,
+		     "mount from the snapshot does not read less than a full scan");
+
+	for (uint32_t i = 1; i <= CONFIG_ZMS_LOOKUP_CACHE_SIZE; i++) {
+		err = zms_read(&fixture->fs, (data - i) % CONFIG_ZMS_LOOKUP_CACHE_SIZE, &read_data,
+			       sizeof(read_data));
+		zassert_equal(err, sizeof(read_data), "zms_read call failure: %d", err);
+		zassert_equal(read_data, data - i, "incorrect data read");
+	}
+#endif
+}
+
+/*
+ * Test that the background GC moves the valid entries and erases the oldest sector before the
+ * active sector is full, so that the writes switching sectors do not erase and no write waits
+ * for an erase.
+ */
+ZTEST_F(zms, test_zms_gc_background)
+{
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	int err;
+	ssize_t len;
+	uint32_t data;
+	uint32_t read_data;
+	uint32_t erases;
+	uint32_t sector;
+	uint32_t switches = 0;
+	uint32_t *flash_erase_stat;
+	const uint32_t static_ids = 4;
+	const uint32_t hot_id = static_ids;
+	struct zms_gc_stats stats;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	/* Entries that are never rewritten have to be moved by each GC */
+	for (data = 0; data < static_ids; data++) {
+		len = zms_write(&fixture->fs, data, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "zms_write failed: %d", len);
+	}
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (data = 0; switches < 2 * fixture->fs.sector_count; data++) {
+		erases = *flash_erase_stat;
+		len = zms_write(&fixture->fs, hot_id, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "zms_write failed: %d", len);
+		/* The first switch opens a sector that was never used, it is erased */
+		if (switches > 0) {
+			zassert_equal(*flash_erase_stat, erases, "erase in the write path");
+		}
+
+		if ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+			switches++;
+			if (switches == 1) {
+				/* Reset the statistics, that include the erase above */
+				err = zms_mount(&fixture->fs);
+				zassert_true(err == 0, "zms_mount call failure: %d", err);
+			}
+		}
+
+		/* Let the background GC complete */
+		while (k_work_busy_get(&fixture->fs.gc_work)) {
+			k_msleep(1);
+		}
+	}
+
+	err = zms_gc_stats_get(&fixture->fs, &stats);
+	zassert_true(err == 0, "zms_gc_stats_get call failure: %d", err);
+	zassert_true(stats.bytes_moved > 0, "no entry moved by the GC");
+
+	TC_PRINT("GC moved %u bytes, longest write %u us\n", stats.bytes_moved,
+		 stats.max_stall_us);
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	zassert_true(stats.max_stall_us < CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+		     "a write waited for an erase");
+#endif
+
+	for (int i = 0; i < 2; i++) {
+		for (uint32_t id = 0; id < static_ids; id++) {
+			len = zms_read(&fixture->fs, id, &read_data, sizeof(read_data));
+			zassert_true(len == sizeof(read_data), "zms_read failed: %d", len);
+			zassert_equal(read_data, id, "incorrect data read");
+		}
+
+		len = zms_read(&fixture->fs, hot_id, &read_data, sizeof(read_data));
+		zassert_true(len == sizeof(read_data), "zms_read failed: %d", len);
+		zassert_equal(read_data, data - 1, "incorrect data read");
+
+		err = zms_mount(&fixture->fs);
+		zassert_true(err == 0, "zms_mount call failure: %d", err);
+	}
+#endif
+}
+
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+#define GC_BG_READER_STACK_SIZE 1024
+
+static K_THREAD_STACK_DEFINE(gc_bg_reader_stack, GC_BG_READER_STACK_SIZE);
+static struct k_thread gc_bg_reader_thread;
+static atomic_t gc_bg_reader_stop;
+static uint32_t gc_bg_reader_reads;
+static uint32_t gc_bg_reader_errors;
+
+static void gc_bg_reader(void *p1, void *p2, void *p3)
+{
+	struct zms_fs *fs = p1;
+	uint32_t static_ids = POINTER_TO_UINT(p2);
+	uint32_t read_data;
+	ssize_t len;
+
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&gc_bg_reader_stop)) {
+		for (uint32_t id = 0; id < static_ids; id++) {
+			len = zms_read(fs, id, &read_data, sizeof(read_data));
+			if ((len != sizeof(read_data)) || (read_data != id)) {
+				gc_bg_reader_errors++;
+			}
+			gc_bg_reader_reads++;
+		}
+		k_usleep(50);
+	}
+}
+#endif
+
+/*
+ * Test that the entries read while the background GC moves them are always found with their
+ * last value.
+ */
+ZTEST_F(zms, test_zms_gc_background_read)
+{
+#ifdef CONFIG_ZMS_GC_BACKGROUND
+	int err;
+	ssize_t len;
+	uint32_t data;
+	uint32_t sector;
+	uint32_t switches = 0;
+	const uint32_t static_ids = 4;
+	const uint32_t hot_id = static_ids;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	for (data = 0; data < static_ids; data++) {
+		len = zms_write(&fixture->fs, data, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "zms_write failed: %d", len);
+	}
+
+	atomic_set(&gc_bg_reader_stop, 0);
+	gc_bg_reader_reads = 0;
+	gc_bg_reader_errors = 0;
+	k_thread_create(&gc_bg_reader_thread, gc_bg_reader_stack,
+			K_THREAD_STACK_SIZEOF(gc_bg_reader_stack), gc_bg_reader, &fixture->fs,
+			UINT_TO_POINTER(static_ids), NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (data = 0; switches < 2 * fixture->fs.sector_count; data++) {
+		len = zms_write(&fixture->fs, hot_id, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "zms_write failed: %d", len);
+
+		if ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+			switches++;
+		}
+
+		/* Let the reader and the background GC run */
+		k_msleep(1);
+	}
+
+	atomic_set(&gc_bg_reader_stop, 1);
+	err = k_thread_join(&gc_bg_reader_thread, K_FOREVER);
+	zassert_true(err == 0, "k_thread_join failed: %d", err);
+
+	TC_PRINT("%u reads during the background GC\n", gc_bg_reader_reads);
+
+	zassert_true(gc_bg_reader_reads > 0, "no read during the background GC");
+	zassert_equal(gc_bg_reader_errors, 0, "%u reads failed", gc_bg_reader_errors);
+#endif
+}
@@ -16,7 +16,8 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(settings_basic_test);
 
-#if defined(CONFIG_SETTINGS_FCB) || defined(CONFIG_SETTINGS_NVS)
+#if defined(CONFIG_SETTINGS_FCB) || defined(CONFIG_SETTINGS_NVS) || \
+	defined(CONFIG_SETTINGS_ZMS)
 #include <zephyr/storage/flash_map.h>
 #if DT_HAS_CHOSEN(zephyr_settings_partition)
 #define TEST_FLASH_AREA_ID DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
@@ -228,14 +229,6 @@ static struct settings_handler val3_settings = {
 	.h_commit = val3_commit,
 };
 
-/* helper routine to remove a handler from settings */
-int settings_deregister(struct settings_handler *handler)
-{
-	extern sys_slist_t settings_handlers;
-
-	return sys_slist_find_and_remove(&settings_handlers, &handler->node);
-}
-
 ZTEST(settings_functional, test_register_and_loading)
 {
 	int rc, err;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Atmosic
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <errno.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/fs/zms.h>
+#include <zephyr/sys/crc.h>
+
+#include "settings/settings_zms.h"
+
+#define TEST_NAME "zms/interrupted"
+
+static int loaded;
+
+static int count_cb(const char *key, size_t len, settings_read_cb read_cb,
+		    void *cb_arg, void *param)
+{
+	ARG_UNUSED(len);
+	ARG_UNUSED(read_cb);
+	ARG_UNUSED(cb_arg);
+	ARG_UNUSED(param);
+
+	if (strcmp(key, "interrupted") == 0) {
+		loaded++;
+	}
+
+	return 0;
+}
+
+ZTEST(settings_functional, test_setting_storage_get)
+{
+	int rc;
+	void *storage;
+	uint16_t data = 0x5a5a;
+	ssize_t zms_rc;
+
+	rc = settings_storage_get(&storage);
+	zassert_equal(0, rc, "Can't fetch storage reference (err=%d)", rc);
+
+	zassert_not_null(storage, "Null reference.");
+
+	zms_rc = zms_write((struct zms_fs *)storage, 26, &data, sizeof(data));
+
+	zassert_true(zms_rc >= 0, "Can't write zms record (err=%d).", rc);
+}
+
+ZTEST(settings_functional, test_setting_zms_interrupted_delete)
+{
+	struct settings_zms_ll_node node;
+	struct zms_fs *fs;
+	uint32_t name_id;
+	uint8_t val = 0x5a;
+	int rc;
+
+	rc = settings_subsys_init();
+	zassert_equal(0, rc, "subsys init failed (err=%d)", rc);
+
+	rc = settings_storage_get((void **)&fs);
+	zassert_equal(0, rc, "Can't fetch storage reference (err=%d)", rc);
+
+	rc = settings_save_one(TEST_NAME, &val, sizeof(val));
+	zassert_equal(0, rc, "Can't save setting (err=%d)", rc);
+
+	/* The setting has no hash collision */
+	name_id = ZMS_SETTINGS_ID_BASE |
+		  (crc32_ieee((const uint8_t *)TEST_NAME, strlen(TEST_NAME)) & ZMS_HASH_MASK);
+
+	rc = zms_read(fs, name_id + ZMS_LL_NODE_ID_OFFSET, &node, sizeof(node));
+	zassert_equal(sizeof(node), rc, "Setting not listed (err=%d)", rc);
+
+	/* Stop a delete right after the name */
+	rc = zms_delete(fs, name_id);
+	zassert_equal(0, rc, "Can't delete name (err=%d)", rc);
+
+	loaded = 0;
+	rc = settings_load_subtree_direct("zms", count_cb, NULL);
+	zassert_equal(0, rc, "Can't load settings (err=%d)", rc);
+	zassert_equal(0, loaded, "Setting without name loaded");
+
+	rc = zms_read(fs, name_id + ZMS_LL_NODE_ID_OFFSET, &node, sizeof(node));
+	zassert_equal(-ENOENT, rc, "Setting without name still listed");
+	rc = zms_read(fs, name_id + ZMS_DATA_ID_OFFSET, &val, sizeof(val));
+	zassert_equal(-ENOENT, rc, "Value of setting without name not deleted");
+
+	rc = settings_save_one(TEST_NAME, &val, sizeof(val));
+	zassert_equal(0, rc, "Can't save setting (err=%d)", rc);
+
+	loaded = 0;
+	rc = settings_load_subtree_direct("zms", count_cb, NULL);
+	zassert_equal(0, rc, "Can't load settings (err=%d)", rc);
+	zassert_equal(1, loaded, "Setting not loaded");
+
+	rc = settings_delete(TEST_NAME);
+	zassert_equal(0, rc, "Can't delete setting (err=%d)", rc);
+
+	loaded = 0;
+	rc = settings_load_subtree_direct("zms", count_cb, NULL);
+	zassert_equal(0, rc, "Can't load settings (err=%d)", rc);
+	zassert_equal(0, loaded, "Deleted setting loaded");
+}
+
+ZTEST_SUITE(settings_functional, NULL, NULL, NULL, NULL, NULL);